@@ -0,0 +1,167 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	Affine2D.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the 2D affine transformations
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- Affine2DInverse
+// ---------------------------------------------------------------------------
+
+#include "Affine2D.h"
+
+// ---------------------------------------------------------------------------
+
+void Affine2DIdentity(Affine2D *pResult)
+{
+	pResult->m[0][0] = 1.f;
+	pResult->m[0][1] = 0.f;
+	pResult->m[0][2] = 0.f;
+	pResult->m[1][0] = 0.f;
+	pResult->m[1][1] = 1.f;
+	pResult->m[1][2] = 0.f;
+}
+
+// ---------------------------------------------------------------------------
+
+/*
+T * R * S is
+	| cos*sx  -sin*sy  x |
+	| sin*sx   cos*sy  y |
+*/
+void Affine2DBuildTRS(Affine2D *pResult, float x, float y, float Angle, float ScaleX, float ScaleY)
+{
+	if (Angle == 0.f)
+	{
+		pResult->m[0][0] = ScaleX;
+		pResult->m[0][1] = 0.f;
+		pResult->m[1][0] = 0.f;
+		pResult->m[1][1] = ScaleY;
+	}
+	else
+	{
+		float c = cosf(Angle);
+		float s = sinf(Angle);
+
+		pResult->m[0][0] = c * ScaleX;
+		pResult->m[0][1] = -s * ScaleY;
+		pResult->m[1][0] = s * ScaleX;
+		pResult->m[1][1] = c * ScaleY;
+	}
+
+	pResult->m[0][2] = x;
+	pResult->m[1][2] = y;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DBuildParentTRS(Affine2D *pResult, const Affine2D *pParent, float x, float y, float Angle, float ScaleX, float ScaleY)
+{
+	float p00 = pParent->m[0][0], p01 = pParent->m[0][1];
+	float p10 = pParent->m[1][0], p11 = pParent->m[1][1];
+	float tx = p00 * x + p01 * y + pParent->m[0][2];
+	float ty = p10 * x + p11 * y + pParent->m[1][2];
+
+	if (Angle == 0.f)
+	{
+		pResult->m[0][0] = p00 * ScaleX;
+		pResult->m[0][1] = p01 * ScaleY;
+		pResult->m[1][0] = p10 * ScaleX;
+		pResult->m[1][1] = p11 * ScaleY;
+	}
+	else
+	{
+		float c = cosf(Angle);
+		float s = sinf(Angle);
+
+		pResult->m[0][0] = (p00 * c + p01 * s) * ScaleX;
+		pResult->m[0][1] = (p01 * c - p00 * s) * ScaleY;
+		pResult->m[1][0] = (p10 * c + p11 * s) * ScaleX;
+		pResult->m[1][1] = (p11 * c - p10 * s) * ScaleY;
+	}
+
+	pResult->m[0][2] = tx;
+	pResult->m[1][2] = ty;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DConcat(Affine2D *pResult, const Affine2D *pAff0, const Affine2D *pAff1)
+{
+	Affine2D t;
+
+	t.m[0][0] = pAff0->m[0][0] * pAff1->m[0][0] + pAff0->m[0][1] * pAff1->m[1][0];
+	t.m[0][1] = pAff0->m[0][0] * pAff1->m[0][1] + pAff0->m[0][1] * pAff1->m[1][1];
+	t.m[0][2] = pAff0->m[0][0] * pAff1->m[0][2] + pAff0->m[0][1] * pAff1->m[1][2] + pAff0->m[0][2];
+	t.m[1][0] = pAff0->m[1][0] * pAff1->m[0][0] + pAff0->m[1][1] * pAff1->m[1][0];
+	t.m[1][1] = pAff0->m[1][0] * pAff1->m[0][1] + pAff0->m[1][1] * pAff1->m[1][1];
+	t.m[1][2] = pAff0->m[1][0] * pAff1->m[0][2] + pAff0->m[1][1] * pAff1->m[1][2] + pAff0->m[1][2];
+
+	*pResult = t;
+}
+
+// ---------------------------------------------------------------------------
+
+int Affine2DInverse(Affine2D *pResult, const Affine2D *pAff)
+{
+	float det = pAff->m[0][0] * pAff->m[1][1] - pAff->m[0][1] * pAff->m[1][0];
+	Affine2D t;
+
+	if (det == 0.f)
+		return 0;
+
+	det = 1.f / det;
+
+	// Inverse of the 2x2 part, then the translation moved back through it
+	t.m[0][0] = pAff->m[1][1] * det;
+	t.m[0][1] = -pAff->m[0][1] * det;
+	t.m[1][0] = -pAff->m[1][0] * det;
+	t.m[1][1] = pAff->m[0][0] * det;
+	t.m[0][2] = -(t.m[0][0] * pAff->m[0][2] + t.m[0][1] * pAff->m[1][2]);
+	t.m[1][2] = -(t.m[1][0] * pAff->m[0][2] + t.m[1][1] * pAff->m[1][2]);
+
+	*pResult = t;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DMultVec(Vector2D *pResult, const Affine2D *pAff, const Vector2D *pVec)
+{
+	float x = pVec->x;
+	float y = pVec->y;
+
+	pResult->x = pAff->m[0][0] * x + pAff->m[0][1] * y + pAff->m[0][2];
+	pResult->y = pAff->m[1][0] * x + pAff->m[1][1] * y + pAff->m[1][2];
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DToMatrix2D(Matrix2D *pResult, const Affine2D *pAff)
+{
+	pResult->m[0][0] = pAff->m[0][0];
+	pResult->m[0][1] = pAff->m[0][1];
+	pResult->m[0][2] = pAff->m[0][2];
+	pResult->m[1][0] = pAff->m[1][0];
+	pResult->m[1][1] = pAff->m[1][1];
+	pResult->m[1][2] = pAff->m[1][2];
+	pResult->m[2][0] = 0.f;
+	pResult->m[2][1] = 0.f;
+	pResult->m[2][2] = 1.f;
+}
+
+// ---------------------------------------------------------------------------
+
+void Affine2DFromMatrix2D(Affine2D *pResult, const Matrix2D *pMtx)
+{
+	pResult->m[0][0] = pMtx->m[0][0];
+	pResult->m[0][1] = pMtx->m[0][1];
+	pResult->m[0][2] = pMtx->m[0][2];
+	pResult->m[1][0] = pMtx->m[1][0];
+	pResult->m[1][1] = pMtx->m[1][1];
+	pResult->m[1][2] = pMtx->m[1][2];
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,83 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	Affine2D.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	2D affine transformations: the top 2 rows of a Matrix2D,
+//						built straight from a position, an angle and a scale
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- Affine2DInverse
+// ---------------------------------------------------------------------------
+
+#ifndef AFFINE2D_H
+#define AFFINE2D_H
+
+// ---------------------------------------------------------------------------
+
+#include "Matrix2D.h"
+
+// ---------------------------------------------------------------------------
+
+/*
+	| m[0][0]  m[0][1]  m[0][2] |
+	| m[1][0]  m[1][1]  m[1][2] |
+	|    0        0        1    |
+Same indices as Matrix2D, the last row is implicit
+*/
+typedef struct Affine2D
+{
+	float m[2][3];
+}Affine2D;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function sets Result to the identity transformation
+*/
+void Affine2DIdentity(Affine2D *pResult);
+
+/*
+This function builds Translate(x, y) * Rotate(Angle) * Scale(ScaleX, ScaleY) in
+Result. Angle is in radian; when it is 0 no sine or cosine is computed
+*/
+void Affine2DBuildTRS(Affine2D *pResult, float x, float y, float Angle, float ScaleX, float ScaleY);
+
+/*
+This function builds Parent * Translate(x, y) * Rotate(Angle) * Scale(ScaleX, ScaleY)
+in Result, without building the TRS transformation first
+*/
+void Affine2DBuildParentTRS(Affine2D *pResult, const Affine2D *pParent, float x, float y, float Angle, float ScaleX, float ScaleY);
+
+/*
+This function multiplies Aff0 with Aff1 and saves the result in Result
+Result = Aff0*Aff1
+*/
+void Affine2DConcat(Affine2D *pResult, const Affine2D *pAff0, const Affine2D *pAff1);
+
+/*
+This function saves the inverse of Aff in Result. Returns 0, and leaves Result
+alone, if Aff cannot be inverted
+*/
+int Affine2DInverse(Affine2D *pResult, const Affine2D *pAff);
+
+/*
+This function multiplies the transformation Aff with the point Vec and saves the result in Result
+Result = Aff * Vec
+*/
+void Affine2DMultVec(Vector2D *pResult, const Affine2D *pAff, const Vector2D *pVec);
+
+/*
+This function copies Aff into the 3x3 matrix Result, for the APIs that take one
+*/
+void Affine2DToMatrix2D(Matrix2D *pResult, const Affine2D *pAff);
+
+/*
+This function copies the top 2 rows of Mtx into Result. Mtx's last row must be 0 0 1
+*/
+void Affine2DFromMatrix2D(Affine2D *pResult, const Matrix2D *pMtx);
+
+// ---------------------------------------------------------------------------
+
+#endif // AFFINE2D_H
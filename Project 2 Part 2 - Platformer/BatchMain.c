@@ -0,0 +1,410 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	BatchMain.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Runs many levels headless at once, one World per thread
+//						of a ThreadPool, and prints what each level came to
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- the worlds are passed to the simulation, each run's
+//						  tick to its backend
+//	- 2026/10/17	:	- flags the levels that ran out of instance slots
+//	- 2026/10/17	:	- the -demo input is SimDemo's
+//	- 2026/10/17	:	- frees everything on the error returns too
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+// includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "PlatformerSim.h"
+#include "SimDemo.h"
+#include "Thread.h"
+#include "ThreadPool.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+// Bits of a tick of the recorded input
+#define INPUT_LEFT		0x01
+#define INPUT_RIGHT		0x02
+#define INPUT_JUMP		0x04
+
+// ---------------------------------------------------------------------------
+
+// One run of a level
+typedef struct
+{
+	const char		*mpFileName;
+	int				mLoaded;			// 0 if the level could not be loaded, or has no hero
+	SimStats		mStats;
+	float			mHeroX;				// Where the hero ended
+	float			mHeroY;
+	double			mSeconds;			// Time spent in the updates
+}BatchRun;
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void		RunLevel(void *pContext, unsigned int Job, unsigned int Worker);
+static void		FreeBatch(const char **ppLevels);
+static int		LoadInputRecord(const char *pFileName);
+static int		IsSameRun(const BatchRun *pRun0, const BatchRun *pRun1);
+static unsigned char GetInputBit(unsigned int Input);
+static unsigned char GetRecordedInput(unsigned long Tick);
+static double	BatchGetFrameTime(void *pContext);
+static int		RecordCheckInputCurr(void *pContext, unsigned int Input);
+static int		RecordCheckInputTriggered(void *pContext, unsigned int Input);
+
+// ---------------------------------------------------------------------------
+// globals
+
+static double	sgFrameTime = 1.0 / 60.0;
+static unsigned long sgTickNum = 600;
+
+// The backends' context is the current tick of the run (see RunLevel)
+
+// Runs right, then left, then right again, jumping every now and then (see SimDemo.h)
+static const SimBackend sgDemoBackend =
+{
+	BatchGetFrameTime,
+	SimDemoCheckInputCurr,
+	SimDemoCheckInputTriggered,
+	0
+};
+
+// Plays sgpInputRecord back, no input past its end
+static const SimBackend sgRecordBackend =
+{
+	BatchGetFrameTime,
+	RecordCheckInputCurr,
+	RecordCheckInputTriggered,
+	0
+};
+
+static const SimBackend	*sgpBackend = &sgRecordBackend;
+
+// INPUT_* bits of each tick, shared by every run
+static unsigned char	*sgpInputRecord;
+static unsigned long	sgInputRecordNum;
+
+// Runs of level l are sgpRuns[l * sgRepeatNum] to sgpRuns[(l + 1) * sgRepeatNum - 1]
+static BatchRun			*sgpRuns;
+static unsigned long	sgRepeatNum = 1;
+
+// One world per worker, reused from run to run
+static World			*sgpWorlds[THREAD_POOL_THREAD_NUM_MAX];
+
+// ---------------------------------------------------------------------------
+// main
+
+int main(int argc, char **argv)
+{
+	const char **ppLevels;
+	unsigned long levelNum = 0;
+	unsigned long runNum, run, level;
+	unsigned int threadNum = ThreadGetProcessorNum();
+	unsigned int t;
+	double start, seconds, tickNum = 0.0;
+	ThreadPool pool;
+	int usage = 0;
+	int i;
+
+	ppLevels = malloc(argc * sizeof(const char *));
+	if (!ppLevels)
+		return 1;
+
+	for (i = 1; i < argc; ++i)
+	{
+		if (0 == strcmp(argv[i], "-ticks") && i + 1 < argc)
+			sgTickNum = strtoul(argv[++i], 0, 10);
+		else if (0 == strcmp(argv[i], "-hz") && i + 1 < argc)
+			sgFrameTime = 1.0 / strtod(argv[++i], 0);
+		else if (0 == strcmp(argv[i], "-threads") && i + 1 < argc)
+			threadNum = (unsigned int)strtoul(argv[++i], 0, 10);
+		else if (0 == strcmp(argv[i], "-repeat") && i + 1 < argc)
+			sgRepeatNum = strtoul(argv[++i], 0, 10);
+		else if (0 == strcmp(argv[i], "-demo"))
+			sgpBackend = &sgDemoBackend;
+		else if (0 == strcmp(argv[i], "-input") && i + 1 < argc)
+		{
+			if (!LoadInputRecord(argv[++i]))
+			{
+				printf("could not read %s\n", argv[i]);
+				FreeBatch(ppLevels);
+				return 1;
+			}
+		}
+		else if (argv[i][0] != '-')
+			ppLevels[levelNum++] = argv[i];
+		else
+			usage = 1;
+	}
+
+	if (usage || 0 == levelNum || 0 == sgRepeatNum || 0 == threadNum)
+	{
+		printf("usage: %s [-ticks n] [-hz rate] [-threads n] [-repeat n] [-demo | -input file] level...\n", argv[0]);
+		printf("  -input: one line per tick, with an L, R and/or J for the inputs held\n");
+		FreeBatch(ppLevels);
+		return 1;
+	}
+
+	// Each level is run sgRepeatNum times
+	runNum = levelNum * sgRepeatNum;
+	sgpRuns = calloc(runNum, sizeof(BatchRun));
+	if (!sgpRuns)
+	{
+		FreeBatch(ppLevels);
+		return 1;
+	}
+
+	for (run = 0; run < runNum; ++run)
+		sgpRuns[run].mpFileName = ppLevels[run / sgRepeatNum];
+
+	if (threadNum > THREAD_POOL_THREAD_NUM_MAX)
+		threadNum = THREAD_POOL_THREAD_NUM_MAX;
+	if (threadNum > runNum)
+		threadNum = (unsigned int)runNum;
+
+	for (t = 0; t < threadNum; ++t)
+	{
+		sgpWorlds[t] = WorldCreate();
+		if (!sgpWorlds[t])
+		{
+			printf("could not allocate the worlds\n");
+			FreeBatch(ppLevels);
+			return 1;
+		}
+	}
+
+	if (!ThreadPoolInit(&pool, threadNum))
+	{
+		printf("could not start the threads\n");
+		FreeBatch(ppLevels);
+		return 1;
+	}
+
+	start = ThreadGetTime();
+	ThreadPoolRun(&pool, RunLevel, 0, (unsigned int)runNum);
+	seconds = ThreadGetTime() - start;
+
+	ThreadPoolFree(&pool);
+
+	// One line per level. Runs of the same level must all end the same way
+	printf("%-32s %6s %6s %6s %8s %12s\n", "level", "runs", "coins", "left", "deaths", "ticks/s");
+
+	for (level = 0; level < levelNum; ++level)
+	{
+		const BatchRun *pRuns = sgpRuns + level * sgRepeatNum;
+		double levelSeconds = 0.0;
+		int same = 1;
+
+		if (!pRuns[0].mLoaded)
+		{
+			printf("%-32s could not be loaded, or has no hero\n", pRuns[0].mpFileName);
+			continue;
+		}
+
+		for (run = 0; run < sgRepeatNum; ++run)
+		{
+			levelSeconds += pRuns[run].mSeconds;
+			same = same && IsSameRun(pRuns, pRuns + run);
+		}
+
+		tickNum += (double)sgTickNum * sgRepeatNum;
+
+		printf("%-32s %6lu %6d %6d %8d %12.0f%s%s\n", pRuns[0].mpFileName, sgRepeatNum, pRuns[0].mStats.mCoinNum, pRuns[0].mStats.mCoinsLeft, pRuns[0].mStats.mDeathNum,
+			levelSeconds > 0.0 ? (double)sgTickNum * sgRepeatNum / levelSeconds : 0.0, same ? "" : "  (runs differ)",
+			pRuns[0].mStats.mSpawnFailNum ? "  (out of instance slots)" : "");
+	}
+
+	printf("%lu world(s) of %lu ticks on %u thread(s) in %.3f s", runNum, sgTickNum, threadNum, seconds);
+	if (seconds > 0.0)
+		printf(" (%.0f ticks/s)", tickNum / seconds);
+	printf("\n");
+
+	FreeBatch(ppLevels);
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// The worlds, the runs and the input record, whichever were made
+void FreeBatch(const char **ppLevels)
+{
+	unsigned int t;
+
+	for (t = 0; t < THREAD_POOL_THREAD_NUM_MAX; ++t)
+	{
+		WorldDestroy(sgpWorlds[t]);
+		sgpWorlds[t] = 0;
+	}
+
+	free(sgpRuns);
+	sgpRuns = 0;
+	free(ppLevels);
+	free(sgpInputRecord);
+	sgpInputRecord = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// Loads and runs sgpRuns[Job] in the worker's world
+void RunLevel(void *pContext, unsigned int Job, unsigned int Worker)
+{
+	BatchRun *pRun = sgpRuns + Job;
+	World *pWorld = sgpWorlds[Worker];
+	SimBackend backend = *sgpBackend;
+	GameObjectInstance *pHero;
+	unsigned long tick;
+	double start;
+
+	backend.mpContext = &tick;
+	SimSetBackend(pWorld, &backend);
+
+	if (!SimLoad(pWorld, (char *)pRun->mpFileName))
+		return;
+
+	SimInit(pWorld);
+
+	pHero = SimGetHero(pWorld);
+	if (pHero)
+	{
+		start = ThreadGetTime();
+		for (tick = 0; tick < sgTickNum; ++tick)
+			SimUpdate(pWorld);
+		pRun->mSeconds = ThreadGetTime() - start;
+
+		pHero = SimGetHero(pWorld);
+		pRun->mHeroX = pHero->mpComponent_Transform->mPosition.x;
+		pRun->mHeroY = pHero->mpComponent_Transform->mPosition.y;
+		SimGetStats(pWorld, &pRun->mStats);
+		pRun->mLoaded = 1;
+	}
+
+	SimFree(pWorld);
+	SimUnload(pWorld);
+}
+
+// ---------------------------------------------------------------------------
+
+// Returns 0 if the file could not be read
+int LoadInputRecord(const char *pFileName)
+{
+	FILE *pFile = fopen(pFileName, "r");
+	unsigned long capacity = 0;
+	unsigned char input = 0;
+	int lineStarted = 0;
+	int c;
+
+	if (!pFile)
+		return 0;
+
+	free(sgpInputRecord);
+	sgpInputRecord = 0;
+	sgInputRecordNum = 0;
+
+	// The last line does not need to end with a new line
+	do
+	{
+		c = fgetc(pFile);
+
+		if (c == 'L' || c == 'l')
+			input |= INPUT_LEFT;
+		else if (c == 'R' || c == 'r')
+			input |= INPUT_RIGHT;
+		else if (c == 'J' || c == 'j')
+			input |= INPUT_JUMP;
+
+		if (c == '\n' || (c == EOF && lineStarted))
+		{
+			if (sgInputRecordNum == capacity)
+			{
+				unsigned char *pGrown;
+
+				capacity = capacity ? capacity * 2 : 1024;
+				pGrown = realloc(sgpInputRecord, capacity);
+				if (!pGrown)
+				{
+					fclose(pFile);
+					return 0;
+				}
+				sgpInputRecord = pGrown;
+			}
+
+			sgpInputRecord[sgInputRecordNum++] = input;
+			input = 0;
+			lineStarted = 0;
+		}
+		else
+			lineStarted = 1;
+	} while (c != EOF);
+
+	fclose(pFile);
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+int IsSameRun(const BatchRun *pRun0, const BatchRun *pRun1)
+{
+	return pRun0->mLoaded == pRun1->mLoaded && pRun0->mHeroX == pRun1->mHeroX && pRun0->mHeroY == pRun1->mHeroY &&
+		0 == memcmp(&pRun0->mStats, &pRun1->mStats, sizeof(SimStats));
+}
+
+// ---------------------------------------------------------------------------
+
+double BatchGetFrameTime(void *pContext)
+{
+	return sgFrameTime;
+}
+
+// ---------------------------------------------------------------------------
+
+int RecordCheckInputCurr(void *pContext, unsigned int Input)
+{
+	return 0 != (GetRecordedInput(*(const unsigned long *)pContext) & GetInputBit(Input));
+}
+
+// ---------------------------------------------------------------------------
+
+// Held on this tick, and not on the one before
+int RecordCheckInputTriggered(void *pContext, unsigned int Input)
+{
+	unsigned long tick = *(const unsigned long *)pContext;
+	unsigned char bit = GetInputBit(Input);
+
+	if (0 == (GetRecordedInput(tick) & bit))
+		return 0;
+
+	return 0 == tick || 0 == (GetRecordedInput(tick - 1) & bit);
+}
+
+// ---------------------------------------------------------------------------
+
+// The INPUT_* bit of a SIM_INPUT
+unsigned char GetInputBit(unsigned int Input)
+{
+	if (Input == SIM_INPUT_LEFT)
+		return INPUT_LEFT;
+	if (Input == SIM_INPUT_RIGHT)
+		return INPUT_RIGHT;
+	if (Input == SIM_INPUT_JUMP)
+		return INPUT_JUMP;
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// The INPUT_* bits of "Tick", none past the end of the record
+unsigned char GetRecordedInput(unsigned long Tick)
+{
+	return Tick < sgInputRecordNum ? sgpInputRecord[Tick] : 0;
+}
+
+// ---------------------------------------------------------------------------
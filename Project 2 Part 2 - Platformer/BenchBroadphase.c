@@ -0,0 +1,229 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	BenchBroadphase.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Microbenchmark of entity vs entity collision: testing
+//						every pair against the broadphase, from 100 to 50k movers
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+// includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "Broadphase.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define BENCH_CELLS_PER_MOVER	16.0f		// The world grows with the number of movers, the density stays the same
+#define BENCH_GRID_CELL_SIZE	4.0f		// Like the simulation's instance grid
+#define BENCH_HALF_SIZE			0.5f		// 1x1 boxes, like the instances
+#define BENCH_FRAME_TIME		(1.0f / 60.0f)
+#define BENCH_TESTS_PER_RUN		400000000.0	// Box tests of the brute force per measurement
+
+// Two types: projectiles hit enemies, enemies hit each other. Projectiles do not hit each other
+#define BENCH_TYPE_PROJECTILE	0
+#define BENCH_TYPE_ENEMY		1
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void		SetupMovers(unsigned int Num, float WorldSize);
+static void		MoveMovers(unsigned int Num, float WorldSize);
+static double	BenchBruteForce(unsigned int Num, float WorldSize, unsigned int Ticks);
+static double	BenchBroadphase(unsigned int Num, float WorldSize, unsigned int Ticks);
+static void		CountPair(void *pContext, unsigned int ItemA, unsigned int ItemB);
+
+// ---------------------------------------------------------------------------
+// globals
+
+static float			*sgpX, *sgpY, *sgpVelX, *sgpVelY;
+static unsigned char	*sgpTypes;
+static unsigned long	sgPairNum;		// Pairs found during the last measurement, to compare the two
+
+// ---------------------------------------------------------------------------
+// main
+
+int main(int argc, char **argv)
+{
+	static const unsigned int nums[] = { 100, 1000, 5000, 10000, 50000 };
+	unsigned int i;
+
+	printf("%-8s %-6s %-16s %-16s %-8s %s\n", "movers", "ticks", "brute ms/tick", "grid ms/tick", "speedup", "pairs/tick");
+
+	for (i = 0; i < sizeof(nums) / sizeof(nums[0]); ++i)
+	{
+		unsigned int num = nums[i];
+		float worldSize = sqrtf(num * BENCH_CELLS_PER_MOVER);
+		// Testing every pair is O(n^2), keep the run short on large counts
+		double ticks = BENCH_TESTS_PER_RUN / ((double)num * num / 2.0);
+		unsigned int tickNum = ticks < 1.0 ? 1 : ticks > 2000.0 ? 2000 : (unsigned int)ticks;
+		unsigned long brutePairs, gridPairs;
+		double brute, grid;
+
+		sgpX = malloc(num * sizeof(float));
+		sgpY = malloc(num * sizeof(float));
+		sgpVelX = malloc(num * sizeof(float));
+		sgpVelY = malloc(num * sizeof(float));
+		sgpTypes = malloc(num);
+
+		SetupMovers(num, worldSize);
+		brute = BenchBruteForce(num, worldSize, tickNum);
+		brutePairs = sgPairNum;
+
+		// Same starting positions and velocities
+		SetupMovers(num, worldSize);
+		grid = BenchBroadphase(num, worldSize, tickNum);
+		gridPairs = sgPairNum;
+
+		printf("%-8u %-6u %-16.4f %-16.4f %-8.1f %.1f%s\n", num, tickNum, brute, grid, grid > 0.0 ? brute / grid : 0.0,
+			(double)gridPairs / tickNum, brutePairs == gridPairs ? "" : " (MISMATCH)");
+
+		free(sgpX);
+		free(sgpY);
+		free(sgpVelX);
+		free(sgpVelY);
+		free(sgpTypes);
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// Random positions in the world, random velocities up to 8 cells per second. A quarter are enemies
+void SetupMovers(unsigned int Num, float WorldSize)
+{
+	unsigned int i;
+
+	srand(1);
+
+	for (i = 0; i < Num; ++i)
+	{
+		sgpX[i] = WorldSize * rand() / RAND_MAX;
+		sgpY[i] = WorldSize * rand() / RAND_MAX;
+		sgpVelX[i] = 16.f * rand() / RAND_MAX - 8.f;
+		sgpVelY[i] = 16.f * rand() / RAND_MAX - 8.f;
+		sgpTypes[i] = (unsigned char)(0 == i % 4 ? BENCH_TYPE_ENEMY : BENCH_TYPE_PROJECTILE);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+// One step, bouncing on the world's borders
+void MoveMovers(unsigned int Num, float WorldSize)
+{
+	unsigned int i;
+
+	for (i = 0; i < Num; ++i)
+	{
+		sgpX[i] += sgpVelX[i] * BENCH_FRAME_TIME;
+		sgpY[i] += sgpVelY[i] * BENCH_FRAME_TIME;
+
+		if ((sgpX[i] < 0.f && sgpVelX[i] < 0.f) || (sgpX[i] > WorldSize && sgpVelX[i] > 0.f))
+			sgpVelX[i] = -sgpVelX[i];
+		if ((sgpY[i] < 0.f && sgpVelY[i] < 0.f) || (sgpY[i] > WorldSize && sgpVelY[i] > 0.f))
+			sgpVelY[i] = -sgpVelY[i];
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+// Tests every pair, like the hero against every coin and enemy. Returns milliseconds per tick
+double BenchBruteForce(unsigned int Num, float WorldSize, unsigned int Ticks)
+{
+	unsigned int tick, i, j;
+	clock_t start;
+
+	sgPairNum = 0;
+	start = clock();
+
+	for (tick = 0; tick < Ticks; ++tick)
+	{
+		MoveMovers(Num, WorldSize);
+
+		for (i = 0; i < Num; ++i)
+		{
+			for (j = i + 1; j < Num; ++j)
+			{
+				float dx, dy;
+
+				if (sgpTypes[i] == BENCH_TYPE_PROJECTILE && sgpTypes[j] == BENCH_TYPE_PROJECTILE)
+					continue;
+
+				dx = sgpX[j] - sgpX[i];
+				dy = sgpY[j] - sgpY[i];
+
+				if (dx < 0.f)
+					dx = -dx;
+				if (dy < 0.f)
+					dy = -dy;
+
+				if (dx <= 2.f * BENCH_HALF_SIZE && dy <= 2.f * BENCH_HALF_SIZE)
+					CountPair(0, i, j);
+			}
+		}
+	}
+
+	return (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC / Ticks;
+}
+
+// ---------------------------------------------------------------------------
+
+// Moves the items in the broadphase each tick, then finds the pairs. Returns milliseconds per tick
+double BenchBroadphase(unsigned int Num, float WorldSize, unsigned int Ticks)
+{
+	Broadphase broadphase;
+	unsigned int tick, i;
+	clock_t start;
+	double ms;
+
+	if (!BroadphaseInit(&broadphase, 0.f, 0.f, WorldSize, WorldSize, BENCH_GRID_CELL_SIZE, Num, Num * 4))
+	{
+		printf("could not allocate the broadphase\n");
+		exit(1);
+	}
+
+	BroadphaseSetCallback(&broadphase, BENCH_TYPE_PROJECTILE, BENCH_TYPE_ENEMY, CountPair);
+	BroadphaseSetCallback(&broadphase, BENCH_TYPE_ENEMY, BENCH_TYPE_ENEMY, CountPair);
+
+	for (i = 0; i < Num; ++i)
+		BroadphaseSetBox(&broadphase, i, sgpTypes[i], BENCH_HALF_SIZE, BENCH_HALF_SIZE);
+
+	sgPairNum = 0;
+	start = clock();
+
+	for (tick = 0; tick < Ticks; ++tick)
+	{
+		MoveMovers(Num, WorldSize);
+
+		for (i = 0; i < Num; ++i)
+			BroadphaseMove(&broadphase, i, sgpX[i], sgpY[i]);
+
+		BroadphaseUpdate(&broadphase, 0);
+
+		if (broadphase.mDroppedNum)
+			printf("%u pairs dropped\n", broadphase.mDroppedNum);
+	}
+
+	ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC / Ticks;
+	BroadphaseFree(&broadphase);
+
+	return ms;
+}
+
+// ---------------------------------------------------------------------------
+
+void CountPair(void *pContext, unsigned int ItemA, unsigned int ItemB)
+{
+	++sgPairNum;
+}
+
+// ---------------------------------------------------------------------------
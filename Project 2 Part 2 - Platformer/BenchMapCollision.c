@@ -0,0 +1,159 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	BenchMapCollision.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Microbenchmark of the hot spot map collision: one
+//						CheckInstanceBinaryMapCollision call per instance against
+//						CheckInstancesBinaryMapCollision over all of them
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- the map is a MapContext passed to BinaryMap
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+// includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "BinaryMap.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define BENCH_ITEMS_PER_RUN		50000000	// Queries per measurement
+#define BENCH_OUTSIDE			3.0f		// Instances are placed up to this far past the map, to go through the clamps
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static double	BenchOne(unsigned int Num, int *pFlags);
+static double	BenchBatch(unsigned int Num, int *pFlags);
+
+// ---------------------------------------------------------------------------
+// globals
+
+static MapContext		*sgpMap;
+static float			*sgpX, *sgpY, *sgpScaleX, *sgpScaleY;
+static volatile int		sgSink;		// Keeps the compiler from dropping the loops
+
+// ---------------------------------------------------------------------------
+// main
+
+int main(int argc, char **argv)
+{
+	static const unsigned int nums[] = { 1024, 16384, 262144 };
+	char *pMapFile = "Exported.txt";
+	unsigned int i, n;
+
+	if (argc == 3 && 0 == strcmp(argv[1], "-map"))
+		pMapFile = argv[2];
+	else if (argc != 1)
+	{
+		printf("usage: %s [-map file]\n", argv[0]);
+		return 1;
+	}
+
+	sgpMap = MapContextCreate();
+	if (!sgpMap)
+		return 1;
+
+	if (!ImportMapDataFromFile(sgpMap, pMapFile))
+	{
+		printf("could not load %s\n", pMapFile);
+		return 1;
+	}
+
+	printf("%s: %i x %i cells\n", pMapFile, GetMapWidth(sgpMap), GetMapHeight(sgpMap));
+	printf("%-8s %-14s %-14s %-8s %s\n", "items", "one Mitem/s", "batch Mitem/s", "speedup", "flags");
+
+	for (n = 0; n < sizeof(nums) / sizeof(nums[0]); ++n)
+	{
+		unsigned int num = nums[n];
+		int *pOneFlags = malloc(num * sizeof(int));
+		int *pBatchFlags = malloc(num * sizeof(int));
+		unsigned int mismatches = 0;
+		double one, batch;
+
+		sgpX = malloc(num * sizeof(float));
+		sgpY = malloc(num * sizeof(float));
+		sgpScaleX = malloc(num * sizeof(float));
+		sgpScaleY = malloc(num * sizeof(float));
+
+		// Anywhere on the map and a bit past it, mostly 1x1 like the instances
+		srand(1);
+		for (i = 0; i < num; ++i)
+		{
+			sgpX[i] = (GetMapWidth(sgpMap) + 2.f * BENCH_OUTSIDE) * rand() / RAND_MAX - BENCH_OUTSIDE;
+			sgpY[i] = (GetMapHeight(sgpMap) + 2.f * BENCH_OUTSIDE) * rand() / RAND_MAX - BENCH_OUTSIDE;
+			sgpScaleX[i] = rand() % 4 ? 1.f : 0.5f + 2.f * rand() / RAND_MAX;
+			sgpScaleY[i] = rand() % 4 ? 1.f : 0.5f + 2.f * rand() / RAND_MAX;
+		}
+
+		one = BenchOne(num, pOneFlags);
+		batch = BenchBatch(num, pBatchFlags);
+
+		for (i = 0; i < num; ++i)
+			mismatches += pOneFlags[i] != pBatchFlags[i];
+
+		if (mismatches)
+			printf("%-8u %-14.1f %-14.1f %-8.1f %u MISMATCHES\n", num, one, batch, batch / one, mismatches);
+		else
+			printf("%-8u %-14.1f %-14.1f %-8.1f same\n", num, one, batch, batch / one);
+
+		free(pOneFlags);
+		free(pBatchFlags);
+		free(sgpX);
+		free(sgpY);
+		free(sgpScaleX);
+		free(sgpScaleY);
+	}
+
+	MapContextDestroy(sgpMap);
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// Returns millions of queries per second
+double BenchOne(unsigned int Num, int *pFlags)
+{
+	unsigned int runs = BENCH_ITEMS_PER_RUN / Num, run, i;
+	clock_t start = clock();
+	double seconds;
+
+	for (run = 0; run < runs; ++run)
+	{
+		for (i = 0; i < Num; ++i)
+			pFlags[i] = CheckInstanceBinaryMapCollision(sgpMap, sgpX[i], sgpY[i], sgpScaleX[i], sgpScaleY[i]);
+		sgSink += pFlags[run % Num];
+	}
+
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	return seconds > 0.0 ? (double)runs * Num / seconds / 1e6 : 0.0;
+}
+
+// ---------------------------------------------------------------------------
+
+double BenchBatch(unsigned int Num, int *pFlags)
+{
+	unsigned int runs = BENCH_ITEMS_PER_RUN / Num, run;
+	clock_t start = clock();
+	double seconds;
+
+	for (run = 0; run < runs; ++run)
+	{
+		CheckInstancesBinaryMapCollision(sgpMap, sgpX, sgpY, sgpScaleX, sgpScaleY, pFlags, Num);
+		sgSink += pFlags[run % Num];
+	}
+
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	return seconds > 0.0 ? (double)runs * Num / seconds / 1e6 : 0.0;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,171 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	BenchMapLoad.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Load time benchmark of the text map format against the
+//						memory mapped binary one
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- the map is a MapContext passed to BinaryMap
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+// includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "BinaryMap.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define BENCH_TEXT_FILE			"bench_map.txt"
+#define BENCH_BINARY_FILE		"bench_map.pmap"
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static int		WriteTextMap(const char *pFileName, int Width, int Height);
+static double	BenchLoad(char *pFileName, int Runs, int ReadAll);
+static int		CountSpawns(void *pContext, int ChunkX, int ChunkY);
+
+// ---------------------------------------------------------------------------
+// globals
+
+static MapContext		*sgpMap;
+static volatile long sgSink;		// Keeps the compiler from dropping the reads
+
+// ---------------------------------------------------------------------------
+// main
+
+int main(int argc, char **argv)
+{
+	int width = 2000, height = 2000, runs = 5;
+	int i;
+
+	for (i = 1; i < argc; ++i)
+	{
+		if (0 == strcmp(argv[i], "-size") && i + 2 < argc)
+		{
+			width = atoi(argv[++i]);
+			height = atoi(argv[++i]);
+		}
+		else if (0 == strcmp(argv[i], "-runs") && i + 1 < argc)
+			runs = atoi(argv[++i]);
+		else
+		{
+			printf("usage: %s [-size width height] [-runs n]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (width <= 0 || height <= 0 || runs <= 0 || !WriteTextMap(BENCH_TEXT_FILE, width, height))
+	{
+		printf("could not write %s\n", BENCH_TEXT_FILE);
+		return 1;
+	}
+
+	sgpMap = MapContextCreate();
+	if (!sgpMap)
+		return 1;
+
+	if (!ImportMapDataFromFile(sgpMap, BENCH_TEXT_FILE) || !ExportMapDataToBinaryFile(sgpMap, BENCH_BINARY_FILE, 4))
+	{
+		printf("could not write %s\n", BENCH_BINARY_FILE);
+		return 1;
+	}
+	FreeMapData(sgpMap);
+
+	// "start": import and spawn around the hero, like SimLoad + SimInit
+	// "all cells": import and read every cell once
+	printf("%i x %i cells, %i run(s), ms per load\n", width, height, runs);
+	printf("%-8s %-10s %s\n", "format", "start", "all cells");
+	printf("%-8s %-10.2f %.2f\n", "text", BenchLoad(BENCH_TEXT_FILE, runs, 0), BenchLoad(BENCH_TEXT_FILE, runs, 1));
+	printf("%-8s %-10.2f %.2f\n", "binary", BenchLoad(BENCH_BINARY_FILE, runs, 0), BenchLoad(BENCH_BINARY_FILE, runs, 1));
+
+	remove(BENCH_TEXT_FILE);
+	remove(BENCH_BINARY_FILE);
+	MapContextDestroy(sgpMap);
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// A walled level with some platforms, enemies and coins, and the hero near the bottom left
+int WriteTextMap(const char *pFileName, int Width, int Height)
+{
+	FILE *pFile = fopen(pFileName, "w");
+	int x, y;
+
+	if (!pFile)
+		return 0;
+
+	srand(1);
+	fprintf(pFile, "Width %i\nHeight %i\n", Width, Height);
+
+	for (y = Height - 1; y >= 0; --y)
+	{
+		for (x = 0; x < Width; ++x)
+		{
+			int value = 0;
+
+			if (x == 0 || y == 0 || x == Width - 1 || y == Height - 1 || (y % 6 == 0 && rand() % 4))
+				value = TYPE_OBJECT_COLLISION;
+			else if (x == 2 && y == 1)
+				value = TYPE_OBJECT_HERO;
+			else if (rand() % 64 == 0)
+				value = rand() % 2 ? TYPE_OBJECT_ENEMY1 : TYPE_OBJECT_COIN;
+
+			fprintf(pFile, "%i ", value);
+		}
+		fprintf(pFile, "\n");
+	}
+
+	return 0 == fclose(pFile);
+}
+
+// ---------------------------------------------------------------------------
+
+double BenchLoad(char *pFileName, int Runs, int ReadAll)
+{
+	clock_t start = clock();
+	int run, x, y;
+
+	for (run = 0; run < Runs; ++run)
+	{
+		if (!ImportMapDataFromFile(sgpMap, pFileName))
+			return -1.0;
+
+		if (ReadAll)
+		{
+			for (x = 0; x < GetMapWidth(sgpMap); ++x)
+				for (y = 0; y < GetMapHeight(sgpMap); ++y)
+					sgSink += GetMapDataValue(sgpMap, x, y);
+		}
+		else
+		{
+			GetMapHeroStart(sgpMap, &x, &y);
+			MapStreamReset(sgpMap);
+			MapStreamFocus(sgpMap, x + 0.5f, y + 0.5f, CountSpawns, 0, 0);
+		}
+
+		FreeMapData(sgpMap);
+	}
+
+	return 1000.0 * (double)(clock() - start) / CLOCKS_PER_SEC / Runs;
+}
+
+// ---------------------------------------------------------------------------
+
+int CountSpawns(void *pContext, int ChunkX, int ChunkY)
+{
+	sgSink += ChunkX + ChunkY;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
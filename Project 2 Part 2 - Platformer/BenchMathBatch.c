@@ -0,0 +1,227 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	BenchMathBatch.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Throughput of the batch math kernels against the one at
+//						a time Vector2D and Matrix2D functions
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+// includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "MathBatch.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define BENCH_ITEMS_PER_RUN		(1 << 25)		// Items processed per measurement, whatever the batch size
+
+// ---------------------------------------------------------------------------
+// Types
+
+typedef struct
+{
+	unsigned int	mNum;
+	Vector2D		*mpPos;			// One at a time layout
+	Vector2D		*mpVel;
+	Matrix2D		*mpMtx;
+	float			*mpPosX;		// Batch layout
+	float			*mpPosY;
+	float			*mpVelX;
+	float			*mpVelY;
+	float			*mpAngle;
+	float			*mpScaleX;
+	float			*mpScaleY;
+}BenchData;
+
+typedef void (*BenchFn)(BenchData *pData);
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static double	Measure(BenchFn Fn, BenchData *pData);
+
+static void		IntegrateOne(BenchData *pData);
+static void		IntegrateBatch(BenchData *pData);
+static void		TransformOne(BenchData *pData);
+static void		TransformBatch(BenchData *pData);
+static void		TRSOne(BenchData *pData);
+static void		TRSBatch(BenchData *pData);
+
+// ---------------------------------------------------------------------------
+// globals
+
+static Matrix2D sgMapMtx;
+static volatile float sgSink;		// Keeps the compiler from dropping the loops
+
+// ---------------------------------------------------------------------------
+// main
+
+int main(int argc, char **argv)
+{
+	static const unsigned int sizes[] = { 1024, 16384, 262144 };
+	static const struct { const char *mpName; BenchFn mOne, mBatch; } ops[] =
+	{
+		{ "integrate", IntegrateOne, IntegrateBatch },
+		{ "transform", TransformOne, TransformBatch },
+		{ "trs", TRSOne, TRSBatch }
+	};
+	unsigned int s, o, i;
+
+	Matrix2DScale(&sgMapMtx, 30.0f, 30.0f);
+	sgMapMtx.m[0][2] = -600.0f;
+	sgMapMtx.m[1][2] = -300.0f;
+
+	printf("kernels: %s\n", MathBatchGetKernelName());
+	printf("%-10s %-8s %-14s %-14s %s\n", "op", "items", "one Mitem/s", "batch Mitem/s", "speedup");
+
+	for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+	{
+		BenchData data;
+
+		data.mNum = sizes[s];
+		data.mpPos = malloc(data.mNum * sizeof(Vector2D));
+		data.mpVel = malloc(data.mNum * sizeof(Vector2D));
+		data.mpMtx = malloc(data.mNum * sizeof(Matrix2D));
+		data.mpPosX = malloc(data.mNum * sizeof(float));
+		data.mpPosY = malloc(data.mNum * sizeof(float));
+		data.mpVelX = malloc(data.mNum * sizeof(float));
+		data.mpVelY = malloc(data.mNum * sizeof(float));
+		data.mpAngle = malloc(data.mNum * sizeof(float));
+		data.mpScaleX = malloc(data.mNum * sizeof(float));
+		data.mpScaleY = malloc(data.mNum * sizeof(float));
+
+		for (i = 0; i < data.mNum; ++i)
+		{
+			data.mpPosX[i] = data.mpPos[i].x = (float)(rand() % 4000) / 10.0f;
+			data.mpPosY[i] = data.mpPos[i].y = (float)(rand() % 240) / 10.0f;
+			data.mpVelX[i] = data.mpVel[i].x = (float)(rand() % 200) / 100.0f - 1.0f;
+			data.mpVelY[i] = data.mpVel[i].y = (float)(rand() % 200) / 100.0f - 1.0f;
+			data.mpAngle[i] = (float)(rand() % 628) / 100.0f;
+			data.mpScaleX[i] = data.mpScaleY[i] = 1.0f;
+		}
+
+		for (o = 0; o < sizeof(ops) / sizeof(ops[0]); ++o)
+		{
+			double one = Measure(ops[o].mOne, &data);
+			double batch = Measure(ops[o].mBatch, &data);
+
+			printf("%-10s %-8u %-14.1f %-14.1f %.1fx\n", ops[o].mpName, data.mNum, one, batch, batch / one);
+		}
+
+		free(data.mpPos);
+		free(data.mpVel);
+		free(data.mpMtx);
+		free(data.mpPosX);
+		free(data.mpPosY);
+		free(data.mpVelX);
+		free(data.mpVelY);
+		free(data.mpAngle);
+		free(data.mpScaleX);
+		free(data.mpScaleY);
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// Returns millions of items per second
+double Measure(BenchFn Fn, BenchData *pData)
+{
+	unsigned int runs = BENCH_ITEMS_PER_RUN / pData->mNum;
+	unsigned int r;
+	clock_t start;
+	double seconds;
+
+	Fn(pData);
+
+	start = clock();
+	for (r = 0; r < runs; ++r)
+		Fn(pData);
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	return seconds > 0.0 ? (double)runs * pData->mNum / seconds / 1e6 : 0.0;
+}
+
+// ---------------------------------------------------------------------------
+
+void IntegrateOne(BenchData *pData)
+{
+	unsigned int i;
+
+	for (i = 0; i < pData->mNum; ++i)
+		Vector2DScaleAdd(pData->mpPos + i, pData->mpVel + i, pData->mpPos + i, 1.0f / 60.0f);
+
+	sgSink += pData->mpPos[0].x;
+}
+
+// ---------------------------------------------------------------------------
+
+void IntegrateBatch(BenchData *pData)
+{
+	Vector2DBatchScaleAdd(pData->mpPosX, pData->mpPosY, pData->mpVelX, pData->mpVelY, 1.0f / 60.0f, pData->mNum);
+
+	sgSink += pData->mpPosX[0];
+}
+
+// ---------------------------------------------------------------------------
+
+// Map space to screen space, into the velocity arrays so the positions do not drift
+void TransformOne(BenchData *pData)
+{
+	unsigned int i;
+
+	for (i = 0; i < pData->mNum; ++i)
+		Matrix2DMultVec(pData->mpVel + i, &sgMapMtx, pData->mpPos + i);
+
+	sgSink += pData->mpVel[0].x;
+}
+
+// ---------------------------------------------------------------------------
+
+void TransformBatch(BenchData *pData)
+{
+	Matrix2DBatchMultVec(pData->mpVelX, pData->mpVelY, &sgMapMtx, pData->mpPosX, pData->mpPosY, pData->mNum);
+
+	sgSink += pData->mpVelX[0];
+}
+
+// ---------------------------------------------------------------------------
+
+// What the simulation did per instance: 3 matrices and 2 concatenations
+void TRSOne(BenchData *pData)
+{
+	unsigned int i;
+
+	for (i = 0; i < pData->mNum; ++i)
+	{
+		Matrix2D scale, rot, trans;
+
+		Matrix2DScale(&scale, pData->mpScaleX[i], pData->mpScaleY[i]);
+		Matrix2DRotRad(&rot, pData->mpAngle[i]);
+		Matrix2DTranslate(&trans, pData->mpPos[i].x, pData->mpPos[i].y);
+
+		Matrix2DConcat(pData->mpMtx + i, &trans, &rot);
+		Matrix2DConcat(pData->mpMtx + i, pData->mpMtx + i, &scale);
+	}
+
+	sgSink += pData->mpMtx[0].m[0][0];
+}
+
+// ---------------------------------------------------------------------------
+
+void TRSBatch(BenchData *pData)
+{
+	Matrix2DBatchTRS(pData->mpMtx, pData->mpPosX, pData->mpPosY, pData->mpAngle, pData->mpScaleX, pData->mpScaleY, pData->mNum);
+
+	sgSink += pData->mpMtx[0].m[0][0];
+}
+
+// ---------------------------------------------------------------------------
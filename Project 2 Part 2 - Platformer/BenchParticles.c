@@ -0,0 +1,96 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	BenchParticles.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Update cost of the particle system with many live
+//						particles, spawning as many as it kills every frame
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+// includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "ParticleSystem.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define BENCH_FRAME_TIME		(1.0f / 60.0f)
+#define BENCH_LIFETIME			1.75f
+#define BENCH_FRAMES			2000
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static double	BenchUpdate(ParticleSystem *pSystem, unsigned int Live);
+
+// ---------------------------------------------------------------------------
+// globals
+
+static ParticleSystem sgSystem;
+static volatile float sgSink;		// Keeps the compiler from dropping the updates
+
+// ---------------------------------------------------------------------------
+// main
+
+int main(int argc, char **argv)
+{
+	static const unsigned int lives[] = { 1000, 10000, 100000, PARTICLE_NUM_MAX };
+	unsigned int i;
+
+	printf("%-8s %-10s %-12s %s\n", "live", "frame us", "ns/particle", "dropped");
+
+	for (i = 0; i < sizeof(lives) / sizeof(lives[0]); ++i)
+	{
+		double seconds = BenchUpdate(&sgSystem, lives[i]);
+		double frame = seconds / BENCH_FRAMES;
+
+		printf("%-8u %-10.1f %-12.2f %lu\n", sgSystem.mNum, frame * 1e6, frame * 1e9 / lives[i], sgSystem.mDroppedNum);
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// Keeps about "Live" particles alive. Returns the seconds spent in BENCH_FRAMES frames
+double BenchUpdate(ParticleSystem *pSystem, unsigned int Live)
+{
+	unsigned int framesPerLife = (unsigned int)(BENCH_LIFETIME / BENCH_FRAME_TIME) + 1;
+	unsigned int perFrame = (Live + framesPerLife - 1) / framesPerLife;
+	unsigned int frame, i;
+	clock_t start;
+	double seconds;
+
+	ParticleSystemReset(pSystem);
+
+	// Fill the system up to its steady state first
+	for (frame = 0; frame < framesPerLife; ++frame)
+	{
+		for (i = 0; i < perFrame; ++i)
+			ParticleSystemSpawn(pSystem, 5, 0.0f, 0.0f, (float)(rand() % 100) / 50.0f - 1.0f, 1.0f, -20.0f);
+		ParticleSystemUpdate(pSystem, BENCH_FRAME_TIME, BENCH_LIFETIME);
+	}
+
+	pSystem->mDroppedNum = 0;
+	start = clock();
+
+	for (frame = 0; frame < BENCH_FRAMES; ++frame)
+	{
+		for (i = 0; i < perFrame; ++i)
+			ParticleSystemSpawn(pSystem, 5, 0.0f, 0.0f, (float)(i % 100) / 50.0f - 1.0f, 1.0f, -20.0f);
+		ParticleSystemUpdate(pSystem, BENCH_FRAME_TIME, BENCH_LIFETIME);
+	}
+
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	sgSink += pSystem->mPosY[pSystem->mTail];
+
+	return seconds;
+}
+
+// ---------------------------------------------------------------------------
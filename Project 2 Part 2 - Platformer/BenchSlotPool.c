@@ -0,0 +1,163 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	BenchSlotPool.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Microbenchmark of instance spawn/despawn: the old linear
+//						scan for a free flag against the slot pool free list
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+// includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "SlotPool.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define BENCH_BURST_SIZE		12			// Like the jump particle burst
+#define BENCH_OPS_PER_RUN		20000000	// Spawns (and as many despawns) per measurement
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static unsigned int	LinearAcquire(unsigned long *pFlags, unsigned int Capacity);
+static double		BenchLinear(unsigned int Capacity, unsigned int Resident);
+static double		BenchSlotPool(unsigned int Capacity, unsigned int Resident);
+
+// ---------------------------------------------------------------------------
+// globals
+
+static volatile unsigned int sgSink;		// Keeps the compiler from dropping the loops
+
+// ---------------------------------------------------------------------------
+// main
+
+int main(int argc, char **argv)
+{
+	static const unsigned int capacities[] = { 2048, 65536 };
+	unsigned int i;
+
+	printf("%-8s %-9s %-14s %-14s %s\n", "capacity", "resident", "linear Mop/s", "pool Mop/s", "speedup");
+
+	for (i = 0; i < sizeof(capacities) / sizeof(capacities[0]); ++i)
+	{
+		unsigned int capacity = capacities[i];
+		// Long lived instances at the front of the array, like the map cells, then
+		// the same with most of the array in use
+		unsigned int residents[2];
+		unsigned int r;
+
+		residents[0] = 400;
+		residents[1] = capacity - 4 * BENCH_BURST_SIZE;
+
+		for (r = 0; r < 2; ++r)
+		{
+			double linear = BenchLinear(capacity, residents[r]);
+			double pool = BenchSlotPool(capacity, residents[r]);
+
+			printf("%-8u %-9u %-14.2f %-14.2f %.1fx\n", capacity, residents[r], linear, pool, pool / linear);
+		}
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// The search GameObjectInstanceCreate used before the slot pool
+unsigned int LinearAcquire(unsigned long *pFlags, unsigned int Capacity)
+{
+	unsigned int i;
+
+	for (i = 0; i < Capacity; ++i)
+	{
+		if (pFlags[i] == 0)
+		{
+			pFlags[i] = 1;
+			return i;
+		}
+	}
+
+	return SLOT_POOL_INVALID;
+}
+
+// ---------------------------------------------------------------------------
+
+// Spawns and despawns bursts while "Resident" slots stay in use. Returns millions of spawn+despawn per second
+double BenchLinear(unsigned int Capacity, unsigned int Resident)
+{
+	unsigned long *pFlags = calloc(Capacity, sizeof(unsigned long));
+	unsigned int burst[BENCH_BURST_SIZE];
+	unsigned long op;
+	unsigned int i;
+	clock_t start;
+	double seconds;
+	// The scan is O(n), keep the run short on large arrays
+	unsigned long ops = BENCH_OPS_PER_RUN / (1 + Resident / 256);
+
+	for (i = 0; i < Resident; ++i)
+		pFlags[i] = 1;
+
+	start = clock();
+
+	for (op = 0; op < ops; op += BENCH_BURST_SIZE)
+	{
+		for (i = 0; i < BENCH_BURST_SIZE; ++i)
+			burst[i] = LinearAcquire(pFlags, Capacity);
+		for (i = 0; i < BENCH_BURST_SIZE; ++i)
+		{
+			sgSink += burst[i];
+			pFlags[burst[i]] = 0;
+		}
+	}
+
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	free(pFlags);
+
+	return seconds > 0.0 ? ops / seconds / 1e6 : 0.0;
+}
+
+// ---------------------------------------------------------------------------
+
+double BenchSlotPool(unsigned int Capacity, unsigned int Resident)
+{
+	SlotPoolEntry *pEntries = calloc(Capacity, sizeof(SlotPoolEntry));
+	SlotPool pool;
+	unsigned int burst[BENCH_BURST_SIZE];
+	unsigned long op;
+	unsigned int i;
+	clock_t start;
+	double seconds;
+	unsigned long ops = BENCH_OPS_PER_RUN;
+
+	SlotPoolInit(&pool, pEntries, Capacity);
+	for (i = 0; i < Resident; ++i)
+		SlotPoolAcquire(&pool);
+
+	start = clock();
+
+	for (op = 0; op < ops; op += BENCH_BURST_SIZE)
+	{
+		for (i = 0; i < BENCH_BURST_SIZE; ++i)
+			burst[i] = SlotPoolAcquire(&pool);
+		for (i = 0; i < BENCH_BURST_SIZE; ++i)
+		{
+			sgSink += SlotPoolGetHandle(&pool, burst[i]);
+			SlotPoolRelease(&pool, burst[i]);
+		}
+	}
+
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	free(pEntries);
+
+	return seconds > 0.0 ? ops / seconds / 1e6 : 0.0;
+}
+
+// ---------------------------------------------------------------------------
@@ -5,49 +5,257 @@
 // Creation Date	:	Sept. 28 2016
 // Purpose			:	Implementation of the binary map functions
 // History			:
-//	- 
+//	- 2026/10/17	:	The map is read in chunks, on demand, and only a
+//						few chunks stay in memory (see MapStreamFocus)
+//	- 2026/10/17	:	Binary maps (see ExportMapDataToBinaryFile) are
+//						memory mapped and need no parsing
+//	- 2026/10/17	:	Collision cells are kept in a bitset covering the
+//						whole map
+//	- 2026/10/17	:	SweepInstanceBinaryMap, continuous collision for any
+//						instance size
+//	- 2026/10/17	:	CheckInstancesBinaryMapCollision, the hot spots of many
+//						instances at once, without bounds checks
+//	- 2026/10/17	:	The state of the imported map is kept in a MapContext,
+//						one current context per thread
+//	- 2026/10/17	:	The MapContext is passed to every function instead of
+//						being current
+//	- 2026/10/17	:	MapStreamSaveState and MapStreamRestoreState, for the
+//						simulation's restarts
+//	- 2026/10/17	:	MapStreamFocus despawns the chunks it leaves behind,
+//						MapStreamRemoveEntity keeps an entity from coming back
 // Copyright 1996-2016, DigiPen Institute of Technology (USA). All rights reserved.
 // ---------------------------------------------------------------------------------
 
 
 #include "BinaryMap.h"
+#include "FileMap.h"
+#include "math.h"
+#include "limits.h"
 
 
 
-/*The number of horizontal elements*/
-static int BINARY_MAP_WIDTH;
+/*The map is not kept in memory as a whole: it is cut in MAP_CHUNK_SIZE x MAP_CHUNK_SIZE
+chunks, and only a few of them are resident at a time, in the context's mChunkCache. A chunk
+is read from the file the first time a cell of it is needed, and the least recently used
+resident chunk makes room for it when the cache is full.
+Each cell holds the value imported from the file (the MapData value)*/
+typedef struct
+{
+	int				mChunkX;			// Chunk coordinates, -1 when the cache entry is free
+	int				mChunkY;
+	unsigned long	mLastUse;			// mChunkUseCounter of the last lookup of this chunk
+	unsigned char	mCells[MAP_CHUNK_SIZE * MAP_CHUNK_SIZE];	// Indexed [Y * MAP_CHUNK_SIZE + X], relative to the chunk
+}MapChunk;
+
+/*Everything the functions know about the imported map*/
+struct MapContext
+{
+	int				mHeroStartX;				// First hero cell found by the import, -1 if none
+	int				mHeroStartY;
+
+	int				mWidth;						// The number of horizontal elements
+	int				mHeight;					// The number of vertical elements
+	int				mEntityNums[TYPE_OBJECT_NUM];	// Hero, enemy and coin cells found by the import
+
+	MapChunk		mChunkCache[MAP_CHUNK_CACHE_NUM];
+	MapChunk		*mpLastChunk;				// Chunk of the last lookup, checked first
+	unsigned long	mChunkUseCounter;
+
+	int				mChunkNumX;					// The number of chunks in each direction
+	int				mChunkNumY;
+	int				*mpChunkSlots;				// Cache entry of each chunk of the map, -1 when not resident
+
+	/*The stream state (see MapStreamSaveState)*/
+	unsigned char	*mpChunkSpawned;			// One bit per chunk of the map, set while its entities are spawned
+	unsigned char	*mpCellRemoved;				// One bit per cell [Y * mWidth + X], set for the entities not to spawn again
+	int				mStreamCenterX;				// Chunk of the last MapStreamFocus, MAP_STREAM_NO_CENTER before the first
+	int				mStreamCenterY;
+
+	/*Reads the cells of a chunk, from the text file or from the binary one*/
+	void			(*mReadChunk)(MapContext *pMap, MapChunk *pChunk);
+
+	/*The file stays open while the map is imported. "mpRowChunkOffsets" is filled by
+	the import: it holds the file position of the first cell of each row of each chunk,
+	indexed [Y * mChunkNumX + ChunkX], so a chunk is read with MAP_CHUNK_SIZE seeks*/
+	FILE			*mpMapFile;
+	long			*mpRowChunkOffsets;
+
+	/*A binary map is mapped in memory as a whole: its chunks are stored one after the
+	other, so a chunk is read with a copy, and its entities come from the spawn table*/
+	FileMap					mBinaryFile;
+	const unsigned char		*mpBinaryTiles;			// Tile codes, chunk after chunk
+	const unsigned char		*mpBinaryChunkSpawns;	// First spawn of each chunk, plus the total
+	const unsigned char		*mpBinarySpawns;		// The spawn table
+	int						mBinaryTileBits;		// 4 or 8
+
+	/*BinaryCollisionArray: one bit per cell of the whole map, set for the collision cells.
+	The grid has MAP_COLLISION_BORDER empty cells around the map. The rows go from the bottom of
+	the border up, and each row is mCollisionStride 32 bit words, cell X + MAP_COLLISION_BORDER
+	of a row being bit (X + MAP_COLLISION_BORDER) % 32 of word (X + MAP_COLLISION_BORDER) / 32.
+	For a binary map it points into the file, otherwise it is mpOwnedCollisionGrid*/
+	const unsigned int		*mpCollisionGrid;
+	unsigned int			*mpOwnedCollisionGrid;
+	unsigned int			mCollisionWidth;		// Width of the grid in cells (map + border)
+	unsigned int			mCollisionRows;			// Height of the grid in cells (map + border)
+	unsigned int			mCollisionStride;		// Words per row
+};
+
+/*mStreamCenterX before the first MapStreamFocus: no chunk is spawned*/
+#define MAP_STREAM_NO_CENTER	INT_MIN
+
+/*Bit of the grid cell (GX;GY) of the map, GX and GY including the border, without bounds check*/
+#define COLLISION_GRID_BIT(pMap, GX, GY)	(((pMap)->mpCollisionGrid[(GY) * (pMap)->mCollisionStride + ((GX) >> 5)] >> ((GX) & 31)) & 1)
+
+/*CheckInstancesBinaryMapCollision is written once against these lane macros, and
+followed by a scalar loop for the instances left over. F is a lane of floats, I of
+32 bit integers. LaneLookUp returns the bit (0 or 1) of grid "pGrid" at each lane's word and shift*/
+#if defined(BINARY_MAP_SCALAR)
 
-/*The number of vertical elements*/
-static int BINARY_MAP_HEIGHT;
+#elif defined(__AVX2__)
 
-/*This will contain all the data of the map, which will be retireved from a file
-when the "ImportMapDataFromFile" function is called*/
-static int **MapData;
+#include <immintrin.h>
 
-/*This will contain the collision dataof the binary map. It will be filled in the 
-"ImportMapDataFromFile" after filling "MapData". Basically, if an array element 
-in MapData is 1, it represents a collision cell, any other value is a non-collision
-cell*/
-static int **BinaryCollisionArray;
+#define HOT_SPOT_LANE_WIDTH			8
+typedef __m256	LaneF;
+typedef __m256i	LaneI;
+#define LaneLoadF(p)				_mm256_loadu_ps(p)
+#define LaneSetF(c)					_mm256_set1_ps(c)
+#define LaneAddF(a, b)				_mm256_add_ps(a, b)
+#define LaneSubF(a, b)				_mm256_sub_ps(a, b)
+#define LaneMulF(a, b)				_mm256_mul_ps(a, b)
+#define LaneClampF(a, lo, hi)		_mm256_min_ps(_mm256_max_ps(a, lo), hi)
+#define LaneTruncate(a)				_mm256_cvttps_epi32(a)
+#define LaneSetI(c)					_mm256_set1_epi32(c)
+#define LaneAddI(a, b)				_mm256_add_epi32(a, b)
+#define LaneMulI(a, b)				_mm256_mullo_epi32(a, b)
+#define LaneAndI(a, b)				_mm256_and_si256(a, b)
+#define LaneOrI(a, b)				_mm256_or_si256(a, b)
+#define LaneShiftRightI(a, n)		_mm256_srli_epi32(a, n)
+#define LaneShiftLeftI(a, n)		_mm256_slli_epi32(a, n)
+#define LaneStoreI(p, a)			_mm256_storeu_si256((__m256i*)(p), a)
+#define LaneLookUp(pGrid, words, shifts)	_mm256_and_si256(_mm256_srlv_epi32(_mm256_i32gather_epi32((const int*)(pGrid), words, 4), shifts), _mm256_set1_epi32(1))
 
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
 
+#include <emmintrin.h>
 
-int GetCellValue(unsigned int X, unsigned int Y)
+#define HOT_SPOT_LANE_WIDTH			4
+typedef __m128	LaneF;
+typedef __m128i	LaneI;
+#define LaneLoadF(p)				_mm_loadu_ps(p)
+#define LaneSetF(c)					_mm_set1_ps(c)
+#define LaneAddF(a, b)				_mm_add_ps(a, b)
+#define LaneSubF(a, b)				_mm_sub_ps(a, b)
+#define LaneMulF(a, b)				_mm_mul_ps(a, b)
+#define LaneClampF(a, lo, hi)		_mm_min_ps(_mm_max_ps(a, lo), hi)
+#define LaneTruncate(a)				_mm_cvttps_epi32(a)
+#define LaneSetI(c)					_mm_set1_epi32(c)
+#define LaneAddI(a, b)				_mm_add_epi32(a, b)
+#define LaneMulI(a, b)				MulLanes(a, b)
+#define LaneAndI(a, b)				_mm_and_si128(a, b)
+#define LaneOrI(a, b)				_mm_or_si128(a, b)
+#define LaneShiftRightI(a, n)		_mm_srli_epi32(a, n)
+#define LaneShiftLeftI(a, n)		_mm_slli_epi32(a, n)
+#define LaneStoreI(p, a)			_mm_storeu_si128((__m128i*)(p), a)
+#define LaneLookUp(pGrid, words, shifts)	LookUpLanes(pGrid, words, shifts)
+
+/*SSE2 has no 32 bit multiply: the even and the odd lanes are multiplied to 64 bits,
+and the low halves of the products put back together*/
+static LaneI MulLanes(LaneI A, LaneI B)
+{
+	__m128i even = _mm_mul_epu32(A, B);
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(A, 32), _mm_srli_epi64(B, 32));
+
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/*SSE2 has no gather nor per lane shift: the 4 bits are read one by one*/
+static LaneI LookUpLanes(const unsigned int *pGrid, LaneI Words, LaneI Shifts)
+{
+	int words[4], shifts[4];
+
+	_mm_storeu_si128((__m128i*)words, Words);
+	_mm_storeu_si128((__m128i*)shifts, Shifts);
+
+	return _mm_set_epi32(
+		(int)((pGrid[words[3]] >> shifts[3]) & 1), (int)((pGrid[words[2]] >> shifts[2]) & 1),
+		(int)((pGrid[words[1]] >> shifts[1]) & 1), (int)((pGrid[words[0]] >> shifts[0]) & 1));
+}
+
+#endif
+
+/*A side closer than this to a cell boundary is on it: it does not overlap the cell
+past the boundary. Keeps an instance stopped against a cell from being stuck in it*/
+#define SWEEP_EPSILON	0.0001f
+
+static MapChunk*		GetChunk(MapContext *pMap, int ChunkX, int ChunkY);
+static void				ReadTextChunk(MapContext *pMap, MapChunk *pChunk);
+static void				ReadBinaryChunk(MapContext *pMap, MapChunk *pChunk);
+static int				IndexMapFile(MapContext *pMap);
+static int				ImportBinaryMap(MapContext *pMap, char *FileName);
+static int				FitsInBinaryFile(const MapContext *pMap, size_t Offset, size_t Num, size_t ElementSize);
+static unsigned int		ReadU32(const unsigned char *pBytes);
+static void				WriteU32(FILE *pFile, unsigned int Value);
+static void				IndexMapValue(MapContext *pMap, long Cell, int Value);
+static int				AllocateCollisionGrid(MapContext *pMap);
+static int				AllocateStreamState(MapContext *pMap);
+static int				IsCellSolid(const MapContext *pMap, int X, int Y);
+static int				GetHotSpotFlag(const MapContext *pMap, float PosX, float PosY, float scaleX, float scaleY);
+static unsigned int		GetHotSpotCell(float Value, float Max);
+static void				GetCellSpan(float Min, float Max, int *pFirst, int *pLast);
+static int				IsColumnSolid(const MapContext *pMap, int X, int FirstY, int LastY);
+static int				IsRowSolid(const MapContext *pMap, int Y, int FirstX, int LastX);
+
+
+
+int GetCellValue(const MapContext *pMap, int X, int Y)
 {
 	//return 0;
 
-	if (X < 0 || Y < 0 || X >= BINARY_MAP_HEIGHT || Y >= BINARY_MAP_WIDTH)
+	return IsCellSolid(pMap, X, Y);
+}
+
+int GetMapDataValue(MapContext *pMap, int X, int Y)
+{
+	MapChunk *pChunk;
+
+	if (X < 0 || Y < 0 || X >= pMap->mWidth || Y >= pMap->mHeight)
 	{
 		return 0;
 	}
 
-	else
-	{
-		return BinaryCollisionArray[X][Y];
-	}
+	pChunk = GetChunk(pMap, X / MAP_CHUNK_SIZE, Y / MAP_CHUNK_SIZE);
+
+	return pChunk->mCells[(Y % MAP_CHUNK_SIZE) * MAP_CHUNK_SIZE + X % MAP_CHUNK_SIZE];
+}
+
+int GetMapWidth(const MapContext *pMap)
+{
+	return pMap->mWidth;
 }
 
-int CheckInstanceBinaryMapCollision(float PosX, float PosY, float scaleX, float scaleY)
+int GetMapHeight(const MapContext *pMap)
+{
+	return pMap->mHeight;
+}
+
+int GetMapEntityNum(const MapContext *pMap, int Type)
+{
+	if (Type < 0 || Type >= TYPE_OBJECT_NUM)
+		return 0;
+
+	return pMap->mEntityNums[Type];
+}
+
+int GetMapHeroStart(const MapContext *pMap, int *pX, int *pY)
+{
+	*pX = pMap->mHeroStartX;
+	*pY = pMap->mHeroStartY;
+
+	return pMap->mHeroStartX >= 0;
+}
+
+int CheckInstanceBinaryMapCollision(const MapContext *pMap, float PosX, float PosY, float scaleX, float scaleY)
 {
 	//return 0;
 	float length2 = scaleY/ 2.f;
@@ -80,24 +288,46 @@ int CheckInstanceBinaryMapCollision(float PosX, float PosY, float scaleX, float
 	int rightBotY = leftBotY;
 
 	int flag = 0;
+	int top, right, left, bottom;
+
+	//When all the hot spots are inside the grid (the map and its border), they are looked up
+	//without bounds checks. The left/right hot spots are the outermost ones on X, the
+	//top/bottom ones on Y
+	if ((unsigned int)(leftTopX + MAP_COLLISION_BORDER) < pMap->mCollisionWidth && (unsigned int)(rightTopX + MAP_COLLISION_BORDER) < pMap->mCollisionWidth &&
+		(unsigned int)(botLeftY + MAP_COLLISION_BORDER) < pMap->mCollisionRows && (unsigned int)(topLeftY + MAP_COLLISION_BORDER) < pMap->mCollisionRows)
+	{
+		int b = MAP_COLLISION_BORDER;
+
+		top = COLLISION_GRID_BIT(pMap, topLeftX + b, topLeftY + b) | COLLISION_GRID_BIT(pMap, topRightX + b, topRightY + b);
+		right = COLLISION_GRID_BIT(pMap, rightTopX + b, rightTopY + b) | COLLISION_GRID_BIT(pMap, rightBotX + b, rightBotY + b);
+		left = COLLISION_GRID_BIT(pMap, leftTopX + b, leftTopY + b) | COLLISION_GRID_BIT(pMap, leftBotX + b, leftBotY + b);
+		bottom = COLLISION_GRID_BIT(pMap, botLeftX + b, botLeftY + b) | COLLISION_GRID_BIT(pMap, botRightX + b, botRightY + b);
+	}
+	else
+	{
+		top = IsCellSolid(pMap, topLeftX, topLeftY) | IsCellSolid(pMap, topRightX, topRightY);
+		right = IsCellSolid(pMap, rightTopX, rightTopY) | IsCellSolid(pMap, rightBotX, rightBotY);
+		left = IsCellSolid(pMap, leftTopX, leftTopY) | IsCellSolid(pMap, leftBotX, leftBotY);
+		bottom = IsCellSolid(pMap, botLeftX, botLeftY) | IsCellSolid(pMap, botRightX, botRightY);
+	}
 
 	//Assuming that we're only checking the points on each side for its respective collision vs. dividing into quadrants
-	if ((GetCellValue(topLeftX, topLeftY) | GetCellValue(topRightX, topRightY)) > 0)  //Might need to change these to explicitly check for 1 for both
+	if (top)
 	{
 		flag |= COLLISION_TOP;
 	}
 
-	if ((GetCellValue(rightTopX, rightTopY) | GetCellValue(rightBotX, rightBotY)) > 0)
+	if (right)
 	{
 		flag |= COLLISION_RIGHT;
 	}
 
-	if ((GetCellValue(leftTopX, leftTopY) | GetCellValue(leftBotX, leftBotY)) > 0)
+	if (left)
 	{
 		flag |= COLLISION_LEFT;
 	}
 
-	if ((GetCellValue(botLeftX, botLeftY) | GetCellValue(botRightX, botRightY)) > 0)
+	if (bottom)
 	{
 		flag |= COLLISION_BOTTOM;
 	}
@@ -112,140 +342,1020 @@ void SnapToCell(float *Coordinate)  //Would need to add a scale factor to this t
 
 }
 
-int ImportMapDataFromFile(char *FileName)
+void CheckInstancesBinaryMapCollision(const MapContext *pMap, const float *pPosX, const float *pPosY, const float *pScaleX, const float *pScaleY, int *pFlags, unsigned int Num)
+{
+	unsigned int i = 0;
+
+#ifdef HOT_SPOT_LANE_WIDTH
+	//Hot spot coordinates are clamped to [-border, map size + border - 1]: the truncation
+	//then gives the same cell as CheckInstanceBinaryMapCollision inside the grid, and a
+	//border cell (empty) outside of it
+	const unsigned int *pGrid = pMap->mpCollisionGrid;
+	LaneF half = LaneSetF(0.5f);
+	LaneF minCoord = LaneSetF(-(float)MAP_COLLISION_BORDER);
+	LaneF maxX = LaneSetF((float)(pMap->mCollisionWidth - MAP_COLLISION_BORDER - 1));
+	LaneF maxY = LaneSetF((float)(pMap->mCollisionRows - MAP_COLLISION_BORDER - 1));
+	LaneI stride = LaneSetI((int)pMap->mCollisionStride);
+	LaneI border = LaneSetI(MAP_COLLISION_BORDER);
+	LaneI bitMask = LaneSetI(31);
+
+	for (; i + HOT_SPOT_LANE_WIDTH <= Num; i += HOT_SPOT_LANE_WIDTH)
+	{
+		LaneF posX = LaneLoadF(pPosX + i);
+		LaneF posY = LaneLoadF(pPosY + i);
+		LaneF width2 = LaneMulF(LaneLoadF(pScaleX + i), half);
+		LaneF width4 = LaneMulF(width2, half);
+		LaneF length2 = LaneMulF(LaneLoadF(pScaleY + i), half);
+		LaneF length4 = LaneMulF(length2, half);
+
+		//Grid column of the 4 hot spot columns
+		LaneI left2 = LaneAddI(LaneTruncate(LaneClampF(LaneSubF(posX, width2), minCoord, maxX)), border);
+		LaneI left4 = LaneAddI(LaneTruncate(LaneClampF(LaneSubF(posX, width4), minCoord, maxX)), border);
+		LaneI right4 = LaneAddI(LaneTruncate(LaneClampF(LaneAddF(posX, width4), minCoord, maxX)), border);
+		LaneI right2 = LaneAddI(LaneTruncate(LaneClampF(LaneAddF(posX, width2), minCoord, maxX)), border);
+
+		//First word of the 4 hot spot rows, row * stride in integers like COLLISION_GRID_BIT
+		LaneI top2 = LaneMulI(LaneAddI(LaneTruncate(LaneClampF(LaneAddF(posY, length2), minCoord, maxY)), border), stride);
+		LaneI top4 = LaneMulI(LaneAddI(LaneTruncate(LaneClampF(LaneAddF(posY, length4), minCoord, maxY)), border), stride);
+		LaneI bottom4 = LaneMulI(LaneAddI(LaneTruncate(LaneClampF(LaneSubF(posY, length4), minCoord, maxY)), border), stride);
+		LaneI bottom2 = LaneMulI(LaneAddI(LaneTruncate(LaneClampF(LaneSubF(posY, length2), minCoord, maxY)), border), stride);
+
+		LaneI top = LaneOrI(
+			LaneLookUp(pGrid, LaneAddI(top2, LaneShiftRightI(left4, 5)), LaneAndI(left4, bitMask)),
+			LaneLookUp(pGrid, LaneAddI(top2, LaneShiftRightI(right4, 5)), LaneAndI(right4, bitMask)));
+		LaneI right = LaneOrI(
+			LaneLookUp(pGrid, LaneAddI(top4, LaneShiftRightI(right2, 5)), LaneAndI(right2, bitMask)),
+			LaneLookUp(pGrid, LaneAddI(bottom4, LaneShiftRightI(right2, 5)), LaneAndI(right2, bitMask)));
+		LaneI left = LaneOrI(
+			LaneLookUp(pGrid, LaneAddI(top4, LaneShiftRightI(left2, 5)), LaneAndI(left2, bitMask)),
+			LaneLookUp(pGrid, LaneAddI(bottom4, LaneShiftRightI(left2, 5)), LaneAndI(left2, bitMask)));
+		LaneI bottom = LaneOrI(
+			LaneLookUp(pGrid, LaneAddI(bottom2, LaneShiftRightI(left4, 5)), LaneAndI(left4, bitMask)),
+			LaneLookUp(pGrid, LaneAddI(bottom2, LaneShiftRightI(right4, 5)), LaneAndI(right4, bitMask)));
+
+		//COLLISION_LEFT, RIGHT, TOP and BOTTOM are bits 0 to 3
+		LaneStoreI(pFlags + i, LaneOrI(LaneOrI(left, LaneShiftLeftI(right, 1)), LaneOrI(LaneShiftLeftI(top, 2), LaneShiftLeftI(bottom, 3))));
+	}
+#endif
+
+	for (; i < Num; ++i)
+		pFlags[i] = GetHotSpotFlag(pMap, pPosX[i], pPosY[i], pScaleX[i], pScaleY[i]);
+}
+
+void SweepInstanceBinaryMap(const MapContext *pMap, float *pPosX, float *pPosY, float scaleX, float scaleY, float DeltaX, float DeltaY, MapSweepResult *pResult)
+{
+	float x = *pPosX;
+	float y = *pPosY;
+	float halfWidth = scaleX / 2.f;
+	float halfHeight = scaleY / 2.f;
+	float remaining = 1.f;
+	float boundX, boundY;
+
+	pResult->mFlag = 0;
+	pResult->mTime = 1.f;
+	pResult->mNormalX = 0.f;
+	pResult->mNormalY = 0.f;
+
+	//The next cell boundary each leading side crosses
+	boundX = DeltaX > 0.f ? ceilf(x + halfWidth - SWEEP_EPSILON) : floorf(x - halfWidth + SWEEP_EPSILON);
+	boundY = DeltaY > 0.f ? ceilf(y + halfHeight - SWEEP_EPSILON) : floorf(y - halfHeight + SWEEP_EPSILON);
+
+	while (remaining > 0.f)
+	{
+		//Fraction of the move to each boundary. An axis that does not move never gets there
+		float timeX = DeltaX != 0.f ? (boundX - (DeltaX > 0.f ? x + halfWidth : x - halfWidth)) / DeltaX : 2.f;
+		float timeY = DeltaY != 0.f ? (boundY - (DeltaY > 0.f ? y + halfHeight : y - halfHeight)) / DeltaY : 2.f;
+		int first, last;
+
+		if (timeX < 0.f)
+			timeX = 0.f;
+		if (timeY < 0.f)
+			timeY = 0.f;
+
+		//No boundary before the end of the move
+		if (timeX >= remaining && timeY >= remaining)
+		{
+			x += DeltaX * remaining;
+			y += DeltaY * remaining;
+			break;
+		}
+
+		if (timeX <= timeY)
+		{
+			x += DeltaX * timeX;
+			y += DeltaY * timeX;
+			remaining -= timeX;
+
+			//The column the instance enters, on the rows it covers. The row of the leading side
+			//comes from the walk: a side that just crossed a boundary covers the cell past it,
+			//however little it went in
+			GetCellSpan(y - halfHeight, y + halfHeight, &first, &last);
+			if (DeltaY > 0.f)
+				last = (int)boundY - 1;
+			else if (DeltaY < 0.f)
+				first = (int)boundY;
+			if (IsColumnSolid(pMap, DeltaX > 0.f ? (int)boundX : (int)boundX - 1, first, last))
+			{
+				x = DeltaX > 0.f ? boundX - halfWidth : boundX + halfWidth;
+
+				if (0 == pResult->mFlag)
+				{
+					pResult->mTime = 1.f - remaining;
+					pResult->mNormalX = DeltaX > 0.f ? -1.f : 1.f;
+				}
+				pResult->mFlag |= DeltaX > 0.f ? COLLISION_RIGHT : COLLISION_LEFT;
+				DeltaX = 0.f;
+			}
+			else
+				boundX += DeltaX > 0.f ? 1.f : -1.f;
+		}
+		else
+		{
+			x += DeltaX * timeY;
+			y += DeltaY * timeY;
+			remaining -= timeY;
+
+			//The row the instance enters, on the columns it covers
+			GetCellSpan(x - halfWidth, x + halfWidth, &first, &last);
+			if (DeltaX > 0.f)
+				last = (int)boundX - 1;
+			else if (DeltaX < 0.f)
+				first = (int)boundX;
+			if (IsRowSolid(pMap, DeltaY > 0.f ? (int)boundY : (int)boundY - 1, first, last))
+			{
+				y = DeltaY > 0.f ? boundY - halfHeight : boundY + halfHeight;
+
+				if (0 == pResult->mFlag)
+				{
+					pResult->mTime = 1.f - remaining;
+					pResult->mNormalY = DeltaY > 0.f ? -1.f : 1.f;
+				}
+				pResult->mFlag |= DeltaY > 0.f ? COLLISION_TOP : COLLISION_BOTTOM;
+				DeltaY = 0.f;
+			}
+			else
+				boundY += DeltaY > 0.f ? 1.f : -1.f;
+		}
+	}
+
+	*pPosX = x;
+	*pPosY = y;
+}
+
+int ImportMapDataFromFile(MapContext *pMap, char *FileName)
 {
 //	return 0;
 	int w = -1;
 	int l = -1;
+	int i;
 	char trash[10];
-	FILE* input;
-	input = fopen(FileName, "r");
-	if(input == NULL)
+
+	FreeMapData(pMap);
+
+	pMap->mpMapFile = fopen(FileName, "rb");
+	if(pMap->mpMapFile == NULL)
 	{
 		return 0;
 	}
 
-	else
+	// Binary map?
+	if (4 == fread(trash, 1, 4, pMap->mpMapFile) && 0 == memcmp(trash, MAP_BINARY_MAGIC, 4))
+	{
+		fclose(pMap->mpMapFile);
+		pMap->mpMapFile = 0;
+
+		if (!ImportBinaryMap(pMap, FileName))
+		{
+			FreeMapData(pMap);
+			return 0;
+		}
+
+		return 1;
+	}
+
+	rewind(pMap->mpMapFile);
+	pMap->mReadChunk = ReadTextChunk;
+
+	if (2 != fscanf(pMap->mpMapFile, "%9s %d", trash, &w) || 2 != fscanf(pMap->mpMapFile, "%9s %d", trash, &l) || w <= 0 || l <= 0)
 	{
-		fscanf(input,"%s %i", trash, &w);
-		fscanf(input,"%s %i", trash, &l);
+		FreeMapData(pMap);
+		return 0;
+	}
 
+	pMap->mWidth = w;
+	pMap->mHeight = l;
 
+	pMap->mChunkNumX = (w + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
+	pMap->mChunkNumY = (l + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
 
-		if (w > 0 && l > 0)
-		{
-			BINARY_MAP_WIDTH = w;
-			BINARY_MAP_HEIGHT = l;
+	pMap->mpChunkSlots = malloc(pMap->mChunkNumX * pMap->mChunkNumY * sizeof(int));
+	pMap->mpRowChunkOffsets = malloc(l * pMap->mChunkNumX * sizeof(long));
 
-			MapData = malloc(l*sizeof(int*));
-			BinaryCollisionArray = malloc(l* sizeof(int*));
-		
+	if (!pMap->mpChunkSlots || !AllocateStreamState(pMap) || !pMap->mpRowChunkOffsets || !AllocateCollisionGrid(pMap))
+	{
+		FreeMapData(pMap);
+		return 0;
+	}
 
+	for (i = 0; i < pMap->mChunkNumX * pMap->mChunkNumY; ++i)
+		pMap->mpChunkSlots[i] = -1;
 
-			for (int j = BINARY_MAP_HEIGHT - 1; j >= 0; --j)
-			{
+	// Find where each chunk row starts in the file and fill the collision grid, without keeping the cells
+	if (!IndexMapFile(pMap))
+	{
+		FreeMapData(pMap);
+		return 0;
+	}
 
+	return 1;
+}
 
-				for (int i = 0; i < BINARY_MAP_WIDTH; ++i)
-				{
-					if (j == BINARY_MAP_HEIGHT - 1)
-					{
-						BinaryCollisionArray[i] = malloc(w * sizeof(int));
-						MapData[i] = malloc(w * sizeof(int));
-					}
+void FreeMapData(MapContext *pMap)
+{
+	int i;
 
-							fscanf(input,"%i", &MapData[i][j]);
+	for (i = 0; i < MAP_CHUNK_CACHE_NUM; ++i)
+	{
+		pMap->mChunkCache[i].mChunkX = -1;
+		pMap->mChunkCache[i].mChunkY = -1;
+	}
 
-							if (MapData[i][j] ==1)
-							{
-								BinaryCollisionArray[i][j] = 1;
-							}
+	pMap->mpLastChunk = 0;
+	pMap->mChunkUseCounter = 0;
 
-							else
-							{
-								BinaryCollisionArray[i][j] = 0;
-							}
-					
-				}
+	if (pMap->mpMapFile)
+		fclose(pMap->mpMapFile);
 
-				
-			}
+	free(pMap->mpOwnedCollisionGrid);
+	pMap->mpOwnedCollisionGrid = 0;
+	pMap->mpCollisionGrid = 0;
+	pMap->mCollisionWidth = 0;
+	pMap->mCollisionRows = 0;
+	pMap->mCollisionStride = 0;
 
+	FileMapClose(&pMap->mBinaryFile);
+	pMap->mpBinaryTiles = 0;
+	pMap->mpBinaryChunkSpawns = 0;
+	pMap->mpBinarySpawns = 0;
+	pMap->mReadChunk = 0;
 
+	free(pMap->mpChunkSlots);
+	free(pMap->mpChunkSpawned);
+	free(pMap->mpCellRemoved);
+	free(pMap->mpRowChunkOffsets);
 
-			//for(int i=BINARY_MAP_HEIGHT-1;i>=0;i--)//<BINARY_MAP_HEIGHT;i++)
-			//{
-			//	BinaryCollisionArray[i] = malloc(w * sizeof(int));
-			//	MapData[i] = malloc(w * sizeof(int));
+	pMap->mpMapFile = 0;
+	pMap->mpChunkSlots = 0;
+	pMap->mpChunkSpawned = 0;
+	pMap->mpCellRemoved = 0;
+	pMap->mStreamCenterX = MAP_STREAM_NO_CENTER;
+	pMap->mStreamCenterY = MAP_STREAM_NO_CENTER;
+	pMap->mpRowChunkOffsets = 0;
+	pMap->mChunkNumX = 0;
+	pMap->mChunkNumY = 0;
+	pMap->mHeroStartX = -1;
+	pMap->mHeroStartY = -1;
+	pMap->mWidth = 0;
+	pMap->mHeight = 0;
+	memset(pMap->mEntityNums, 0, sizeof(pMap->mEntityNums));
+}
 
-			//	for (int j =0;j<BINARY_MAP_WIDTH;j++)
-			//	{
-			//		
-			//		fscanf(input,"%i", &MapData[j][i]);
+MapContext* MapContextCreate(void)
+{
+	MapContext *pMap = calloc(1, sizeof(MapContext));
 
-			//		if (MapData[j][i] ==1)
-			//		{
-			//			BinaryCollisionArray[j][i] = 1;
-			//		}
+	// Start it empty: no chunk resident, no hero
+	if (pMap)
+		FreeMapData(pMap);
 
-			//		else
-			//		{
-			//			BinaryCollisionArray[j][i] = 0;
-			//		}
-			//	}
-			//}
-			fclose(input);
-			input = NULL;
-			return 1;
-		}
+	return pMap;
+}
 
-		else
-		{
-			return 0;
-		}
+void MapContextDestroy(MapContext *pMap)
+{
+	if (!pMap)
+		return;
+
+	FreeMapData(pMap);
+	free(pMap);
+}
+
+void MapStreamReset(MapContext *pMap)
+{
+	if (pMap->mpChunkSpawned)
+	{
+		memset(pMap->mpChunkSpawned, 0, (pMap->mChunkNumX * pMap->mChunkNumY + 7) / 8);
+		memset(pMap->mpCellRemoved, 0, ((size_t)pMap->mWidth * pMap->mHeight + 7) / 8);
 	}
 
+	pMap->mStreamCenterX = MAP_STREAM_NO_CENTER;
+	pMap->mStreamCenterY = MAP_STREAM_NO_CENTER;
+}
+
+/*The state is the center, then the chunk bits, then the cell bits*/
+int GetMapStreamStateSize(const MapContext *pMap)
+{
+	if (!pMap->mpChunkSpawned)
+		return 0;
+
+	return (int)(2 * sizeof(int) + (pMap->mChunkNumX * pMap->mChunkNumY + 7) / 8 + ((size_t)pMap->mWidth * pMap->mHeight + 7) / 8);
+}
+
+void MapStreamSaveState(const MapContext *pMap, unsigned char *pState)
+{
+	int chunkBytes = (pMap->mChunkNumX * pMap->mChunkNumY + 7) / 8;
+
+	if (!pMap->mpChunkSpawned)
+		return;
+
+	memcpy(pState, &pMap->mStreamCenterX, sizeof(int));
+	memcpy(pState + sizeof(int), &pMap->mStreamCenterY, sizeof(int));
+	memcpy(pState + 2 * sizeof(int), pMap->mpChunkSpawned, chunkBytes);
+	memcpy(pState + 2 * sizeof(int) + chunkBytes, pMap->mpCellRemoved, ((size_t)pMap->mWidth * pMap->mHeight + 7) / 8);
+}
+
+void MapStreamRestoreState(MapContext *pMap, const unsigned char *pState)
+{
+	int chunkBytes = (pMap->mChunkNumX * pMap->mChunkNumY + 7) / 8;
+
+	if (!pMap->mpChunkSpawned)
+		return;
 
+	memcpy(&pMap->mStreamCenterX, pState, sizeof(int));
+	memcpy(&pMap->mStreamCenterY, pState + sizeof(int), sizeof(int));
+	memcpy(pMap->mpChunkSpawned, pState + 2 * sizeof(int), chunkBytes);
+	memcpy(pMap->mpCellRemoved, pState + 2 * sizeof(int) + chunkBytes, ((size_t)pMap->mWidth * pMap->mHeight + 7) / 8);
 }
 
-void FreeMapData(void)
+void MapStreamRemoveEntity(MapContext *pMap, int X, int Y)
 {
-	for(int i=0;i<BINARY_MAP_HEIGHT;i++)
+	size_t cell = (size_t)Y * pMap->mWidth + X;
+
+	if (X >= 0 && Y >= 0 && X < pMap->mWidth && Y < pMap->mHeight)
+		pMap->mpCellRemoved[cell / 8] |= (unsigned char)(1 << (cell % 8));
+}
+
+int IsMapEntityRemoved(const MapContext *pMap, int X, int Y)
+{
+	size_t cell = (size_t)Y * pMap->mWidth + X;
+
+	if (X < 0 || Y < 0 || X >= pMap->mWidth || Y >= pMap->mHeight)
+		return 0;
+
+	return (pMap->mpCellRemoved[cell / 8] >> (cell % 8)) & 1;
+}
+
+void MapStreamFocus(MapContext *pMap, float X, float Y, int (*SpawnChunk)(void *pContext, int ChunkX, int ChunkY), void (*DespawnChunk)(void *pContext, int ChunkX, int ChunkY), void *pContext)
+{
+	int centerX = (int)X / MAP_CHUNK_SIZE;
+	int centerY = (int)Y / MAP_CHUNK_SIZE;
+	int lastX = pMap->mStreamCenterX;
+	int lastY = pMap->mStreamCenterY;
+	int cx, cy;
+
+	// The spawned chunks are all around the last center: despawn those that are too far
+	// from this one. They are spawned again when they come back in range
+	if (lastX != MAP_STREAM_NO_CENTER && (lastX != centerX || lastY != centerY))
 	{
-		free(BinaryCollisionArray[i]);
-		free(MapData[i]);
+		for (cy = lastY - MAP_STREAM_RADIUS; cy <= lastY + MAP_STREAM_RADIUS; ++cy)
+		{
+			for (cx = lastX - MAP_STREAM_RADIUS; cx <= lastX + MAP_STREAM_RADIUS; ++cx)
+			{
+				int chunk = cy * pMap->mChunkNumX + cx;
+
+				if (cx < 0 || cy < 0 || cx >= pMap->mChunkNumX || cy >= pMap->mChunkNumY)
+					continue;
+
+				if (abs(cx - centerX) <= MAP_STREAM_RADIUS && abs(cy - centerY) <= MAP_STREAM_RADIUS)
+					continue;
+
+				if (pMap->mpChunkSpawned[chunk / 8] & (1 << (chunk % 8)))
+				{
+					pMap->mpChunkSpawned[chunk / 8] &= (unsigned char)~(1 << (chunk % 8));
+					if (DespawnChunk)
+						DespawnChunk(pContext, cx, cy);
+				}
+			}
+		}
 	}
 
-	free(BinaryCollisionArray);
-	free(MapData);
+	pMap->mStreamCenterX = centerX;
+	pMap->mStreamCenterY = centerY;
+
+	for (cy = centerY - MAP_STREAM_RADIUS; cy <= centerY + MAP_STREAM_RADIUS; ++cy)
+	{
+		for (cx = centerX - MAP_STREAM_RADIUS; cx <= centerX + MAP_STREAM_RADIUS; ++cx)
+		{
+			int chunk = cy * pMap->mChunkNumX + cx;
+
+			if (cx < 0 || cy < 0 || cx >= pMap->mChunkNumX || cy >= pMap->mChunkNumY)
+				continue;
+
+			// Page the chunk in (or mark it as used), then spawn its entities if they are not.
+			// A chunk that could not be spawned whole is tried again on the next call
+			GetChunk(pMap, cx, cy);
+
+			if (0 == (pMap->mpChunkSpawned[chunk / 8] & (1 << (chunk % 8))) && SpawnChunk(pContext, cx, cy))
+				pMap->mpChunkSpawned[chunk / 8] |= (unsigned char)(1 << (chunk % 8));
+		}
+	}
+}
+
+int GetMapResidentChunkNum(const MapContext *pMap)
+{
+	int i, num = 0;
+
+	for (i = 0; i < MAP_CHUNK_CACHE_NUM; ++i)
+		if (pMap->mChunkCache[i].mChunkX >= 0)
+			++num;
+
+	return num;
 }
 
-void PrintRetrievedInformation(void)
+void PrintRetrievedInformation(MapContext *pMap)
 {
 	int i, j;
 
-	printf("Width: %i\n", BINARY_MAP_WIDTH);
-	printf("Height: %i\n", BINARY_MAP_HEIGHT);
+	printf("Width: %i\n", pMap->mWidth);
+	printf("Height: %i\n", pMap->mHeight);
 
 	printf("Map Data:\n");
-	for(j = BINARY_MAP_HEIGHT - 1; j >= 0; --j)
+	for(j = pMap->mHeight - 1; j >= 0; --j)
 	{
-		for(i = 0; i < BINARY_MAP_WIDTH; ++i)
+		for(i = 0; i < pMap->mWidth; ++i)
 		{
-			printf("%i ", MapData[i][j]);
+			printf("%i ", GetMapDataValue(pMap, i, j));
 		}
 
 		printf("\n");
 	}
 
 	printf("\n\nBinary Collision Data:\n");
-	for(j = BINARY_MAP_HEIGHT - 1; j >= 0; --j)
+	for(j = pMap->mHeight - 1; j >= 0; --j)
 	{
-		for(i = 0; i < BINARY_MAP_WIDTH; ++i)
+		for(i = 0; i < pMap->mWidth; ++i)
 		{
-			printf("%i ", BinaryCollisionArray[i][j]);
+			printf("%i ", GetCellValue(pMap, i, j));
 		}
 
 		printf("\n");
 	}
-}
\ No newline at end of file
+}
+
+/*Returns the resident chunk (ChunkX;ChunkY), reading it from the file if needed.
+The chunk coordinates must be inside the map*/
+MapChunk* GetChunk(MapContext *pMap, int ChunkX, int ChunkY)
+{
+	MapChunk *pChunk = pMap->mpLastChunk;
+	int *pSlot;
+	int i;
+
+	if (pChunk && pChunk->mChunkX == ChunkX && pChunk->mChunkY == ChunkY)
+		return pChunk;
+
+	pSlot = pMap->mpChunkSlots + ChunkY * pMap->mChunkNumX + ChunkX;
+
+	if (*pSlot >= 0)
+	{
+		pChunk = pMap->mChunkCache + *pSlot;
+	}
+	else
+	{
+		// Take a free cache entry, or the least recently used one
+		pChunk = pMap->mChunkCache;
+		for (i = 0; i < MAP_CHUNK_CACHE_NUM; ++i)
+		{
+			if (pMap->mChunkCache[i].mChunkX < 0)
+			{
+				pChunk = pMap->mChunkCache + i;
+				break;
+			}
+
+			if (pMap->mChunkCache[i].mLastUse < pChunk->mLastUse)
+				pChunk = pMap->mChunkCache + i;
+		}
+
+		// Page the previous chunk out
+		if (pChunk->mChunkX >= 0)
+			pMap->mpChunkSlots[pChunk->mChunkY * pMap->mChunkNumX + pChunk->mChunkX] = -1;
+
+		pChunk->mChunkX = ChunkX;
+		pChunk->mChunkY = ChunkY;
+		pMap->mReadChunk(pMap, pChunk);
+
+		*pSlot = (int)(pChunk - pMap->mChunkCache);
+	}
+
+	pChunk->mLastUse = ++pMap->mChunkUseCounter;
+	pMap->mpLastChunk = pChunk;
+
+	return pChunk;
+}
+
+/*Reads the cells of the chunk from the text file. The cells past the right or top
+edge of the map are empty*/
+void ReadTextChunk(MapContext *pMap, MapChunk *pChunk)
+{
+	int x, y;
+
+	memset(pChunk->mCells, 0, sizeof(pChunk->mCells));
+
+	for (y = 0; y < MAP_CHUNK_SIZE; ++y)
+	{
+		int mapY = pChunk->mChunkY * MAP_CHUNK_SIZE + y;
+
+		if (mapY >= pMap->mHeight)
+			break;
+
+		fseek(pMap->mpMapFile, pMap->mpRowChunkOffsets[mapY * pMap->mChunkNumX + pChunk->mChunkX], SEEK_SET);
+
+		for (x = 0; x < MAP_CHUNK_SIZE && pChunk->mChunkX * MAP_CHUNK_SIZE + x < pMap->mWidth; ++x)
+		{
+			int value = 0;
+
+			// Decimal, like IndexMapFile: %i would read "010" as octal
+			fscanf(pMap->mpMapFile, "%d", &value);
+			pChunk->mCells[y * MAP_CHUNK_SIZE + x] = (unsigned char)value;
+		}
+	}
+}
+
+/*Walks the cells once, from the current file position, to fill mpRowChunkOffsets and
+find the hero. The rows are stored from the top (Y = height - 1) to the bottom.
+Returns 0 if the file has less than width * height values*/
+int IndexMapFile(MapContext *pMap)
+{
+	char buffer[4096];
+	long bufferStart = ftell(pMap->mpMapFile);
+	size_t bufferSize = 0, pos = 0;
+	long cellNum = (long)pMap->mWidth * pMap->mHeight;
+	long cell = 0;
+	int inValue = 0, value = 0;
+
+	while (cell < cellNum)
+	{
+		char c;
+
+		if (pos == bufferSize)
+		{
+			bufferStart += (long)bufferSize;
+			bufferSize = fread(buffer, 1, sizeof(buffer), pMap->mpMapFile);
+			pos = 0;
+
+			if (bufferSize == 0)
+				break;
+		}
+
+		c = buffer[pos++];
+
+		if (c >= '0' && c <= '9')
+		{
+			// First digit of a cell: remember where its row of the chunk starts
+			if (!inValue)
+			{
+				int x = (int)(cell % pMap->mWidth);
+				int y = pMap->mHeight - 1 - (int)(cell / pMap->mWidth);
+
+				if (x % MAP_CHUNK_SIZE == 0)
+					pMap->mpRowChunkOffsets[y * pMap->mChunkNumX + x / MAP_CHUNK_SIZE] = bufferStart + (long)pos - 1;
+
+				inValue = 1;
+				value = 0;
+			}
+
+			value = value * 10 + (c - '0');
+		}
+		else if (inValue)
+		{
+			IndexMapValue(pMap, cell++, value);
+			inValue = 0;
+		}
+	}
+
+	// The file can end right after the last digit
+	if (inValue)
+		IndexMapValue(pMap, cell++, value);
+
+	return cell == cellNum;
+}
+
+/*Notes what the import needs to know about a cell, without keeping it*/
+void IndexMapValue(MapContext *pMap, long Cell, int Value)
+{
+	int x = (int)(Cell % pMap->mWidth);
+	int y = pMap->mHeight - 1 - (int)(Cell / pMap->mWidth);
+
+	if (Value == TYPE_OBJECT_HERO || Value == TYPE_OBJECT_ENEMY1 || Value == TYPE_OBJECT_COIN)
+		++pMap->mEntityNums[Value];
+
+	if (Value == TYPE_OBJECT_COLLISION)
+	{
+		unsigned int gx = (unsigned int)(x + MAP_COLLISION_BORDER);
+		unsigned int gy = (unsigned int)(y + MAP_COLLISION_BORDER);
+
+		pMap->mpOwnedCollisionGrid[gy * pMap->mCollisionStride + (gx >> 5)] |= 1u << (gx & 31);
+	}
+	else if (Value == TYPE_OBJECT_HERO && pMap->mHeroStartX < 0)
+	{
+		pMap->mHeroStartX = x;
+		pMap->mHeroStartY = y;
+	}
+}
+
+/*Sets the size of the collision grid from the size of the map, and allocates an empty one*/
+/*The stream state of the map, cleared*/
+int AllocateStreamState(MapContext *pMap)
+{
+	pMap->mpChunkSpawned = calloc((pMap->mChunkNumX * pMap->mChunkNumY + 7) / 8, 1);
+	pMap->mpCellRemoved = calloc(((size_t)pMap->mWidth * pMap->mHeight + 7) / 8, 1);
+	pMap->mStreamCenterX = MAP_STREAM_NO_CENTER;
+	pMap->mStreamCenterY = MAP_STREAM_NO_CENTER;
+
+	return pMap->mpChunkSpawned && pMap->mpCellRemoved;
+}
+
+int AllocateCollisionGrid(MapContext *pMap)
+{
+	pMap->mCollisionWidth = (unsigned int)pMap->mWidth + 2 * MAP_COLLISION_BORDER;
+	pMap->mCollisionRows = (unsigned int)pMap->mHeight + 2 * MAP_COLLISION_BORDER;
+	pMap->mCollisionStride = (pMap->mCollisionWidth + 31) / 32;
+
+	pMap->mpOwnedCollisionGrid = calloc(pMap->mCollisionStride * pMap->mCollisionRows, sizeof(unsigned int));
+	pMap->mpCollisionGrid = pMap->mpOwnedCollisionGrid;
+
+	return pMap->mpOwnedCollisionGrid != 0;
+}
+
+/*1 if (X;Y) is a collision cell. Anything off the map is empty*/
+int IsCellSolid(const MapContext *pMap, int X, int Y)
+{
+	unsigned int gx = (unsigned int)(X + MAP_COLLISION_BORDER);
+	unsigned int gy = (unsigned int)(Y + MAP_COLLISION_BORDER);
+
+	// One compare per axis also catches the negative coordinates
+	if (gx >= pMap->mCollisionWidth || gy >= pMap->mCollisionRows)
+		return 0;
+
+	return COLLISION_GRID_BIT(pMap, gx, gy);
+}
+
+/*CheckInstanceBinaryMapCollision for one instance, with the hot spots clamped to the grid.
+Like the lanes, the 4 hot spot columns and rows are found once*/
+int GetHotSpotFlag(const MapContext *pMap, float PosX, float PosY, float scaleX, float scaleY)
+{
+	float width2 = scaleX / 2.f;
+	float width4 = width2 / 2.f;
+	float length2 = scaleY / 2.f;
+	float length4 = length2 / 2.f;
+	float maxX = (float)(pMap->mCollisionWidth - MAP_COLLISION_BORDER - 1);
+	float maxY = (float)(pMap->mCollisionRows - MAP_COLLISION_BORDER - 1);
+
+	unsigned int left2 = GetHotSpotCell(PosX - width2, maxX);
+	unsigned int left4 = GetHotSpotCell(PosX - width4, maxX);
+	unsigned int right4 = GetHotSpotCell(PosX + width4, maxX);
+	unsigned int right2 = GetHotSpotCell(PosX + width2, maxX);
+	unsigned int top2 = GetHotSpotCell(PosY + length2, maxY);
+	unsigned int top4 = GetHotSpotCell(PosY + length4, maxY);
+	unsigned int bottom4 = GetHotSpotCell(PosY - length4, maxY);
+	unsigned int bottom2 = GetHotSpotCell(PosY - length2, maxY);
+
+	unsigned int top = COLLISION_GRID_BIT(pMap, left4, top2) | COLLISION_GRID_BIT(pMap, right4, top2);
+	unsigned int right = COLLISION_GRID_BIT(pMap, right2, top4) | COLLISION_GRID_BIT(pMap, right2, bottom4);
+	unsigned int left = COLLISION_GRID_BIT(pMap, left2, top4) | COLLISION_GRID_BIT(pMap, left2, bottom4);
+	unsigned int bottom = COLLISION_GRID_BIT(pMap, left4, bottom2) | COLLISION_GRID_BIT(pMap, right4, bottom2);
+
+	return (int)(left * COLLISION_LEFT | right * COLLISION_RIGHT | top * COLLISION_TOP | bottom * COLLISION_BOTTOM);
+}
+
+/*Grid column or row of a map coordinate, clamped to the grid: past the map it is a border cell*/
+unsigned int GetHotSpotCell(float Value, float Max)
+{
+	float minCoord = -(float)MAP_COLLISION_BORDER;
+
+	Value = Value < minCoord ? minCoord : Value;
+	Value = Value > Max ? Max : Value;
+
+	return (unsigned int)((int)Value + MAP_COLLISION_BORDER);
+}
+
+/*First and last cell [Min, Max] covers on one axis*/
+void GetCellSpan(float Min, float Max, int *pFirst, int *pLast)
+{
+	*pFirst = (int)floorf(Min + SWEEP_EPSILON);
+	*pLast = (int)ceilf(Max - SWEEP_EPSILON) - 1;
+}
+
+/*Returns 1 if a cell of column X, from row FirstY to row LastY, is a collision cell*/
+int IsColumnSolid(const MapContext *pMap, int X, int FirstY, int LastY)
+{
+	int y;
+
+	for (y = FirstY; y <= LastY; ++y)
+		if (IsCellSolid(pMap, X, y))
+			return 1;
+
+	return 0;
+}
+
+/*Returns 1 if a cell of row Y, from column FirstX to column LastX, is a collision cell*/
+int IsRowSolid(const MapContext *pMap, int Y, int FirstX, int LastX)
+{
+	int x;
+
+	for (x = FirstX; x <= LastX; ++x)
+		if (IsCellSolid(pMap, x, Y))
+			return 1;
+
+	return 0;
+}
+
+/*Maps a binary map in memory and checks that its tables fit in the file*/
+int ImportBinaryMap(MapContext *pMap, char *FileName)
+{
+	const unsigned char *pData;
+	unsigned int chunkBytes, spawnNum, spawn, lastSpawn;
+	unsigned int tileOffset, chunkSpawnOffset, spawnOffset, gridOffset;
+	size_t chunkNum, gridWords, c;
+	unsigned int one = 1;
+	int i;
+
+	if (!FileMapOpen(&pMap->mBinaryFile, FileName) || pMap->mBinaryFile.mSize < MAP_BINARY_HEADER_SIZE)
+		return 0;
+
+	pData = pMap->mBinaryFile.mpData;
+
+	if (ReadU32(pData + 4) != MAP_BINARY_VERSION || ReadU32(pData + 16) != MAP_CHUNK_SIZE)
+		return 0;
+
+	pMap->mWidth = (int)ReadU32(pData + 8);
+	pMap->mHeight = (int)ReadU32(pData + 12);
+	pMap->mBinaryTileBits = (int)ReadU32(pData + 20);
+	pMap->mHeroStartX = (int)ReadU32(pData + 24);
+	pMap->mHeroStartY = (int)ReadU32(pData + 28);
+	spawnNum = ReadU32(pData + 32);
+	tileOffset = ReadU32(pData + 36);
+	chunkSpawnOffset = ReadU32(pData + 40);
+	spawnOffset = ReadU32(pData + 44);
+	gridOffset = ReadU32(pData + 48);
+
+	if (pMap->mWidth <= 0 || pMap->mHeight <= 0 || (pMap->mBinaryTileBits != 4 && pMap->mBinaryTileBits != 8) ||
+		ReadU32(pData + 52) != MAP_COLLISION_BORDER || gridOffset % 4 != 0)
+		return 0;
+
+	pMap->mCollisionWidth = (unsigned int)pMap->mWidth + 2 * MAP_COLLISION_BORDER;
+	pMap->mCollisionRows = (unsigned int)pMap->mHeight + 2 * MAP_COLLISION_BORDER;
+	pMap->mCollisionStride = (pMap->mCollisionWidth + 31) / 32;
+
+	// The grid is indexed with ints (see COLLISION_GRID_BIT and the hot spot lanes)
+	if (!FitsInBinaryFile(pMap, gridOffset, pMap->mCollisionRows, (size_t)pMap->mCollisionStride * 4))
+		return 0;
+
+	gridWords = (size_t)pMap->mCollisionStride * pMap->mCollisionRows;
+	if (gridWords > INT_MAX)
+		return 0;
+
+	// The grid is used straight from the file, unless this machine is big endian
+	if (*(unsigned char*)&one == 1)
+	{
+		pMap->mpCollisionGrid = (const unsigned int*)(pData + gridOffset);
+	}
+	else
+	{
+		if (!AllocateCollisionGrid(pMap))
+			return 0;
+
+		for (i = 0; i < (int)gridWords; ++i)
+			pMap->mpOwnedCollisionGrid[i] = ReadU32(pData + gridOffset + i * 4);
+	}
+
+	// Written so a side close to INT_MAX does not overflow. The grid bounds the number of chunks
+	pMap->mChunkNumX = (pMap->mWidth - 1) / MAP_CHUNK_SIZE + 1;
+	pMap->mChunkNumY = (pMap->mHeight - 1) / MAP_CHUNK_SIZE + 1;
+	chunkNum = (size_t)pMap->mChunkNumX * pMap->mChunkNumY;
+	chunkBytes = MAP_CHUNK_SIZE * MAP_CHUNK_SIZE * pMap->mBinaryTileBits / 8;
+
+	if (!FitsInBinaryFile(pMap, tileOffset, chunkNum, chunkBytes) ||
+		!FitsInBinaryFile(pMap, chunkSpawnOffset, chunkNum + 1, 4) ||
+		!FitsInBinaryFile(pMap, spawnOffset, spawnNum, MAP_BINARY_SPAWN_SIZE))
+		return 0;
+
+	pMap->mpBinaryTiles = pData + tileOffset;
+	pMap->mpBinaryChunkSpawns = pData + chunkSpawnOffset;
+	pMap->mpBinarySpawns = pData + spawnOffset;
+
+	// ReadBinaryChunk reads the spawns from an entry of the index to the next: they
+	// must go up, and end with the whole table
+	lastSpawn = 0;
+	for (c = 0; c <= chunkNum; ++c)
+	{
+		spawn = ReadU32(pMap->mpBinaryChunkSpawns + c * 4);
+		if (spawn < lastSpawn || spawn > spawnNum)
+			return 0;
+		lastSpawn = spawn;
+	}
+
+	if (lastSpawn != spawnNum)
+		return 0;
+
+	for (spawn = 0; spawn < spawnNum; ++spawn)
+	{
+		unsigned int type = ReadU32(pMap->mpBinarySpawns + (size_t)spawn * MAP_BINARY_SPAWN_SIZE + 8);
+
+		if (type < TYPE_OBJECT_NUM)
+			++pMap->mEntityNums[type];
+	}
+
+	pMap->mpChunkSlots = malloc(chunkNum * sizeof(int));
+	if (!pMap->mpChunkSlots || !AllocateStreamState(pMap))
+		return 0;
+
+	for (i = 0; i < (int)chunkNum; ++i)
+		pMap->mpChunkSlots[i] = -1;
+
+	pMap->mReadChunk = ReadBinaryChunk;
+
+	return 1;
+}
+
+/*Returns 1 if "Num" elements of "ElementSize" bytes from "Offset" are in the mapped
+file. Divides instead of multiplying, so no size from the file can overflow*/
+int FitsInBinaryFile(const MapContext *pMap, size_t Offset, size_t Num, size_t ElementSize)
+{
+	size_t size = pMap->mBinaryFile.mSize;
+
+	return Offset <= size && (ElementSize == 0 || Num <= (size - Offset) / ElementSize);
+}
+
+/*Copies the tile codes of the chunk, then writes its entities over them*/
+void ReadBinaryChunk(MapContext *pMap, MapChunk *pChunk)
+{
+	size_t chunk = (size_t)pChunk->mChunkY * pMap->mChunkNumX + pChunk->mChunkX;
+	unsigned int spawn, spawnEnd;
+	int i;
+
+	if (pMap->mBinaryTileBits == 8)
+	{
+		memcpy(pChunk->mCells, pMap->mpBinaryTiles + chunk * (MAP_CHUNK_SIZE * MAP_CHUNK_SIZE), MAP_CHUNK_SIZE * MAP_CHUNK_SIZE);
+	}
+	else
+	{
+		// Two cells per byte, the first one in the low bits
+		const unsigned char *pTiles = pMap->mpBinaryTiles + chunk * (MAP_CHUNK_SIZE * MAP_CHUNK_SIZE / 2);
+
+		for (i = 0; i < MAP_CHUNK_SIZE * MAP_CHUNK_SIZE / 2; ++i)
+		{
+			pChunk->mCells[2 * i] = pTiles[i] & 0x0F;
+			pChunk->mCells[2 * i + 1] = pTiles[i] >> 4;
+		}
+	}
+
+	spawn = ReadU32(pMap->mpBinaryChunkSpawns + chunk * 4);
+	spawnEnd = ReadU32(pMap->mpBinaryChunkSpawns + chunk * 4 + 4);
+
+	for (; spawn < spawnEnd; ++spawn)
+	{
+		const unsigned char *pSpawn = pMap->mpBinarySpawns + (size_t)spawn * MAP_BINARY_SPAWN_SIZE;
+		int x = (int)ReadU32(pSpawn) - pChunk->mChunkX * MAP_CHUNK_SIZE;
+		int y = (int)ReadU32(pSpawn + 4) - pChunk->mChunkY * MAP_CHUNK_SIZE;
+
+		if (x >= 0 && y >= 0 && x < MAP_CHUNK_SIZE && y < MAP_CHUNK_SIZE)
+			pChunk->mCells[y * MAP_CHUNK_SIZE + x] = (unsigned char)ReadU32(pSpawn + 8);
+	}
+}
+
+int ExportMapDataToBinaryFile(MapContext *pMap, char *FileName, int TileBits)
+{
+	FILE *pFile;
+	unsigned int *pSpawns = 0;			// x, y and type of each spawn, chunk after chunk
+	unsigned int *pChunkSpawns;			// First spawn of each chunk, plus the total
+	unsigned int spawnNum = 0, spawnMax = 0;
+	unsigned int chunkNum, chunkBytes, tileOffset, gridWords;
+	int cx, cy, x, y, i;
+
+	if ((TileBits != 4 && TileBits != 8) || pMap->mWidth <= 0)
+		return 0;
+
+	chunkNum = (unsigned int)(pMap->mChunkNumX * pMap->mChunkNumY);
+	chunkBytes = MAP_CHUNK_SIZE * MAP_CHUNK_SIZE * TileBits / 8;
+	gridWords = pMap->mCollisionStride * pMap->mCollisionRows;
+	tileOffset = MAP_BINARY_HEADER_SIZE + gridWords * 4;
+
+	pChunkSpawns = malloc((chunkNum + 1) * sizeof(unsigned int));
+	pFile = fopen(FileName, "wb");
+	if (!pChunkSpawns || !pFile)
+	{
+		free(pChunkSpawns);
+		if (pFile)
+			fclose(pFile);
+		return 0;
+	}
+
+	// The header is written last, once the number of spawns is known
+	fseek(pFile, MAP_BINARY_HEADER_SIZE, SEEK_SET);
+
+	for (i = 0; i < (int)gridWords; ++i)
+		WriteU32(pFile, pMap->mpCollisionGrid[i]);
+
+	// Tiles, chunk after chunk. The entities go to the spawn table, and leave an empty cell
+	for (cy = 0; cy < pMap->mChunkNumY; ++cy)
+	{
+		for (cx = 0; cx < pMap->mChunkNumX; ++cx)
+		{
+			unsigned char codes[MAP_CHUNK_SIZE * MAP_CHUNK_SIZE];
+
+			pChunkSpawns[cy * pMap->mChunkNumX + cx] = spawnNum;
+
+			for (y = 0; y < MAP_CHUNK_SIZE; ++y)
+			{
+				for (x = 0; x < MAP_CHUNK_SIZE; ++x)
+				{
+					int mapX = cx * MAP_CHUNK_SIZE + x;
+					int mapY = cy * MAP_CHUNK_SIZE + y;
+					int value = GetMapDataValue(pMap, mapX, mapY);
+
+					if (value == TYPE_OBJECT_HERO || value == TYPE_OBJECT_ENEMY1 || value == TYPE_OBJECT_COIN)
+					{
+						if (spawnNum == spawnMax)
+						{
+							unsigned int *pGrown;
+
+							spawnMax = spawnMax ? spawnMax * 2 : 64;
+							pGrown = realloc(pSpawns, spawnMax * 3 * sizeof(unsigned int));
+							if (!pGrown)
+							{
+								free(pSpawns);
+								free(pChunkSpawns);
+								fclose(pFile);
+								return 0;
+							}
+							pSpawns = pGrown;
+						}
+
+						pSpawns[spawnNum * 3] = (unsigned int)mapX;
+						pSpawns[spawnNum * 3 + 1] = (unsigned int)mapY;
+						pSpawns[spawnNum * 3 + 2] = (unsigned int)value;
+						++spawnNum;
+
+						value = TYPE_OBJECT_EMPTY;
+					}
+
+					if (value < 0 || value > (TileBits == 4 ? 15 : 255))
+						value = TYPE_OBJECT_EMPTY;
+
+					codes[y * MAP_CHUNK_SIZE + x] = (unsigned char)value;
+				}
+			}
+
+			if (TileBits == 8)
+				fwrite(codes, 1, sizeof(codes), pFile);
+			else
+			{
+				for (i = 0; i < MAP_CHUNK_SIZE * MAP_CHUNK_SIZE; i += 2)
+					fputc(codes[i] | (codes[i + 1] << 4), pFile);
+			}
+		}
+	}
+
+	pChunkSpawns[chunkNum] = spawnNum;
+
+	for (i = 0; i <= (int)chunkNum; ++i)
+		WriteU32(pFile, pChunkSpawns[i]);
+
+	for (i = 0; i < (int)spawnNum * 3; ++i)
+		WriteU32(pFile, pSpawns[i]);
+
+	rewind(pFile);
+	fwrite(MAP_BINARY_MAGIC, 1, 4, pFile);
+	WriteU32(pFile, MAP_BINARY_VERSION);
+	WriteU32(pFile, (unsigned int)pMap->mWidth);
+	WriteU32(pFile, (unsigned int)pMap->mHeight);
+	WriteU32(pFile, MAP_CHUNK_SIZE);
+	WriteU32(pFile, (unsigned int)TileBits);
+	WriteU32(pFile, (unsigned int)pMap->mHeroStartX);
+	WriteU32(pFile, (unsigned int)pMap->mHeroStartY);
+	WriteU32(pFile, spawnNum);
+	WriteU32(pFile, tileOffset);
+	WriteU32(pFile, tileOffset + chunkNum * chunkBytes);
+	WriteU32(pFile, tileOffset + chunkNum * chunkBytes + (chunkNum + 1) * 4);
+	WriteU32(pFile, MAP_BINARY_HEADER_SIZE);
+	WriteU32(pFile, MAP_COLLISION_BORDER);
+
+	free(pSpawns);
+	free(pChunkSpawns);
+
+	return 0 == fclose(pFile);
+}
+
+/*The binary map is little endian, whatever the platform*/
+unsigned int ReadU32(const unsigned char *pBytes)
+{
+	return (unsigned int)pBytes[0] | ((unsigned int)pBytes[1] << 8) | ((unsigned int)pBytes[2] << 16) | ((unsigned int)pBytes[3] << 24);
+}
+
+void WriteU32(FILE *pFile, unsigned int Value)
+{
+	fputc(Value & 0xFF, pFile);
+	fputc((Value >> 8) & 0xFF, pFile);
+	fputc((Value >> 16) & 0xFF, pFile);
+	fputc((Value >> 24) & 0xFF, pFile);
+}
@@ -10,6 +10,8 @@
 // ---------------------------------------------------------------------------------
 
 
+#ifndef BINARY_MAP_H
+#define BINARY_MAP_H
 
 #include "stdio.h"
 #include "stdlib.h"
@@ -20,6 +22,40 @@
 #define	COLLISION_TOP		0x00000004	//0100
 #define	COLLISION_BOTTOM	0x00000008	//1000
 
+#define MAP_CHUNK_SIZE			16		//Width and height of a chunk of the map, in cells
+#define MAP_CHUNK_CACHE_NUM		256		//The number of chunks kept in memory
+#define MAP_STREAM_RADIUS		2		//MapStreamFocus keeps the chunks up to this far (in chunks) around its point
+#define MAP_COLLISION_BORDER	2		//Empty cells around the map in the collision grid
+
+/*Binary map file. Every number is a little endian 32 bit unsigned integer.
+	Header (MAP_BINARY_HEADER_SIZE bytes):
+		0	"PMAP"
+		4	version (MAP_BINARY_VERSION)
+		8	width, in cells
+		12	height, in cells
+		16	chunk size (MAP_CHUNK_SIZE)
+		20	bits per tile code: 4 or 8
+		24	X and Y of the hero's cell, 0xFFFFFFFF if the map has none
+		32	the number of spawns
+		36	offset of the tile codes
+		40	offset of the chunk spawn index
+		44	offset of the spawn table
+		48	offset of the collision grid
+		52	border of the collision grid (MAP_COLLISION_BORDER)
+	Collision grid: one bit per cell, set for the collision cells, for the map and an empty
+	border around it. Rows of (width + 2 * border + 31) / 32 words, from Y = -border up;
+	cell X is bit (X + border) % 32 of word (X + border) / 32. There are height + 2 * border rows.
+	Tile codes: one block of MAP_CHUNK_SIZE x MAP_CHUNK_SIZE codes per chunk, chunk (0;0)
+	first then along X. Inside a block, row after row from Y = 0, with 4 bit codes packed
+	2 per byte (low bits first). Cells past the edges of the map are 0.
+	Chunk spawn index: the first spawn of each chunk, in the same order, then the number of spawns.
+	Spawn table: X, Y and TYPE_OBJECT of each entity (MAP_BINARY_SPAWN_SIZE bytes), grouped
+	by chunk. The cell under an entity is empty in the tile codes*/
+#define MAP_BINARY_MAGIC		"PMAP"
+#define MAP_BINARY_VERSION		2
+#define MAP_BINARY_HEADER_SIZE	56
+#define MAP_BINARY_SPAWN_SIZE	12
+
 
 enum TYPE_OBJECT
 {
@@ -27,14 +63,29 @@ enum TYPE_OBJECT
 	TYPE_OBJECT_COLLISION,		//1
 	TYPE_OBJECT_HERO,			//2
 	TYPE_OBJECT_ENEMY1,			//3
-	TYPE_OBJECT_COIN			//4
+	TYPE_OBJECT_COIN,			//4
+
+	TYPE_OBJECT_NUM
 };
 
 
+/*Everything the functions below know about the imported map lives in a MapContext,
+which they all take first. Nothing else is shared: two threads with their own
+context can import and query two maps at the same time*/
+typedef struct MapContext MapContext;
+
+/*This function allocates an empty context (no map imported). Returns 0 if it could
+not be allocated*/
+MapContext* MapContextCreate(void);
+
+/*This function frees the map data of the context (see FreeMapData), and the context*/
+void MapContextDestroy(MapContext *pMap);
+
+
 /*This function retrieves the value of the element (X;Y) in BinaryCollisionArray.
 Before retrieving the value, it should check that the supplied X and Y values
 are not out of bounds (in that case return 0)*/
-int GetCellValue(unsigned int X, unsigned int Y);
+int GetCellValue(const MapContext *pMap, int X, int Y);
 
 
 /*This function creates 2 hot spots on each side of the object instance, and checks 
@@ -65,7 +116,7 @@ Example: Finding the hotspots on the left side of the object instance
 	x2 = PosX - scaleX/2	To reach the left side
 	y2 = PosY - scaleY/4	To go down 1/4 of the height
 */
-int CheckInstanceBinaryMapCollision(float PosX, float PosY, float scaleX, float scaleY);
+int CheckInstanceBinaryMapCollision(const MapContext *pMap, float PosX, float PosY, float scaleX, float scaleY);
 
 
 /*This function snaps the value sent as parameter to the center of the cell.
@@ -76,8 +127,46 @@ to an integer, then add 0.5 (which is half the cell's width or height)
 void SnapToCell(float *Coordinate);
 
 
-/*This function opens the file name "FileName" and retrieves all the map data.
-	It allocates memory for the 2 arrays: MapData & BinaryCollisionArray
+/*This function does what CheckInstanceBinaryMapCollision does, for "Num" object
+instances at once: instance i is centered on (pPosX[i];pPosY[i]), its size is
+pScaleX[i] by pScaleY[i], and its flags are written in pFlags[i].
+The hot spots are clamped to the collision grid instead of being checked against
+its bounds: past the map they land on its empty border. The flags are put together
+without branches, 4 instances at a time with SSE2 and 8 with AVX2 (where the cells
+are read with gathers). Define BINARY_MAP_SCALAR to build the scalar version only*/
+void CheckInstancesBinaryMapCollision(const MapContext *pMap, const float *pPosX, const float *pPosY, const float *pScaleX, const float *pScaleY, int *pFlags, unsigned int Num);
+
+
+/*Result of SweepInstanceBinaryMap*/
+typedef struct
+{
+	int		mFlag;			//COLLISION_* sides that hit a collision cell during the move
+	float	mTime;			//Fraction of the move done at the first hit, 1 if nothing was hit
+	float	mNormalX;		//Normal of the cell side hit first, (0;0) if nothing was hit
+	float	mNormalY;
+}MapSweepResult;
+
+
+/*This function moves an object instance of size scaleX by scaleY, centered on
+(*pPosX;*pPosY), by (DeltaX;DeltaY), and stops it against the collision cells
+whatever its size and however far it goes in one call.
+The leading sides of the instance walk the cell boundaries they cross, nearest
+first (DDA), and the cells the instance enters at each boundary are checked. When
+one is a collision cell, the instance stops right against it on that axis and
+slides on the other axis for the rest of the move.
+Cells the instance already overlaps when the move starts do not stop it.
+The position is updated, and the sides that hit, the time of impact and the
+normal of the first hit are written in "pResult"*/
+void SweepInstanceBinaryMap(const MapContext *pMap, float *pPosX, float *pPosY, float scaleX, float scaleY, float DeltaX, float DeltaY, MapSweepResult *pResult);
+
+
+/*This function opens the file name "FileName" and gets it ready to be read.
+	If the file starts with MAP_BINARY_MAGIC, it is a binary map: it is mapped in memory
+	and the chunks are copied from it. Otherwise it is a text map, as described below.
+	The cells are not kept in memory as a whole: the function only notes where each
+	chunk of the map starts in the file, and the chunks are read when a cell of them is
+	needed. MapData and BinaryCollisionArray below are the values the getters return.
+	The file stays open until FreeMapData.
 	The first line in this file is the width of the map.
 	The second line in this file is the height of the map.
 	The remaining part of the file is a series of numbers
@@ -113,11 +202,63 @@ void SnapToCell(float *Coordinate);
 	respectively.
 	
 Finally, the function returns 1 if the file named "FileName" exists, otherwise it returns 0*/
-int ImportMapDataFromFile(char *FileName);
+int ImportMapDataFromFile(MapContext *pMap, char *FileName);
+
+/*This function frees the chunks and the tables allocated by the "ImportMapDataFromFile"
+function, and closes the file*/
+void FreeMapData(MapContext *pMap);
+
+/*These functions return the size of the imported map*/
+int GetMapWidth(const MapContext *pMap);
+int GetMapHeight(const MapContext *pMap);
+
+/*This function retrieves the value of the element (X;Y) in MapData (the object
+type imported from the file), or 0 if X or Y are out of bounds*/
+int GetMapDataValue(MapContext *pMap, int X, int Y);
+
+/*This function gets the cell of the first hero of the map. Returns 0 (and -1 in
+both coordinates) if the map has none*/
+int GetMapHeroStart(const MapContext *pMap, int *pX, int *pY);
+
+/*This function returns the number of cells of the imported map holding an entity of
+type "Type" (TYPE_OBJECT_HERO, TYPE_OBJECT_ENEMY1 or TYPE_OBJECT_COIN)*/
+int GetMapEntityNum(const MapContext *pMap, int Type);
+
+/*This function makes every chunk spawnable again, and every entity, for a restart of
+the level*/
+void MapStreamReset(MapContext *pMap);
+
+/*These functions copy the stream state (which chunks are spawned, which entities were
+removed, the last focus) out of the context and back into it, to put the level back as
+it was without spawning the chunks again. The state takes GetMapStreamStateSize bytes*/
+int GetMapStreamStateSize(const MapContext *pMap);
+void MapStreamSaveState(const MapContext *pMap, unsigned char *pState);
+void MapStreamRestoreState(MapContext *pMap, const unsigned char *pState);
+
+/*This function marks the entity of cell (X;Y) as removed (a coin picked up, the hero
+that is never despawned): it is not spawned again until the next MapStreamReset.
+IsMapEntityRemoved returns 1 for such a cell*/
+void MapStreamRemoveEntity(MapContext *pMap, int X, int Y);
+int IsMapEntityRemoved(const MapContext *pMap, int X, int Y);
+
+/*This function pages in the chunks around (X;Y), up to MAP_STREAM_RADIUS chunks
+away, so they are not the next ones to be dropped from memory.
+"DespawnChunk" (if not 0) is called first for each chunk that is spawned and now
+farther than that: it is where the entities of the chunk still there get destroyed.
+"SpawnChunk" is then called for each chunk in range that is not spawned: it is where
+the entities of the chunk that were not removed get created. It returns 0 if it could
+not create them all, after destroying those it did: the chunk is tried again on the
+next call. Both get "pContext"*/
+void MapStreamFocus(MapContext *pMap, float X, float Y, int (*SpawnChunk)(void *pContext, int ChunkX, int ChunkY), void (*DespawnChunk)(void *pContext, int ChunkX, int ChunkY), void *pContext);
+
+/*This function returns the number of chunks in memory*/
+int GetMapResidentChunkNum(const MapContext *pMap);
+
+/*This function writes the imported map to "FileName" as a binary map, with 4 or 8
+bits per tile code ("TileBits"). Returns 0 if the file could not be written*/
+int ExportMapDataToBinaryFile(MapContext *pMap, char *FileName, int TileBits);
 
-/*This function frees the memory that was allocated for the 2 arrays MapData 
-& BinaryCollisionArray which was allocated in the "ImportMapDataFromFile" function*/
-void FreeMapData(void);
 
+void PrintRetrievedInformation(MapContext *pMap);
 
-void PrintRetrievedInformation();
\ No newline at end of file
+#endif // BINARY_MAP_H
@@ -0,0 +1,331 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	Broadphase.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the broadphase
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- The callbacks get the context passed to BroadphaseUpdate
+//	- 2026/10/17	:	- BroadphaseCopy
+// ---------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Broadphase.h"
+
+// ---------------------------------------------------------------------------
+
+static void	FindPairs(Broadphase *pBroadphase, unsigned int Item, unsigned int Bucket);
+static void	AddActive(Broadphase *pBroadphase, unsigned int Item);
+static void	AddPair(Broadphase *pBroadphase, unsigned int ItemA, unsigned int ItemB);
+static unsigned int	GetSearchMask(const Broadphase *pBroadphase, unsigned int Item);
+
+// ---------------------------------------------------------------------------
+
+int BroadphaseInit(Broadphase *pBroadphase, float MinX, float MinY, float MaxX, float MaxY, float CellSize, unsigned int Capacity, unsigned int PairCapacity)
+{
+	memset(pBroadphase, 0, sizeof(Broadphase));
+
+	if (!SpatialGridInit(&pBroadphase->mGrid, MinX, MinY, MaxX, MaxY, CellSize, Capacity))
+		return 0;
+
+	pBroadphase->mpX = malloc(Capacity * sizeof(float));
+	pBroadphase->mpY = malloc(Capacity * sizeof(float));
+	pBroadphase->mpHalfWidths = calloc(Capacity, sizeof(float));
+	pBroadphase->mpHalfHeights = calloc(Capacity, sizeof(float));
+	pBroadphase->mpTypes = calloc(Capacity, sizeof(unsigned char));
+	pBroadphase->mpActive = malloc(Capacity * sizeof(unsigned int));
+	pBroadphase->mpActiveIndex = malloc(Capacity * sizeof(unsigned int));
+	pBroadphase->mpPairs = malloc(PairCapacity * sizeof(BroadphasePair));
+	pBroadphase->mPairCapacity = PairCapacity;
+
+	if (!pBroadphase->mpX || !pBroadphase->mpY || !pBroadphase->mpHalfWidths || !pBroadphase->mpHalfHeights || !pBroadphase->mpTypes || !pBroadphase->mpPairs
+		|| !pBroadphase->mpActive || !pBroadphase->mpActiveIndex)
+	{
+		BroadphaseFree(pBroadphase);
+		return 0;
+	}
+
+	BroadphaseClear(pBroadphase);
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void BroadphaseFree(Broadphase *pBroadphase)
+{
+	SpatialGridFree(&pBroadphase->mGrid);
+
+	free(pBroadphase->mpX);
+	free(pBroadphase->mpY);
+	free(pBroadphase->mpHalfWidths);
+	free(pBroadphase->mpHalfHeights);
+	free(pBroadphase->mpTypes);
+	free(pBroadphase->mpActive);
+	free(pBroadphase->mpActiveIndex);
+	free(pBroadphase->mpPairs);
+
+	memset(pBroadphase, 0, sizeof(Broadphase));
+}
+
+// ---------------------------------------------------------------------------
+
+void BroadphaseClear(Broadphase *pBroadphase)
+{
+	SpatialGridClear(&pBroadphase->mGrid);
+
+	// All bytes 0xFF is SPATIAL_GRID_NONE
+	memset(pBroadphase->mpActiveIndex, 0xFF, pBroadphase->mGrid.mCapacity * sizeof(unsigned int));
+	pBroadphase->mActiveNum = 0;
+	pBroadphase->mPairNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void BroadphaseCopy(Broadphase *pDst, const Broadphase *pSrc, unsigned int ItemNum)
+{
+	if (ItemNum > pDst->mGrid.mCapacity)
+		ItemNum = pDst->mGrid.mCapacity;
+
+	SpatialGridCopy(&pDst->mGrid, &pSrc->mGrid, ItemNum);
+
+	memcpy(pDst->mpX, pSrc->mpX, ItemNum * sizeof(float));
+	memcpy(pDst->mpY, pSrc->mpY, ItemNum * sizeof(float));
+	memcpy(pDst->mpHalfWidths, pSrc->mpHalfWidths, ItemNum * sizeof(float));
+	memcpy(pDst->mpHalfHeights, pSrc->mpHalfHeights, ItemNum * sizeof(float));
+	memcpy(pDst->mpTypes, pSrc->mpTypes, ItemNum * sizeof(unsigned char));
+	memcpy(pDst->mpActiveIndex, pSrc->mpActiveIndex, ItemNum * sizeof(unsigned int));
+
+	// The active items are in the grid, so below ItemNum
+	memcpy(pDst->mpActive, pSrc->mpActive, pSrc->mActiveNum * sizeof(unsigned int));
+	pDst->mActiveNum = pSrc->mActiveNum;
+	pDst->mHalfSizeMax = pSrc->mHalfSizeMax;
+
+	memcpy(pDst->mpPairs, pSrc->mpPairs, pSrc->mPairNum * sizeof(BroadphasePair));
+	pDst->mPairNum = pSrc->mPairNum;
+	pDst->mDroppedNum = pSrc->mDroppedNum;
+}
+
+// ---------------------------------------------------------------------------
+
+void BroadphaseSetCallback(Broadphase *pBroadphase, unsigned int TypeA, unsigned int TypeB, BroadphaseCallback Callback)
+{
+	if (TypeA >= BROADPHASE_TYPE_NUM_MAX || TypeB >= BROADPHASE_TYPE_NUM_MAX || pBroadphase->mCallbackNum == BROADPHASE_CALLBACK_NUM_MAX)
+		return;
+
+	pBroadphase->mCallbacks[pBroadphase->mCallbackNum] = Callback;
+	pBroadphase->mCallbackTypesA[pBroadphase->mCallbackNum] = TypeA;
+	++pBroadphase->mCallbackNum;
+
+	// Both orders point to the callback, AddPair swaps the items to match it
+	pBroadphase->mCallbackTable[TypeA][TypeB] = (unsigned char)pBroadphase->mCallbackNum;
+	pBroadphase->mCallbackTable[TypeB][TypeA] = (unsigned char)pBroadphase->mCallbackNum;
+	pBroadphase->mTypeMasks[TypeA] |= 1u << TypeB;
+	pBroadphase->mTypeMasks[TypeB] |= 1u << TypeA;
+}
+
+// ---------------------------------------------------------------------------
+
+void BroadphaseSetBox(Broadphase *pBroadphase, unsigned int Item, unsigned int Type, float HalfWidth, float HalfHeight)
+{
+	if (Item >= pBroadphase->mGrid.mCapacity || Type >= BROADPHASE_TYPE_NUM_MAX)
+		return;
+
+	pBroadphase->mpTypes[Item] = (unsigned char)Type;
+	pBroadphase->mpHalfWidths[Item] = HalfWidth;
+	pBroadphase->mpHalfHeights[Item] = HalfHeight;
+
+	if (HalfWidth > pBroadphase->mHalfSizeMax)
+		pBroadphase->mHalfSizeMax = HalfWidth;
+	if (HalfHeight > pBroadphase->mHalfSizeMax)
+		pBroadphase->mHalfSizeMax = HalfHeight;
+
+	if (pBroadphase->mGrid.mpBuckets[Item] != SPATIAL_GRID_NONE)
+		AddActive(pBroadphase, Item);
+}
+
+// ---------------------------------------------------------------------------
+
+void BroadphaseMove(Broadphase *pBroadphase, unsigned int Item, float X, float Y)
+{
+	if (Item >= pBroadphase->mGrid.mCapacity)
+		return;
+
+	pBroadphase->mpX[Item] = X;
+	pBroadphase->mpY[Item] = Y;
+
+	SpatialGridMove(&pBroadphase->mGrid, Item, X, Y);
+	AddActive(pBroadphase, Item);
+}
+
+// ---------------------------------------------------------------------------
+
+void BroadphaseRemove(Broadphase *pBroadphase, unsigned int Item)
+{
+	unsigned int index, last;
+
+	if (Item >= pBroadphase->mGrid.mCapacity)
+		return;
+
+	SpatialGridRemove(&pBroadphase->mGrid, Item);
+
+	index = pBroadphase->mpActiveIndex[Item];
+	if (index == SPATIAL_GRID_NONE)
+		return;
+
+	// Move the last active item in its place
+	last = pBroadphase->mpActive[--pBroadphase->mActiveNum];
+	pBroadphase->mpActive[index] = last;
+	pBroadphase->mpActiveIndex[last] = index;
+	pBroadphase->mpActiveIndex[Item] = SPATIAL_GRID_NONE;
+}
+
+// ---------------------------------------------------------------------------
+
+/*
+Two boxes overlap only if their centers are less than 2 * mHalfSizeMax apart, so
+each active item is checked against the buckets up to "reach" away. Each pair is
+looked for from the item of the lower type, or the lower item when the types are
+the same: with a hero and many coins, only the hero searches
+*/
+unsigned int BroadphaseUpdate(Broadphase *pBroadphase, void *pContext)
+{
+	const SpatialGrid *pGrid = &pBroadphase->mGrid;
+	int reach = (int)(2.f * pBroadphase->mHalfSizeMax / pGrid->mCellSize) + 1;
+	unsigned int a, c, p;
+
+	pBroadphase->mPairNum = 0;
+	pBroadphase->mDroppedNum = 0;
+
+	for (a = 0; a < pBroadphase->mActiveNum; ++a)
+	{
+		unsigned int item = pBroadphase->mpActive[a];
+		int bx = (int)(pGrid->mpBuckets[item] % (unsigned int)pGrid->mWidth);
+		int by = (int)(pGrid->mpBuckets[item] / (unsigned int)pGrid->mWidth);
+		int minX = bx - reach > 0 ? bx - reach : 0;
+		int maxX = bx + reach < pGrid->mWidth - 1 ? bx + reach : pGrid->mWidth - 1;
+		int minY = by - reach > 0 ? by - reach : 0;
+		int maxY = by + reach < pGrid->mHeight - 1 ? by + reach : pGrid->mHeight - 1;
+		int x, y;
+
+		// Its type lost its callbacks since it was added
+		if (0 == GetSearchMask(pBroadphase, item))
+			continue;
+
+		for (y = minY; y <= maxY; ++y)
+			for (x = minX; x <= maxX; ++x)
+				FindPairs(pBroadphase, item, (unsigned int)(y * pGrid->mWidth + x));
+	}
+
+	// One pass per callback, so they are called in the order they were set
+	for (c = 0; c < pBroadphase->mCallbackNum; ++c)
+	{
+		for (p = 0; p < pBroadphase->mPairNum; ++p)
+		{
+			const BroadphasePair *pPair = pBroadphase->mpPairs + p;
+
+			if (pPair->mCallback != c)
+				continue;
+
+			// Removed by an earlier callback
+			if (pGrid->mpBuckets[pPair->mItemA] == SPATIAL_GRID_NONE || pGrid->mpBuckets[pPair->mItemB] == SPATIAL_GRID_NONE)
+				continue;
+
+			pBroadphase->mCallbacks[c](pContext, pPair->mItemA, pPair->mItemB);
+		}
+	}
+
+	return pBroadphase->mPairNum;
+}
+
+// ---------------------------------------------------------------------------
+
+// Tests "Item" against the items of a bucket it searches for
+void FindPairs(Broadphase *pBroadphase, unsigned int Item, unsigned int Bucket)
+{
+	const unsigned int *pNext = pBroadphase->mGrid.mpNext;
+	unsigned int type = pBroadphase->mpTypes[Item];
+	unsigned int mask = GetSearchMask(pBroadphase, Item);
+	float x = pBroadphase->mpX[Item];
+	float y = pBroadphase->mpY[Item];
+	float halfWidth = pBroadphase->mpHalfWidths[Item];
+	float halfHeight = pBroadphase->mpHalfHeights[Item];
+	unsigned int other;
+
+	for (other = pBroadphase->mGrid.mpHeads[Bucket]; other != SPATIAL_GRID_NONE; other = pNext[other])
+	{
+		float dx, dy;
+
+		if (0 == (mask & (1u << pBroadphase->mpTypes[other])) || (pBroadphase->mpTypes[other] == type && other <= Item))
+			continue;
+
+		dx = pBroadphase->mpX[other] - x;
+		dy = pBroadphase->mpY[other] - y;
+
+		if (dx < 0.f)
+			dx = -dx;
+		if (dy < 0.f)
+			dy = -dy;
+
+		if (dx <= halfWidth + pBroadphase->mpHalfWidths[other] && dy <= halfHeight + pBroadphase->mpHalfHeights[other])
+			AddPair(pBroadphase, Item, other);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+// Appends "Item" to the active items if it searches for pairs and is not in them yet
+void AddActive(Broadphase *pBroadphase, unsigned int Item)
+{
+	if (pBroadphase->mpActiveIndex[Item] != SPATIAL_GRID_NONE || 0 == GetSearchMask(pBroadphase, Item))
+		return;
+
+	pBroadphase->mpActiveIndex[Item] = pBroadphase->mActiveNum;
+	pBroadphase->mpActive[pBroadphase->mActiveNum++] = Item;
+}
+
+// ---------------------------------------------------------------------------
+
+void AddPair(Broadphase *pBroadphase, unsigned int ItemA, unsigned int ItemB)
+{
+	BroadphasePair *pPair;
+	unsigned int typeA = pBroadphase->mpTypes[ItemA];
+	unsigned int typeB = pBroadphase->mpTypes[ItemB];
+	unsigned int callback = pBroadphase->mCallbackTable[typeA][typeB] - 1u;
+
+	if (pBroadphase->mPairNum == pBroadphase->mPairCapacity)
+	{
+		++pBroadphase->mDroppedNum;
+		return;
+	}
+
+	pPair = pBroadphase->mpPairs + pBroadphase->mPairNum++;
+	pPair->mCallback = callback;
+
+	// Hand the items to the callback in the order of the types it was set for
+	if (typeA == pBroadphase->mCallbackTypesA[callback])
+	{
+		pPair->mItemA = ItemA;
+		pPair->mItemB = ItemB;
+	}
+	else
+	{
+		pPair->mItemA = ItemB;
+		pPair->mItemB = ItemA;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+// The types "Item" looks for pairs with: those with a callback, from its own type up
+unsigned int GetSearchMask(const Broadphase *pBroadphase, unsigned int Item)
+{
+	unsigned int type = pBroadphase->mpTypes[Item];
+
+	return pBroadphase->mTypeMasks[type] & (0xFFFFFFFFu << type);
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,135 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	Broadphase.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Finds the pairs of items whose boxes overlap with a
+//						SpatialGrid, and hands them to a callback per pair of types
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- The callbacks get the context passed to BroadphaseUpdate
+//	- 2026/10/17	:	- BroadphaseCopy
+// ---------------------------------------------------------------------------
+
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+// ---------------------------------------------------------------------------
+
+#include "SpatialGrid.h"
+
+// ---------------------------------------------------------------------------
+
+#define BROADPHASE_TYPE_NUM_MAX		32				// Types are 0 to 31
+#define BROADPHASE_CALLBACK_NUM_MAX	16
+
+// ---------------------------------------------------------------------------
+
+/*
+Called for each pair of overlapping boxes. ItemA is of the TypeA the callback was
+set for, ItemB of its TypeB. "pContext" is the one passed to BroadphaseUpdate.
+The callback does the exact test
+*/
+typedef void (*BroadphaseCallback)(void *pContext, unsigned int ItemA, unsigned int ItemB);
+
+typedef struct
+{
+	unsigned int		mItemA, mItemB;
+	unsigned int		mCallback;			// Index in mCallbacks
+}BroadphasePair;
+
+/*
+Items are numbered like in the grid. Each item has a type and a box: a center, filed
+in the grid, and half sizes. A pair is looked for from the item of the lower type, so
+items of types without callbacks, or whose callbacks all are with lower types, cost
+nothing but their place in the grid. The callbacks must be set before the items are
+added.
+*/
+typedef struct
+{
+	SpatialGrid			mGrid;				// Can be queried directly
+
+	float				*mpX, *mpY;			// Per item: the center of its box
+	float				*mpHalfWidths;		// and its half sizes
+	float				*mpHalfHeights;
+	unsigned char		*mpTypes;
+
+	unsigned int		*mpActive;			// The items in the grid that search for pairs (see BroadphaseUpdate)
+	unsigned int		*mpActiveIndex;		// Per item: its index in mpActive, SPATIAL_GRID_NONE when not in it
+	unsigned int		mActiveNum;
+
+	float				mHalfSizeMax;		// Largest half size ever set, it tells how many buckets around to look in
+
+	BroadphaseCallback	mCallbacks[BROADPHASE_CALLBACK_NUM_MAX];
+	unsigned int		mCallbackTypesA[BROADPHASE_CALLBACK_NUM_MAX];	// The type of the first item each callback takes
+	unsigned int		mCallbackNum;
+	unsigned char		mCallbackTable[BROADPHASE_TYPE_NUM_MAX][BROADPHASE_TYPE_NUM_MAX];	// 1 + index in mCallbacks, 0 for none
+	unsigned int		mTypeMasks[BROADPHASE_TYPE_NUM_MAX];								// Bit t is set when the type has a callback with type t
+
+	BroadphasePair		*mpPairs;			// Pairs found by the last BroadphaseUpdate
+	unsigned int		mPairNum;
+	unsigned int		mPairCapacity;
+	unsigned int		mDroppedNum;		// Pairs that did not fit, since the last BroadphaseUpdate
+}Broadphase;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function allocates an empty broadphase over [MinX, MaxX] x [MinY, MaxY] with
+buckets of "CellSize", for items 0 to Capacity - 1, that finds at most PairCapacity
+pairs per update. Returns 0 if the tables could not be allocated
+*/
+int BroadphaseInit(Broadphase *pBroadphase, float MinX, float MinY, float MaxX, float MaxY, float CellSize, unsigned int Capacity, unsigned int PairCapacity);
+
+/*
+This function frees the tables allocated by BroadphaseInit
+*/
+void BroadphaseFree(Broadphase *pBroadphase);
+
+/*
+This function takes every item out. The callbacks are kept
+*/
+void BroadphaseClear(Broadphase *pBroadphase);
+
+/*
+This function gives the first "ItemNum" items of "pDst" the boxes of those of
+"pSrc", in or out of the grid like them, and the pairs of pSrc's last update. Both
+were made with the same sizes, and their items from ItemNum up are out. The
+callbacks of pDst are kept
+*/
+void BroadphaseCopy(Broadphase *pDst, const Broadphase *pSrc, unsigned int ItemNum);
+
+/*
+This function calls "Callback" for the overlapping items of types TypeA and TypeB,
+in place of the callback set before for these types. The callbacks are called in
+the order they were set
+*/
+void BroadphaseSetCallback(Broadphase *pBroadphase, unsigned int TypeA, unsigned int TypeB, BroadphaseCallback Callback);
+
+/*
+This function sets the type and half sizes of "Item"'s box
+*/
+void BroadphaseSetBox(Broadphase *pBroadphase, unsigned int Item, unsigned int Type, float HalfWidth, float HalfHeight);
+
+/*
+This function moves the center of "Item"'s box to (X;Y), and puts it in the grid
+if it was not
+*/
+void BroadphaseMove(Broadphase *pBroadphase, unsigned int Item, float X, float Y);
+
+/*
+This function takes "Item" out
+*/
+void BroadphaseRemove(Broadphase *pBroadphase, unsigned int Item);
+
+/*
+This function finds the overlapping pairs, then calls their callbacks with "pContext".
+The callbacks can move and remove items: the pairs were found before the first call, and a pair
+whose item was removed by an earlier call is skipped. Returns the number of pairs found
+*/
+unsigned int BroadphaseUpdate(Broadphase *pBroadphase, void *pContext);
+
+// ---------------------------------------------------------------------------
+
+#endif // BROADPHASE_H
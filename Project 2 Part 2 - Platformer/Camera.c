@@ -0,0 +1,163 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	Camera.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the camera
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include "Camera.h"
+
+// ---------------------------------------------------------------------------
+
+static float	ClampViewCoord(float Value, float HalfView, float Min, float Max);
+static void		UpdatePosition(Camera *pCamera);
+
+// ---------------------------------------------------------------------------
+
+void CameraInit(Camera *pCamera, float ViewWidth, float ViewHeight, float PixelsPerUnit)
+{
+	Vector2DZero(&pCamera->mPosition);
+	Vector2DZero(&pCamera->mPrevPosition);
+	Vector2DZero(&pCamera->mFocus);
+	pCamera->mLookAhead = 0.f;
+
+	pCamera->mPixelsPerUnit = PixelsPerUnit;
+	pCamera->mHalfViewWidth = ViewWidth / PixelsPerUnit / 2.f;
+	pCamera->mHalfViewHeight = ViewHeight / PixelsPerUnit / 2.f;
+
+	pCamera->mDeadZoneHalfWidth = 0.f;
+	pCamera->mDeadZoneHalfHeight = 0.f;
+	pCamera->mLookAheadDistance = 0.f;
+	pCamera->mLookAheadSpeed = 0.f;
+
+	pCamera->mBoundsMinX = pCamera->mBoundsMinY = -HUGE_VALF;
+	pCamera->mBoundsMaxX = pCamera->mBoundsMaxY = HUGE_VALF;
+}
+
+// ---------------------------------------------------------------------------
+
+void CameraSetBounds(Camera *pCamera, float MinX, float MinY, float MaxX, float MaxY)
+{
+	pCamera->mBoundsMinX = MinX;
+	pCamera->mBoundsMinY = MinY;
+	pCamera->mBoundsMaxX = MaxX;
+	pCamera->mBoundsMaxY = MaxY;
+}
+
+// ---------------------------------------------------------------------------
+
+void CameraSetDeadZone(Camera *pCamera, float HalfWidth, float HalfHeight)
+{
+	pCamera->mDeadZoneHalfWidth = HalfWidth;
+	pCamera->mDeadZoneHalfHeight = HalfHeight;
+}
+
+// ---------------------------------------------------------------------------
+
+void CameraSetLookAhead(Camera *pCamera, float Distance, float Speed)
+{
+	pCamera->mLookAheadDistance = Distance;
+	pCamera->mLookAheadSpeed = Speed;
+}
+
+// ---------------------------------------------------------------------------
+
+void CameraSnap(Camera *pCamera, float X, float Y)
+{
+	Vector2DSet(&pCamera->mFocus, X, Y);
+	pCamera->mLookAhead = 0.f;
+
+	UpdatePosition(pCamera);
+	pCamera->mPrevPosition = pCamera->mPosition;
+}
+
+// ---------------------------------------------------------------------------
+
+void CameraFollow(Camera *pCamera, float X, float Y, float VelocityX, float FrameTime)
+{
+	float lookAheadTarget = 0.f;
+	float lookAheadStep = pCamera->mLookAheadSpeed * FrameTime;
+
+	pCamera->mPrevPosition = pCamera->mPosition;
+
+	// The focus only moves when the target pushes against the dead zone's edges
+	if (X > pCamera->mFocus.x + pCamera->mDeadZoneHalfWidth)
+		pCamera->mFocus.x = X - pCamera->mDeadZoneHalfWidth;
+	else if (X < pCamera->mFocus.x - pCamera->mDeadZoneHalfWidth)
+		pCamera->mFocus.x = X + pCamera->mDeadZoneHalfWidth;
+
+	if (Y > pCamera->mFocus.y + pCamera->mDeadZoneHalfHeight)
+		pCamera->mFocus.y = Y - pCamera->mDeadZoneHalfHeight;
+	else if (Y < pCamera->mFocus.y - pCamera->mDeadZoneHalfHeight)
+		pCamera->mFocus.y = Y + pCamera->mDeadZoneHalfHeight;
+
+	// The look-ahead slides toward the side the target is going to, and back to 0 when it stops
+	if (VelocityX > 0.f)
+		lookAheadTarget = pCamera->mLookAheadDistance;
+	else if (VelocityX < 0.f)
+		lookAheadTarget = -pCamera->mLookAheadDistance;
+
+	if (pCamera->mLookAhead < lookAheadTarget)
+		pCamera->mLookAhead = pCamera->mLookAhead + lookAheadStep < lookAheadTarget ? pCamera->mLookAhead + lookAheadStep : lookAheadTarget;
+	else if (pCamera->mLookAhead > lookAheadTarget)
+		pCamera->mLookAhead = pCamera->mLookAhead - lookAheadStep > lookAheadTarget ? pCamera->mLookAhead - lookAheadStep : lookAheadTarget;
+
+	UpdatePosition(pCamera);
+}
+
+// ---------------------------------------------------------------------------
+
+/*
+The screen is View * World, with World = Scale(PixelsPerUnit) and
+View = Translate(-Parallax * Position * PixelsPerUnit)
+*/
+void CameraGetViewTransform(const Camera *pCamera, float Parallax, float Alpha, Affine2D *pResult)
+{
+	float x = pCamera->mPrevPosition.x + Alpha * (pCamera->mPosition.x - pCamera->mPrevPosition.x);
+	float y = pCamera->mPrevPosition.y + Alpha * (pCamera->mPosition.y - pCamera->mPrevPosition.y);
+
+	Affine2DIdentity(pResult);
+	pResult->m[0][2] = -Parallax * x * pCamera->mPixelsPerUnit;
+	pResult->m[1][2] = -Parallax * y * pCamera->mPixelsPerUnit;
+}
+
+// ---------------------------------------------------------------------------
+
+void CameraGetVisibleRect(const Camera *pCamera, float Alpha, float *pMinX, float *pMinY, float *pMaxX, float *pMaxY)
+{
+	float x = pCamera->mPrevPosition.x + Alpha * (pCamera->mPosition.x - pCamera->mPrevPosition.x);
+	float y = pCamera->mPrevPosition.y + Alpha * (pCamera->mPosition.y - pCamera->mPrevPosition.y);
+
+	*pMinX = x - pCamera->mHalfViewWidth;
+	*pMaxX = x + pCamera->mHalfViewWidth;
+	*pMinY = y - pCamera->mHalfViewHeight;
+	*pMaxY = y + pCamera->mHalfViewHeight;
+}
+
+// ---------------------------------------------------------------------------
+
+// The view is centered on the focus plus the look-ahead, then kept in the bounds
+void UpdatePosition(Camera *pCamera)
+{
+	pCamera->mPosition.x = ClampViewCoord(pCamera->mFocus.x + pCamera->mLookAhead, pCamera->mHalfViewWidth, pCamera->mBoundsMinX, pCamera->mBoundsMaxX);
+	pCamera->mPosition.y = ClampViewCoord(pCamera->mFocus.y, pCamera->mHalfViewHeight, pCamera->mBoundsMinY, pCamera->mBoundsMaxY);
+}
+
+// ---------------------------------------------------------------------------
+
+float ClampViewCoord(float Value, float HalfView, float Min, float Max)
+{
+	if (Max - Min <= 2.f * HalfView)
+		return (Min + Max) / 2.f;
+	if (Value - HalfView < Min)
+		return Min + HalfView;
+	if (Value + HalfView > Max)
+		return Max - HalfView;
+
+	return Value;
+}
+
+// ---------------------------------------------------------------------------
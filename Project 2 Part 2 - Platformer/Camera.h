@@ -0,0 +1,98 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	Camera.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Scrolling camera that follows a target with a dead zone
+//						and a look-ahead, and stays inside the map
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef CAMERA_H
+#define CAMERA_H
+
+// ---------------------------------------------------------------------------
+
+#include "Affine2D.h"
+
+// ---------------------------------------------------------------------------
+
+/*
+Positions are in map space (1 unit per cell). The view transformation takes the
+world (map space scaled by mPixelsPerUnit) to the screen, whose origin is its
+center.
+*/
+typedef struct
+{
+	Vector2D		mPosition;				// Center of the view, after the last CameraFollow
+	Vector2D		mPrevPosition;			// Before the last CameraFollow, used to interpolate the drawing
+	Vector2D		mFocus;					// Point kept in the dead zone: the target without the look-ahead
+	float			mLookAhead;				// Current horizontal look-ahead offset
+
+	float			mHalfViewWidth;			// Half the view, in map units
+	float			mHalfViewHeight;
+	float			mPixelsPerUnit;
+
+	float			mDeadZoneHalfWidth;		// The target moves freely this far from mFocus
+	float			mDeadZoneHalfHeight;
+	float			mLookAheadDistance;		// How far ahead of a moving target the view goes
+	float			mLookAheadSpeed;		// How fast the look-ahead changes, in map units per second
+
+	float			mBoundsMinX, mBoundsMinY;	// The view stays inside these bounds
+	float			mBoundsMaxX, mBoundsMaxY;
+}Camera;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function sets up a camera for a ViewWidth x ViewHeight pixels screen, with no
+dead zone, no look-ahead and no bounds
+*/
+void CameraInit(Camera *pCamera, float ViewWidth, float ViewHeight, float PixelsPerUnit);
+
+/*
+This function keeps the view inside [MinX, MaxX] x [MinY, MaxY]. The view is
+centered on an axis where the bounds are smaller than the view
+*/
+void CameraSetBounds(Camera *pCamera, float MinX, float MinY, float MaxX, float MaxY);
+
+/*
+This function sets the half size of the dead zone, in map units
+*/
+void CameraSetDeadZone(Camera *pCamera, float HalfWidth, float HalfHeight);
+
+/*
+This function sets how far ahead of a moving target the view goes, and how fast
+it gets there, in map units per second
+*/
+void CameraSetLookAhead(Camera *pCamera, float Distance, float Speed);
+
+/*
+This function centers the view on (X;Y) right away
+*/
+void CameraSnap(Camera *pCamera, float X, float Y);
+
+/*
+This function moves the view after the target at (X;Y), going at VelocityX,
+for a step of FrameTime seconds
+*/
+void CameraFollow(Camera *pCamera, float X, float Y, float VelocityX, float FrameTime);
+
+/*
+This function builds the view transformation, "Alpha" of the way from the previous
+position to the current one. "Parallax" scales the scrolling: 1 for the map, less
+for a background layer that should look farther away
+*/
+void CameraGetViewTransform(const Camera *pCamera, float Parallax, float Alpha, Affine2D *pResult);
+
+/*
+This function computes the map space rectangle the view shows, "Alpha" of the way
+from the previous position to the current one
+*/
+void CameraGetVisibleRect(const Camera *pCamera, float Alpha, float *pMinX, float *pMinY, float *pMaxX, float *pMaxY);
+
+// ---------------------------------------------------------------------------
+
+#endif // CAMERA_H
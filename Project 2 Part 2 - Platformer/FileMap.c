@@ -0,0 +1,116 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	FileMap.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the file mapping
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "FileMap.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ---------------------------------------------------------------------------
+
+int FileMapOpen(FileMap *pMap, const char *pFileName)
+{
+	memset(pMap, 0, sizeof(FileMap));
+
+#ifdef _WIN32
+	{
+		HANDLE file, mapping;
+		LARGE_INTEGER size;
+		const void *pData;
+
+		file = CreateFileA(pFileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return 0;
+
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return 0;
+		}
+
+		mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return 0;
+		}
+
+		pData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!pData)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return 0;
+		}
+
+		pMap->mpData = (const unsigned char*)pData;
+		pMap->mSize = (size_t)size.QuadPart;
+		pMap->mpFile = file;
+		pMap->mpMapping = mapping;
+	}
+#else
+	{
+		int file;
+		struct stat info;
+		void *pData;
+
+		file = open(pFileName, O_RDONLY);
+		if (file < 0)
+			return 0;
+
+		if (fstat(file, &info) != 0 || info.st_size == 0)
+		{
+			close(file);
+			return 0;
+		}
+
+		pData = mmap(0, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+		// The mapping keeps the file alive
+		close(file);
+
+		if (pData == MAP_FAILED)
+			return 0;
+
+		pMap->mpData = (const unsigned char*)pData;
+		pMap->mSize = (size_t)info.st_size;
+	}
+#endif
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void FileMapClose(FileMap *pMap)
+{
+	if (!pMap->mpData)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(pMap->mpData);
+	CloseHandle((HANDLE)pMap->mpMapping);
+	CloseHandle((HANDLE)pMap->mpFile);
+#else
+	munmap((void*)pMap->mpData, pMap->mSize);
+#endif
+
+	memset(pMap, 0, sizeof(FileMap));
+}
+
+// ---------------------------------------------------------------------------
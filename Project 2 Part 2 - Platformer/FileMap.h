@@ -0,0 +1,46 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	FileMap.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Read-only memory mapping of a whole file (mmap, or
+//						CreateFileMapping on Windows)
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef FILE_MAP_H
+#define FILE_MAP_H
+
+// ---------------------------------------------------------------------------
+
+#include <stddef.h>
+
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+	const unsigned char		*mpData;		// The file's bytes, 0 when nothing is mapped
+	size_t					mSize;			// The file's size, in bytes
+
+	void					*mpFile;		// Platform handles
+	void					*mpMapping;
+}FileMap;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function maps the file "pFileName" in memory, read-only.
+Returns 0 (and leaves "pMap" empty) if the file cannot be opened or is empty
+*/
+int FileMapOpen(FileMap *pMap, const char *pFileName);
+
+/*
+This function unmaps the file. Does nothing if "pMap" is empty
+*/
+void FileMapClose(FileMap *pMap);
+
+// ---------------------------------------------------------------------------
+
+#endif // FILE_MAP_H
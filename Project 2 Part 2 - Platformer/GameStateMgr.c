@@ -9,10 +9,20 @@
 //						  manager
 // - 2008/01/31		:	- initial implementation
 // - 2015/12/10		:	- Moved game flow from "main.c" to the "GSM_MainLoop" function 
+// - 2026/10/17		:	- Fixed time step mode with interpolation for the draw
+// - 2026/10/17		:	- Pipelined mode: the updates run on a second thread while
+//						  the frame before them is drawn
+// - 2026/10/17		:	- The manager owns the World and passes it to the game
+//						  state functions
+// - 2026/10/17		:	- Prefetch: the data of a state is loaded into a World
+//						  of its own on a worker thread, and taken by the loop
+// - 2026/10/17		:	- A state with a GameStateRestart is restarted with it,
+//						  instead of being freed and initialized again
 // ---------------------------------------------------------------------------
 
 #include "GameStateMgr.h"
 #include "GameState_Platformer.h"
+#include "Thread.h"
 
 // ---------------------------------------------------------------------------
 // globals
@@ -24,12 +34,58 @@ static unsigned int	gGameStatePrev;
 unsigned int	gGameStateNext;
 
 // pointer to functions for game state life cycles functions
-void(*GameStateLoad)(void) = 0;
-void(*GameStateInit)(void) = 0;
-void(*GameStateUpdate)(void) = 0;
-void(*GameStateDraw)(void) = 0;
-void(*GameStateFree)(void) = 0;
-void(*GameStateUnload)(void) = 0;
+void(*GameStateLoad)(World *pWorld) = 0;
+void(*GameStateInit)(World *pWorld) = 0;
+void(*GameStateInput)(World *pWorld) = 0;
+void(*GameStateUpdate)(World *pWorld) = 0;
+void(*GameStateSnapshot)(World *pWorld) = 0;
+void(*GameStateDraw)(World *pWorld) = 0;
+void(*GameStateFree)(World *pWorld) = 0;
+void(*GameStateUnload)(World *pWorld) = 0;
+void(*GameStateRestart)(World *pWorld) = 0;
+
+// the world the game states run, made by GSM_MainLoop
+static World		*sgpWorld;
+
+// the part of a state's load that does not call the Alpha Engine (see GameStateMgrPrefetch)
+typedef int (*GameStateLoadDataFunction)(World *pWorld);
+
+// prefetch: sgPrefetchThread runs sgPrefetchLoadData on sgpPrefetchWorld. The world
+// is set from GameStateMgrPrefetch until the thread is joined, and is only read once
+// it is joined
+static Thread		sgPrefetchThread;
+static World		*sgpPrefetchWorld;
+static unsigned int	sgPrefetchState;
+static GameStateLoadDataFunction sgPrefetchLoadData;
+static int			sgPrefetchLoaded;		// What sgPrefetchLoadData returned
+
+// fixed time step (0 ticks per second: one update per frame)
+static unsigned int	sgTicksPerSecond;
+static unsigned int	sgMaxStepsPerFrame = 1;
+static double		sgTickTime;
+static double		sgAccumulator;
+static double		sgUpdateTime;
+static float		sgInterpolation = 1.0f;
+static double		sgFrameTime;			// Time of the frame the updates catch up with
+
+// pipelined mode: the updates of a frame and GameStateSnapshot run on sgUpdateThread
+// while the main thread draws the previous frame
+static int			sgPipelined;
+static Thread		sgUpdateThread;
+static Semaphore	sgUpdateStart;			// Posted by the main thread when a frame's updates can run
+static Semaphore	sgUpdateDone;			// Posted by the update thread when they are done
+static int			sgUpdateThreadQuit;
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static void GameStateMgrRunUpdates(void);
+static int	GameStateMgrStartUpdateThread(void);
+static void	GameStateMgrStopUpdateThread(void);
+static void	UpdateThreadMain(void *pContext);
+static GameStateLoadDataFunction GameStateMgrGetLoadData(unsigned int GameState);
+static int	GameStateMgrLoadData(void);
+static void	PrefetchThreadMain(void *pContext);
 
 // ---------------------------------------------------------------------------
 // Functions implementations
@@ -60,10 +116,13 @@ void GameStateMgrUpdate()
 	case GS_PLATFORMER:
 		GameStateLoad = GameStatePlatformLoad;
 		GameStateInit = GameStatePlatformInit;
+		GameStateInput = GameStatePlatformInput;
 		GameStateUpdate = GameStatePlatformUpdate;
+		GameStateSnapshot = GameStatePlatformSnapshot;
 		GameStateDraw = GameStatePlatformDraw;
 		GameStateFree = GameStatePlatformFree;
 		GameStateUnload = GameStatePlatformUnload;
+		GameStateRestart = GameStatePlatformRestart;
 		break;
 
 	default:
@@ -73,25 +132,260 @@ void GameStateMgrUpdate()
 
 // ---------------------------------------------------------------------------
 
+GameStateLoadDataFunction GameStateMgrGetLoadData(unsigned int GameState)
+{
+	switch (GameState)
+	{
+	case GS_PLATFORMER:
+		return GameStatePlatformLoadData;
+
+	default:
+		AE_FATAL_ERROR("invalid state!!");
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+int GameStateMgrPrefetch(unsigned int GameState)
+{
+	if (sgpPrefetchWorld && sgPrefetchState == GameState)
+		return 1;
+
+	GameStateMgrCancelPrefetch();
+
+	sgpPrefetchWorld = WorldCreate();
+	if (!sgpPrefetchWorld)
+		return 0;
+
+	sgPrefetchState = GameState;
+	sgPrefetchLoadData = GameStateMgrGetLoadData(GameState);
+	sgPrefetchLoaded = 0;
+
+	if (!ThreadCreate(&sgPrefetchThread, PrefetchThreadMain, 0))
+	{
+		WorldDestroy(sgpPrefetchWorld);
+		sgpPrefetchWorld = 0;
+		return 0;
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void GameStateMgrCancelPrefetch(void)
+{
+	if (!sgpPrefetchWorld)
+		return;
+
+	ThreadJoin(&sgPrefetchThread);
+
+	WorldDestroy(sgpPrefetchWorld);
+	sgpPrefetchWorld = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// Loads the data of the current state into sgpWorld, or takes the world it was
+// prefetched in. Returns what the state's LoadData function returned
+int GameStateMgrLoadData(void)
+{
+	if (sgpPrefetchWorld && sgPrefetchState == gGameStateCurr)
+	{
+		ThreadJoin(&sgPrefetchThread);
+
+		// The previous state was unloaded, its world holds nothing
+		WorldDestroy(sgpWorld);
+		sgpWorld = sgpPrefetchWorld;
+		sgpPrefetchWorld = 0;
+
+		return sgPrefetchLoaded;
+	}
+
+	return GameStateMgrGetLoadData(gGameStateCurr)(sgpWorld);
+}
+
+// ---------------------------------------------------------------------------
+
+void PrefetchThreadMain(void *pContext)
+{
+	sgPrefetchLoaded = sgPrefetchLoadData(sgpPrefetchWorld);
+}
+
+// ---------------------------------------------------------------------------
+
+void GameStateMgrSetFixedTimeStep(unsigned int TicksPerSecond, unsigned int MaxStepsPerFrame)
+{
+	sgTicksPerSecond = TicksPerSecond;
+	sgMaxStepsPerFrame = MaxStepsPerFrame ? MaxStepsPerFrame : 1;
+	sgTickTime = TicksPerSecond ? 1.0 / TicksPerSecond : 0.0;
+	sgAccumulator = 0.0;
+}
+
+// ---------------------------------------------------------------------------
+
+void GameStateMgrSetPipelined(int Pipelined)
+{
+	sgPipelined = Pipelined;
+}
+
+// ---------------------------------------------------------------------------
+
+double GameStateMgrGetUpdateTime(void)
+{
+	return sgUpdateTime;
+}
+
+// ---------------------------------------------------------------------------
+
+float GameStateMgrGetInterpolation(void)
+{
+	return sgInterpolation;
+}
+
+// ---------------------------------------------------------------------------
+
+// Ends with the snapshot of the state the updates left
+void GameStateMgrRunUpdates(void)
+{
+	unsigned int steps;
+
+	// Variable time step: one update with the frame time
+	if (0 == sgTicksPerSecond)
+	{
+		sgUpdateTime = sgFrameTime;
+		sgInterpolation = 1.0f;
+
+		GameStateUpdate(sgpWorld);
+		GameStateSnapshot(sgpWorld);
+		return;
+	}
+
+	sgUpdateTime = sgTickTime;
+	sgAccumulator += sgFrameTime;
+
+	for (steps = 0; sgAccumulator >= sgTickTime && steps < sgMaxStepsPerFrame; ++steps)
+	{
+		GameStateUpdate(sgpWorld);
+		sgAccumulator -= sgTickTime;
+
+		// the state is over, the rest of the frame time does not belong to it
+		if (gGameStateCurr != gGameStateNext)
+			break;
+	}
+
+	// Too far behind: drop what could not be caught up instead of spiraling
+	if (sgAccumulator >= sgTickTime)
+		sgAccumulator = 0.0;
+
+	sgInterpolation = (float)(sgAccumulator / sgTickTime);
+
+	GameStateSnapshot(sgpWorld);
+}
+
+// ---------------------------------------------------------------------------
+
+// Returns 0 if the thread could not be started
+int GameStateMgrStartUpdateThread(void)
+{
+	sgUpdateThreadQuit = 0;
+
+	if (!SemaphoreInit(&sgUpdateStart, 0))
+		return 0;
+
+	if (!SemaphoreInit(&sgUpdateDone, 0))
+	{
+		SemaphoreFree(&sgUpdateStart);
+		return 0;
+	}
+
+	if (!ThreadCreate(&sgUpdateThread, UpdateThreadMain, 0))
+	{
+		SemaphoreFree(&sgUpdateStart);
+		SemaphoreFree(&sgUpdateDone);
+		return 0;
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void GameStateMgrStopUpdateThread(void)
+{
+	sgUpdateThreadQuit = 1;
+	SemaphorePost(&sgUpdateStart);
+	ThreadJoin(&sgUpdateThread);
+
+	SemaphoreFree(&sgUpdateStart);
+	SemaphoreFree(&sgUpdateDone);
+}
+
+// ---------------------------------------------------------------------------
+
+// Between sgUpdateStart and sgUpdateDone the main thread only runs GameStateDraw
+void UpdateThreadMain(void *pContext)
+{
+	for (;;)
+	{
+		SemaphoreWait(&sgUpdateStart);
+
+		if (sgUpdateThreadQuit)
+			return;
+
+		GameStateMgrRunUpdates();
+		SemaphorePost(&sgUpdateDone);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
 
 void GSM_MainLoop(void)
 {
+	int pipelined;
+	int restarting;
+
+	sgpWorld = WorldCreate();
+	if (!sgpWorld)
+		AE_FATAL_ERROR("could not allocate the world!!");
+
+	// Without the thread, the frames are run one after the other
+	pipelined = sgPipelined && GameStateMgrStartUpdateThread();
+
 	while (gGameStateCurr != GS_QUIT)
 	{
 		// reset the system modules
 		AESysReset();
 
 		// If not restarting, load the gamestate
-		if (gGameStateCurr != GS_RESTART)
+		restarting = gGameStateCurr == GS_RESTART;
+		if (!restarting)
 		{
 			GameStateMgrUpdate();
-			GameStateLoad();
+
+			// Without its data the state is not run at all (nor freed): the game quits
+			if (!GameStateMgrLoadData())
+			{
+				gGameStateCurr = gGameStateNext = GS_QUIT;
+				break;
+			}
+
+			GameStateLoad(sgpWorld);
 		}
 		else
 			gGameStateNext = gGameStateCurr = gGameStatePrev;
 
-		// Initialize the gamestate
-		GameStateInit();
+		// Initialize the gamestate. A state with a restart function was not freed
+		if (restarting && GameStateRestart)
+			GameStateRestart(sgpWorld);
+		else
+			GameStateInit(sgpWorld);
+
+		// The time spent loading is not simulated
+		sgAccumulator = 0.0;
 
 		while (gGameStateCurr == gGameStateNext)
 		{
@@ -99,9 +393,22 @@ void GSM_MainLoop(void)
 
 			AEInputUpdate();
 
-			GameStateUpdate();
+			// The updates only see the input through the game state's copy
+			GameStateInput(sgpWorld);
+			sgFrameTime = AEFrameRateControllerGetFrameTime();
 
-			GameStateDraw();
+			if (pipelined)
+			{
+				// This frame is updated while the last one is drawn
+				SemaphorePost(&sgUpdateStart);
+				GameStateDraw(sgpWorld);
+				SemaphoreWait(&sgUpdateDone);
+			}
+			else
+			{
+				GameStateMgrRunUpdates();
+				GameStateDraw(sgpWorld);
+			}
 
 			AESysFrameEnd();
 
@@ -110,14 +417,24 @@ void GSM_MainLoop(void)
 				gGameStateNext = GS_QUIT;
 		}
 
-		GameStateFree();
-
 		if (gGameStateNext != GS_RESTART)
-			GameStateUnload();
+		{
+			GameStateFree(sgpWorld);
+			GameStateUnload(sgpWorld);
+		}
+		else if (!GameStateRestart)
+			GameStateFree(sgpWorld);
 
 		gGameStatePrev = gGameStateCurr;
 		gGameStateCurr = gGameStateNext;
 	}
+
+	if (pipelined)
+		GameStateMgrStopUpdateThread();
+
+	GameStateMgrCancelPrefetch();
+	WorldDestroy(sgpWorld);
+	sgpWorld = 0;
 }
 
 
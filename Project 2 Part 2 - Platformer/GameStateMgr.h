@@ -8,6 +8,10 @@
 // - 2008/02/08		:   - updated to be used in conjuction with the build in
 //						  game state manager in the Alpha Engine.
 // - 2007/10/26		:	- initial implementation
+// - 2026/10/17		:	- GameStateInput and GameStateSnapshot, pipelined mode
+// - 2026/10/17		:	- The game state functions get the World they run
+// - 2026/10/17		:	- Prefetch: a state's data is loaded on a worker thread
+// - 2026/10/17		:	- GameStateRestart
 // ---------------------------------------------------------------------------
 
 #ifndef GAME_STATE_MGR_H
@@ -16,6 +20,7 @@
 // ---------------------------------------------------------------------------
 
 #include "AEEngine.h"
+#include "PlatformerSim.h"
 
 // ---------------------------------------------------------------------------
 // include the list of game states
@@ -32,12 +37,21 @@ extern unsigned int gGameStateNext;
 
 // ---------------------------------------------------------------------------
 
-extern void (*GameStateLoad)();
-extern void (*GameStateInit)();
-extern void (*GameStateUpdate)();
-extern void (*GameStateDraw)();
-extern void (*GameStateFree)();
-extern void (*GameStateUnload)();
+// Each one gets the World the manager made for the game states (see GSM_MainLoop).
+// GameStateLoad runs after the state's GameStateLoadData (see GameStateMgrPrefetch).
+// If that fails, the game quits without running any of the state's functions
+extern void (*GameStateLoad)(World *pWorld);
+extern void (*GameStateInit)(World *pWorld);
+extern void (*GameStateInput)(World *pWorld);		// Once per frame, before the updates: copies the input they read
+extern void (*GameStateUpdate)(World *pWorld);
+extern void (*GameStateSnapshot)(World *pWorld);	// After the updates of a frame: copies what GameStateDraw needs
+extern void (*GameStateDraw)(World *pWorld);
+extern void (*GameStateFree)(World *pWorld);
+extern void (*GameStateUnload)(World *pWorld);
+
+// On GS_RESTART, run in place of GameStateFree then GameStateInit: it puts the state
+// back as GameStateInit left it. 0 for a state that restarts with Free and Init
+extern void (*GameStateRestart)(World *pWorld);
 
 // ---------------------------------------------------------------------------
 // Function prototypes
@@ -48,9 +62,41 @@ void GameStateMgrInit(unsigned int gameStateInit);
 // update is used to set the function pointers
 void GameStateMgrUpdate();
 
-// Main flow
+// Main flow. The World is made here, and freed when the loop ends
 void GSM_MainLoop(void);
 
+// Runs GameStateUpdate at a fixed rate of "TicksPerSecond", as many times per frame
+// as needed to catch up with the frame time, but never more than "MaxStepsPerFrame"
+// (the time that could not be simulated is dropped).
+// A rate of 0 goes back to one update per frame with the frame time
+void GameStateMgrSetFixedTimeStep(unsigned int TicksPerSecond, unsigned int MaxStepsPerFrame);
+
+// In pipelined mode the updates of a frame (and GameStateSnapshot) run on a second
+// thread while GameStateDraw draws the previous snapshot on the main thread. The
+// frame takes as long as the longest of the two instead of their sum, and is shown
+// one frame later. The updates must not call the Alpha Engine, and GameStateDraw
+// must only read the snapshot. Set it before GSM_MainLoop
+void GameStateMgrSetPipelined(int Pipelined);
+
+// Starts loading the data of "GameState" on a worker thread, into a World of its own:
+// its LoadData function (GameStatePlatformLoadData...), which must not call the
+// Alpha Engine. When the game goes to that state, the loop waits for the load if it
+// is not done yet and takes its World instead of loading the data itself, then runs
+// GameStateLoad. One state is prefetched at a time: prefetching another one drops
+// the first. Returns 0 if the thread could not be started (the state is then loaded
+// when the game goes to it, as without a prefetch)
+int GameStateMgrPrefetch(unsigned int GameState);
+
+// Waits for the prefetch in progress, if any, and drops what it loaded
+void GameStateMgrCancelPrefetch(void);
+
+// Time step, in seconds, of the current GameStateUpdate call
+double GameStateMgrGetUpdateTime(void);
+
+// How far, from 0 to 1, the frame being drawn is between the previous and the last
+// update. Always 1 without a fixed time step
+float GameStateMgrGetInterpolation(void);
+
 
 // ---------------------------------------------------------------------------
 
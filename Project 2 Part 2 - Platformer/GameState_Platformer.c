@@ -6,7 +6,34 @@
 // Purpose			:	Implementation of the platform game state
 // History			:
 //	- 2015/09/28	:	Turned into a step by step project.
-//  - 2015/12/10	:	Implemented C style component based architecture 
+//  - 2015/12/10	:	Implemented C style component based architecture
+//  - 2026/10/17	:	Gameplay moved to PlatformerSim.c. This file only
+//						holds the meshes, the drawing and the Alpha Engine backend
+//  - 2026/10/17	:	Drawing interpolates between the last two fixed steps
+//  - 2026/10/17	:	Drawing only walks the active instances
+//  - 2026/10/17	:	The map is drawn as cached chunk meshes
+//  - 2026/10/17	:	The map is drawn for a range of cells, chunk meshes
+//						are built on demand
+//  - 2026/10/17	:	The particles are drawn in one batch from the
+//						ParticleSystem
+//  - 2026/10/17	:	Instance matrices are built in one go from the map
+//						transformation and the interpolated position
+//  - 2026/10/17	:	Instances that did not move are drawn with their
+//						cached world transformation
+//  - 2026/10/17	:	Sprites are drawn by a SpriteBatch, one mesh per
+//						shape (see PlatformerRender.c)
+//  - 2026/10/17	:	Only the chunks and sprites on screen are drawn
+//  - 2026/10/17	:	A Camera follows the hero, the map is no longer centered
+//  - 2026/10/17	:	The update leaves a RenderPacket for the draw, which no
+//						longer reads the simulation. The input is copied once
+//						per frame, so the updates can run on another thread
+//  - 2026/10/17	:	The World comes from the game state manager. The
+//						camera, packets and input copies stay here: there is
+//						one window to draw and read the input from
+//  - 2026/10/17	:	The map is imported by GameStatePlatformLoadData, which
+//						the game state manager can run ahead on another thread
+//  - 2026/10/17	:	Restarts copy the level back (SimRestart) instead of
+//						freeing it and spawning it again
 // ---------------------------------------------------------------------------
 
 
@@ -16,855 +43,155 @@
 
 #include "AEEngine.h"
 #include "GameStateMgr.h"
-#include "Math2D.h"
+#include "GameState_Platformer.h"
 #include "Matrix2D.h"
-//#include "BinaryMap.h"
-#include "Vector2D.h"
+#include "BinaryMap.h"
+#include "PlatformerSim.h"
+#include "TileMapRender.h"
+#include "PlatformerRender.h"
+#include "Camera.h"
+#include "RenderPacket.h"
 
 // ---------------------------------------------------------------------------
 
-#define SHAPE_NUM_MAX				32					// The total number of different vertex buffer (Shape)
-#define GAME_OBJ_INST_NUM_MAX		2048				// The total number of different game object instances
-
-
-//Gameplay related variables and values
-#define GRAVITY -20.0f
-#define JUMP_VELOCITY 11.0f
-#define MOVE_VELOCITY_HERO 4.0f
-#define MOVE_VELOCITY_ENEMY 7.5f
-#define ENEMY_IDLE_TIME 2.0
-#define HERO_LIVES 3
 #define SCREEN_X_SCALE 30
 #define SCREEN_Y_SCALE 30
-#define PARTICLE_LIFETIME 1.75
-static int HeroLives;
-static int Hero_Initial_X;
-static int Hero_Initial_Y;
-static int TotalCoins;
-
-//Flags
-#define FLAG_ACTIVE			0x00000001
-
-
-enum OBJECT_TYPE
-{
-	OBJECT_TYPE_MAP_CELL_EMPTY,			//0
-	OBJECT_TYPE_MAP_CELL_COLLISION,		//1
-	OBJECT_TYPE_HERO,					//2
-	OBJECT_TYPE_ENEMY1,					//3
-	OBJECT_TYPE_COIN,					//4
-	PARTICLE_TYPE_JUMP_EFFECT,			//5
-	PARTICLE_TYPE_ENEMY_BURN			//6
-};
-
-//State machine states
-enum STATE
-{
-	STATE_NONE,
-	STATE_GOING_LEFT,
-	STATE_GOING_RIGHT
-};
-
-//State machine inner states
-enum INNER_STATE
-{
-	INNER_STATE_ON_ENTER,
-	INNER_STATE_ON_UPDATE,
-	INNER_STATE_ON_EXIT
-};
 
-// Struct/Class definitions
-
-typedef struct GameObjectInstance GameObjectInstance;			// Forward declaration needed, since components need to point to their owner "GameObjectInstance"
-
-// ---------------------------------------------------------------------------
-
-typedef struct
-{
-	unsigned long			mType;				// Object type (Ship, bullet, etc..)
-	AEGfxVertexList*		mpMesh;				// This will hold the triangles which will form the shape of the object
-
-}Shape;
+#define CAMERA_DEAD_ZONE_HALF_WIDTH		2.0f		// In cells
+#define CAMERA_DEAD_ZONE_HALF_HEIGHT	1.5f
+#define CAMERA_LOOK_AHEAD_DISTANCE		3.0f
+#define CAMERA_LOOK_AHEAD_SPEED			6.0f		// Cells per second
 
 // ---------------------------------------------------------------------------
 
-typedef struct
-{
-	Shape *mpShape;
-
-	GameObjectInstance *	mpOwner;			// This component's owner
-}Component_Sprite;
-
-// ---------------------------------------------------------------------------
-
-typedef struct
-{
-	Vector2D					mPosition;		// Current position
-	float					mAngle;			// Current angle
-	float					mScaleX;		// Current X scaling value
-	float					mScaleY;		// Current Y scaling value
-
-	Matrix2D					mTransform;		// Object transformation matrix: Each frame, calculate the object instance's transformation matrix and save it here
-
-	GameObjectInstance *	mpOwner;		// This component's owner
-}Component_Transform;
-
-// ---------------------------------------------------------------------------
+static Matrix2D sgMapTransform;
+static Affine2D sgMapAffine;			// sgMapTransform, the simulation's world transformation
+static Camera sgCamera;
+static RenderPacketQueue sgPackets;
 
-typedef struct
-{
-	Vector2D					mVelocity;		// Current velocity
+// Input state of the frame being updated, copied by GameStatePlatformInput
+static int sgFrameInput[SIM_INPUT_NUM];
 
-	GameObjectInstance *	mpOwner;		// This component's owner
-}Component_Physics;
+// Input state seen by the previous update, to detect presses between updates
+static int sgPrevUpdateInput[SIM_INPUT_NUM];
 
 // ---------------------------------------------------------------------------
 
-typedef struct
-{
-	double					mCounter;		// Counter, used to wait before switching movement direction
-	enum STATE				mState;			// Going left or right?
-	enum INNER_STATE		mInnerState;	// On enter, On update or On exit?
+// Alpha Engine implementation of the simulation backend
+static double	AEBackendGetFrameTime(void *pContext);
+static int		AEBackendCheckInputCurr(void *pContext, unsigned int Input);
+static int		AEBackendCheckInputTriggered(void *pContext, unsigned int Input);
 
-	GameObjectInstance *	mpOwner;		// This component's owner
-}Component_AI;
+static void		FollowHero(World *pWorld, int Snap);
+static void		StartPlay(World *pWorld);
 
-// ---------------------------------------------------------------------------
+// Alpha Engine implementation of the sprite batch backend
+static void		AEBatchDrawTriangles(unsigned int Shape, const SpriteVertex *pVertices, unsigned int TriangleNum);
 
-typedef struct
+static const SpriteBatchBackend sgAEBatchBackend =
 {
-	unsigned int			mMapCollisionFlag;	// Bitfield, where each bit represents 1 side of the object
-
-	GameObjectInstance *	mpOwner;			// This component's owner
-}Component_CollisionWithMap;
-
-// ---------------------------------------------------------------------------
+	AEBatchDrawTriangles
+};
 
-//Game object instance structure
-struct GameObjectInstance
+static const SimBackend sgAEBackend =
 {
-	unsigned long				mFlag;						// Bit mFlag, used to indicate if the object instance is active or not
-
-	Component_Sprite			*mpComponent_Sprite;		// Sprite component
-	Component_Transform			*mpComponent_Transform;		// Transform component
-	Component_Physics			*mpComponent_Physics;		// Physics component
-	Component_AI				*mpComponent_AI;			// AI, used by the enemy instances
-	Component_CollisionWithMap	*mpComponent_MapCollision;	// Used by object instances that collides with the map
+	AEBackendGetFrameTime,
+	AEBackendCheckInputCurr,
+	AEBackendCheckInputTriggered,
+	0
 };
 
 // ---------------------------------------------------------------------------
 
-// List of original vertex buffers
-static Shape				sgShapes[SHAPE_NUM_MAX];									// Each element in this array represents a unique shape 
-static unsigned long		sgShapeNum;													// The number of defined shapes
-
-// list of object instances
-static GameObjectInstance		sgGameObjectInstanceList[GAME_OBJ_INST_NUM_MAX];		// Each element in this array represents a unique game object instance
-static unsigned long			sgGameObjectInstanceNum;								// The number of active game object instances
-
-
-// functions to create/destroy a game object instance
-static GameObjectInstance*		GameObjectInstanceCreate(unsigned int ObjectType);		// From OBJECT_TYPE enum
-static void						GameObjectInstanceDestroy(GameObjectInstance* pInst);
-
-// ---------------------------------------------------------------------------
-
-
-
-
-/////////////////////////////////////////////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////////////
-// TO DO 1:
-// -- Import these functions from part 1
-/////////////////////////////////////////////////////////////////////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////////////
-//Binary map data
-static int **MapData;
-static int **BinaryCollisionArray;
-static int BINARY_MAP_WIDTH;
-static int BINARY_MAP_HEIGHT;
-int GetCellValue(unsigned int X, unsigned int Y);
-int CheckInstanceBinaryMapCollision(float PosX, float PosY, float scaleX, float scaleY);
-float SnapToCell(float *Coordinate);
-int ImportMapDataFromFile(char *FileName);
-void FreeMapData(void);
-
-
-static Matrix2D sgMapTransform;
 
-
-//Collision flags
-#define	COLLISION_LEFT		0x00000001	//0001
-#define	COLLISION_RIGHT		0x00000002	//0010
-#define	COLLISION_TOP		0x00000004	//0100
-#define	COLLISION_BOTTOM	0x00000008	//1000
-
-
-// functions to create/destroy a game object instance
-static GameObjectInstance*			GameObjectInstanceCreate(unsigned int ObjectType);			// From OBJECT_TYPE enum
-static void							GameObjectInstanceDestroy(GameObjectInstance* pInst);
-
-// ---------------------------------------------------------------------------
-
-// Functions to add/remove components
-static void AddComponent_Transform(GameObjectInstance *pInst, Vector2D *pPosition, float Angle, float ScaleX, float ScaleY);
-static void AddComponent_Sprite(GameObjectInstance *pInst, unsigned int ShapeType);
-static void AddComponent_Physics(GameObjectInstance *pInst, Vector2D *pVelocity);
-static void AddComponent_AI(GameObjectInstance *pInst, double Counter, enum STATE State, enum INNER_STATE InnerState);
-static void AddComponent_MapCollision(GameObjectInstance *pInst);
-
-static void RemoveComponent_Transform(GameObjectInstance *pInst);
-static void RemoveComponent_Sprite(GameObjectInstance *pInst);
-static void RemoveComponent_Physics(GameObjectInstance *pInst);
-static void RemoveComponent_AI(GameObjectInstance *pInst);
-static void RemoveComponent_MapCollision(GameObjectInstance *pInst);
-
-// ---------------------------------------------------------------------------
-
-//We need a pointer to the hero's instance for input purposes
-static GameObjectInstance *sgpHero;
-
-//State machine functions
-void EnemyStateMachine(GameObjectInstance *pInst);//, float frametime);
-
-
-void GameStatePlatformLoad(void)
+int GameStatePlatformLoadData(World *pWorld)
 {
-	// Used for the cicle shape
-	float circleAngleStep, i;
-	int parts;
-	Shape* pShape;
-
-	circleAngleStep = 0.0f;
-	i = 0.0f;
-	parts = 0;
-	pShape = NULL;
-
-	// Zero the shapes array
-	memset(sgShapes, 0, sizeof(Shape)* SHAPE_NUM_MAX);
-	// No shapes at this point
-	sgShapeNum = 0;
-
-	//Creating the black object
-	pShape = sgShapes + sgShapeNum++;
-	pShape->mType = OBJECT_TYPE_MAP_CELL_EMPTY;
-
-	AEGfxMeshStart();
-
-	//1st argument: X
-	//2nd argument: Y
-	//3rd argument: ARGB
-	AEGfxTriAdd(
-		-0.5f, -0.5f, 0xFF000000, 0.0f, 0.0f,
-		 0.5f,  -0.5f, 0xFF000000, 0.0f, 0.0f, 
-		-0.5f,  0.5f, 0xFF000000, 0.0f, 0.0f);
-	
-	AEGfxTriAdd(
-		-0.5f, 0.5f, 0xFF000000, 0.0f, 0.0f, 
-		 0.5f,  -0.5f, 0xFF000000, 0.0f, 0.0f, 
-		0.5f,  0.5f, 0xFF000000, 0.0f, 0.0f);
-
-	pShape->mpMesh = AEGfxMeshEnd();
-
-	
-	//Creating the white object
-	pShape = sgShapes + sgShapeNum++;
-	pShape->mType = OBJECT_TYPE_MAP_CELL_COLLISION;
-
-	AEGfxMeshStart();
-
-	//1st argument: X
-	//2nd argument: Y
-	//3rd argument: ARGB
-	AEGfxTriAdd(
-		-0.5f, -0.5f, 0xFFFFFFFF, 0.0f, 0.0f, 
-		 0.5f,  -0.5f, 0xFFFFFFFF, 0.0f, 0.0f, 
-		-0.5f,  0.5f, 0xFFFFFFFF, 0.0f, 0.0f);
-	
-	AEGfxTriAdd(
-		-0.5f, 0.5f, 0xFFFFFFFF, 0.0f, 0.0f, 
-		 0.5f,  -0.5f, 0xFFFFFFFF, 0.0f, 0.0f, 
-		0.5f,  0.5f, 0xFFFFFFFF, 0.0f, 0.0f);
-
-	pShape->mpMesh = AEGfxMeshEnd();
-
-	
-	//Creating the hero object
-	pShape = sgShapes + sgShapeNum++;
-	pShape->mType = OBJECT_TYPE_HERO;
-
-	AEGfxMeshStart();
-
-	//1st argument: X
-	//2nd argument: Y
-	//3rd argument: ARGB
-	AEGfxTriAdd(
-		-0.5f, -0.5f, 0xFF0000FF, 0.0f, 0.0f, 
-		 0.5f,  -0.5f, 0xFF0000FF, 0.0f, 0.0f, 
-		-0.5f,  0.5f, 0xFF0000FF, 0.0f, 0.0f);
-	
-	AEGfxTriAdd(
-		-0.5f, 0.5f, 0xFF0000FF, 0.0f, 0.0f, 
-		 0.5f,  -0.5f, 0xFF0000FF, 0.0f, 0.0f, 
-		0.5f,  0.5f, 0xFF0000FF, 0.0f, 0.0f);
-
-	pShape->mpMesh = AEGfxMeshEnd();
-
-
-	//Creating the enemey1 object
-	pShape = sgShapes + sgShapeNum++;
-	pShape->mType = OBJECT_TYPE_ENEMY1;
-
-	AEGfxMeshStart();
-
-	//1st argument: X
-	//2nd argument: Y
-	//3rd argument: ARGB
-	AEGfxTriAdd(
-		-0.5f, -0.5f, 0xFFFF0000, 0.0f, 0.0f, 
-		 0.5f,  -0.5f, 0xFFFF0000, 0.0f, 0.0f, 
-		-0.5f,  0.5f, 0xFFFF0000, 0.0f, 0.0f);
-	
-	AEGfxTriAdd(
-		-0.5f, 0.5f, 0xFFFF0000, 0.0f, 0.0f, 
-		 0.5f,  -0.5f, 0xFFFF0000, 0.0f, 0.0f, 
-		0.5f,  0.5f, 0xFFFF0000, 0.0f, 0.0f);
-
-	pShape->mpMesh = AEGfxMeshEnd();
-
-
-	//Creating the Coin object
-	pShape = sgShapes + sgShapeNum++;
-	pShape->mType = OBJECT_TYPE_COIN;
-
-	AEGfxMeshStart();
-
-	//1st argument: X
-	//2nd argument: Y
-	//3rd argument: ARGB
-
-	//Creating the circle shape
-	parts = 12;
-	circleAngleStep = PI / parts; 
-	for (i = 0; i < parts; ++i)
-	{
-		AEGfxTriAdd(
-			0.0f, 0.0f, 0xFFFFFF00, 0.0f, 0.0f,
-			cosf(i * 2 * circleAngleStep) *0.5f, sinf(i * 2 * circleAngleStep) *0.5f, 0xFFFFFF00, 0.0f, 0.0f,
-			cosf((i + 1) * 2 * circleAngleStep) *0.5f, sinf((i + 1) * 2 * circleAngleStep) *0.5f, 0xFFFFFF00, 0.0f, 0.0f);
-	}
-
-	pShape->mpMesh = AEGfxMeshEnd();
-
-	pShape = sgShapes + sgShapeNum++;
-	pShape->mType = PARTICLE_TYPE_JUMP_EFFECT;
-
-	AEGfxMeshStart();
-
-	/*	AEGfxTriAdd(
-		-0.5f, -0.5f, 0xFF0000FF, 0.0f, 0.0f, 
-		 0.5f,  -0.5f, 0xFF0000FF, 0.0f, 0.0f, 
-		-0.5f,  0.5f, 0xFF0000FF, 0.0f, 0.0f);
-		Raw blue triangle
-		*/
-	AEGfxTriAdd(
-		-0.5f, -0.5f, 0xFFFF00FF, 0.0f, 0.0f,
-		0.5f, -0.5f, 0xFFFF00FF, 0.0f, 0.0f,
-		-0.5f, 0.5f, 0xFFFF00FF, 0.0f, 0.0f);  //Purple triangle
-
-	pShape->mpMesh = AEGfxMeshEnd();
-
-	pShape = sgShapes + sgShapeNum++;
-	pShape->mType = PARTICLE_TYPE_ENEMY_BURN;  //Orange triangle, have them shimmer and float up for a short time when enemy isn't moving, then poof
-	  AEGfxMeshStart();
-	  AEGfxTriAdd(
-		  -0.5f, -0.5f, 0xFFFFA500, 0.0f, 0.0f,
-		  0.5f, -0.5f, 0xFFFFA500, 0.0f, 0.0f,
-		  -0.5f, 0.5f, 0xFFFFA500, 0.0f, 0.0f);
-
-	  pShape->mpMesh = AEGfxMeshEnd();
-
-
-	//Setting intital binary map values
-	MapData = 0;
-	BinaryCollisionArray = 0;
-	BINARY_MAP_WIDTH = 0;
-	BINARY_MAP_HEIGHT = 0;
-
 	//Importing Data
-	if(!ImportMapDataFromFile("Exported.txt"))
+	return SimLoad(pWorld, "Exported.txt");
+}
+
+// The map was imported by GameStatePlatformLoadData
+void GameStatePlatformLoad(World *pWorld)
+{
+	if(!TileMapRenderBuild(SimGetMap(pWorld)) || !PlatformerRenderInit(&sgAEBatchBackend) || !RenderPacketQueueInit(&sgPackets, GAME_OBJ_INST_NUM_MAX + PARTICLE_NUM_MAX))
 		gGameStateNext = GS_QUIT;
 
-	
 
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////////////////////////
 	// TO DO 3:
 	// -- Implement the map transform matrix
-	//    A map translation and a scale are required. 
+	//    A map translation and a scale are required.
 	// -- Store the just computed map transformation in "sgMapTransform"
 	/////////////////////////////////////////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////////////////////////
-	Matrix2D* t = malloc(sizeof(Matrix2D)); 
-	Matrix2D* s = malloc(sizeof(Matrix2D));
-
-	Matrix2DIdentity(t);
-	Matrix2DIdentity(s);
+	// Only a scale: the camera does the scrolling, so the instances' cached world
+	// transformations stay valid while it moves
+	Matrix2DScale(&sgMapTransform, SCREEN_X_SCALE, SCREEN_Y_SCALE);
+	Affine2DFromMatrix2D(&sgMapAffine, &sgMapTransform);
+	SimSetWorldTransform(pWorld, &sgMapAffine);
 
-	Matrix2DTranslate(t, BINARY_MAP_WIDTH / -2.f*SCREEN_X_SCALE, BINARY_MAP_HEIGHT / -2.f*SCREEN_Y_SCALE);
-	Matrix2DScale(s, SCREEN_X_SCALE, SCREEN_Y_SCALE);
-
-	Matrix2DConcat(&sgMapTransform, t, s);
+	// Cell (x;y) covers [x, x + 1] x [y, y + 1]
+	CameraInit(&sgCamera, AEGfxGetWinMaxX() - AEGfxGetWinMinX(), AEGfxGetWinMaxY() - AEGfxGetWinMinY(), SCREEN_X_SCALE);
+	CameraSetBounds(&sgCamera, 0.f, 0.f, (float)GetMapWidth(SimGetMap(pWorld)), (float)GetMapHeight(SimGetMap(pWorld)));
+	CameraSetDeadZone(&sgCamera, CAMERA_DEAD_ZONE_HALF_WIDTH, CAMERA_DEAD_ZONE_HALF_HEIGHT);
+	CameraSetLookAhead(&sgCamera, CAMERA_LOOK_AHEAD_DISTANCE, CAMERA_LOOK_AHEAD_SPEED);
 }
 
-void GameStatePlatformInit(void)
+void GameStatePlatformInit(World *pWorld)
 {
-	int i, j;
-
-	// zero the game object instance array
-	memset(sgGameObjectInstanceList, 0, sizeof(GameObjectInstance)* GAME_OBJ_INST_NUM_MAX);
-	// No game object instances (sprites) at this point
-	sgGameObjectInstanceNum = 0;
-
-	i = j = 0;
-	sgpHero = 0;
-	TotalCoins = 0;
-
-	//Setting the inital number of hero lives
-	HeroLives = HERO_LIVES;
-
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	// TO DO 2:
-	// -- Create the map tiles.
-	//    Loop through the loaded map array, and create a black instance (non collision) or white 
-	//    instance (collision).
-	// -- Create the objects instances (Hero, enemies & coins).
-	// -- If implemented correctly, you should see the map and instances. (They'll be really small at
-	//    this point
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	// Creating the map, the main character, the enemies and the coins according to their initial positions in MapData
-
-	/***********
-	Loop through all the array elements of MapData (which was initialized in the "GameStatePlatformLoad" function
-	from the .txt file
-
-		 - Create a white or black cell
-
-		 - if the element represents the hero
-			Create a hero instance
-			Set its position depending on its array indices in MapData
-			Save its array indices in Hero_Initial_X and Hero_Initial_Y (Used when the hero dies and its position needs to be reset)
-
-		 - if the element represents an enemy
-			Create an enemy instance
-			Set its position depending on its array indices in MapData
-
-		 - if the element represents a coin
-			Create a coin instance
-			Set its position depending on its array indices in MapData
-
-
-			//Coin = yellow/gold
-			//Enemy = red
-			//Ground = white
-			//Player = blue
-			//Empty = black
-
-
-
-	***********/
-	GameObjectInstance* pCurr;
-
-	for (i = 0; i < BINARY_MAP_WIDTH; ++i)
-	{
-		for (j = 0; j < BINARY_MAP_HEIGHT; ++j)
-		{
-			if (BinaryCollisionArray[i][j] == 1)
-			{
-				pCurr = GameObjectInstanceCreate(OBJECT_TYPE_MAP_CELL_COLLISION);
-
-			}
-
-			else {
-				pCurr = GameObjectInstanceCreate(OBJECT_TYPE_MAP_CELL_EMPTY);
-			}
-
-			pCurr->mpComponent_Transform->mPosition.x = i + 0.5f;
-			pCurr->mpComponent_Transform->mPosition.y = j + 0.5f;
-		}
-	}
-	pCurr = NULL;
-
-	for(int x=0;x<BINARY_MAP_WIDTH;x++)
-	{
-		for(int y=0;y<BINARY_MAP_HEIGHT;y++)
-			{
-				
-
-
-				if (MapData[x][y] == OBJECT_TYPE_HERO)
-				{
-					pCurr = GameObjectInstanceCreate(OBJECT_TYPE_HERO);
-					sgpHero = pCurr;
-					Hero_Initial_X = x;
-					Hero_Initial_Y = y;
-					pCurr->mpComponent_Transform->mPosition.x = x + 0.5f;
-					pCurr->mpComponent_Transform->mPosition.y = y + 0.5f;
-					pCurr->mpComponent_MapCollision->mMapCollisionFlag = 0;
-				}
-
-				else if (MapData[x][y] == OBJECT_TYPE_ENEMY1)
-				{
-					pCurr = GameObjectInstanceCreate(OBJECT_TYPE_ENEMY1);
-					pCurr->mpComponent_Transform->mPosition.x = x + 0.5f;
-					pCurr->mpComponent_Transform->mPosition.y = y + 0.5f;
-					pCurr->mpComponent_MapCollision->mMapCollisionFlag = 0;
-				}
-
-				else if (MapData[x][y] == OBJECT_TYPE_COIN)
-				{
-					pCurr = GameObjectInstanceCreate(OBJECT_TYPE_COIN);
-					pCurr->mpComponent_Transform->mPosition.x = x + 0.5f;
-					pCurr->mpComponent_Transform->mPosition.y = y + 0.5f;
-					pCurr->mpComponent_MapCollision->mMapCollisionFlag = 0;
-				}
-
-			}
-
-
-		}
-	
-
-	pCurr = NULL;
+	SimSetBackend(pWorld, &sgAEBackend);
+	SimInit(pWorld);
+	StartPlay(pWorld);
 }
-void GameStatePlatformUpdate(void)
-{
-	int i, j;
-	float winMaxX, winMaxY, winMinX, winMinY;
-	double frameTime;
-	
-	i = j = 0;
-	winMaxX = winMaxY = winMinX = winMinY = 0.0f;
-	// ==========================================================================================
-	// Getting the window's world edges (These changes whenever the camera moves or zooms in/out)
-	// ==========================================================================================
-	winMaxX = AEGfxGetWinMaxX();
-	winMaxY = AEGfxGetWinMaxY();
-	winMinX = AEGfxGetWinMinX();
-	winMinY = AEGfxGetWinMinY();
-
-
-	// ======================
-	// Getting the frame time
-	// ======================
-
-	frameTime = AEFrameRateControllerGetFrameTime();
-
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	// TO DO 8:
-	// Control the hero's movement:
-	// -- If Left/Right are pressed: Set the hero velocity's X coordinate to -/+ MOVE_VELOCITY_HERO.
-	//    Set it to 0 when neither are pressed.
-	// -- If SPACE is pressed AND the hero is on a platform: Jump. Use "JUMP_VELOCITY" as the upward
-	//    jump velocity.
-	// -- You should be able to move the main character and make it jump.
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	  
-
-	//INPUT CHECK HERE
-	if (AEInputCheckCurr(VK_LEFT))
-	{
-		sgpHero->mpComponent_Physics->mVelocity.x = -1* MOVE_VELOCITY_HERO;
-	}
-	else if (AEInputCheckCurr(VK_RIGHT))
-	{
-		sgpHero->mpComponent_Physics->mVelocity.x = MOVE_VELOCITY_HERO;
-	} 
-	else
-	{
-		sgpHero->mpComponent_Physics->mVelocity.x = 0.f;
-	}
-
-	 //int test = CheckInstanceBinaryMapCollision(sgpHero->mpComponent_Transform->mPosition.x, sgpHero->mpComponent_Transform->mPosition.y, 1, 1);
-
-	//sgpHero->mpComponent_MapCollision->mMapCollisionFlag = 0;
-
-	
-	//sgpHero->mpComponent_MapCollision->mMapCollisionFlag = CheckInstanceBinaryMapCollision(sgpHero->mpComponent_Transform->mPosition.x, sgpHero->mpComponent_Transform->mPosition.y, 1, 1);// sgpHero->mpComponent_Transform->mScaleX, sgpHero->mpComponent_Transform->mScaleY);
-
-	if (AEInputCheckTriggered(VK_SPACE) && COLLISION_BOTTOM==(sgpHero->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_BOTTOM) )// (sgpHero->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_BOTTOM) ==COLLISION_BOTTOM)
-	{
-		sgpHero->mpComponent_Physics->mVelocity.y = JUMP_VELOCITY;
-	
-	//Spawn 10-15 particles that shoot out from player in random dir. upon jumping
-		GameObjectInstance* pInst;
-		int numParticles = 10 + rand() % 5;
-		for (int i = 0; i < numParticles; i++)
-		{
-			 pInst = GameObjectInstanceCreate(PARTICLE_TYPE_JUMP_EFFECT);
-			 pInst->mpComponent_Transform->mPosition.x = sgpHero->mpComponent_Transform->mPosition.x;
-			 pInst->mpComponent_Transform->mPosition.y = sgpHero->mpComponent_Transform->mPosition.y;
-			 float angle = (180.f + rand() % 180)* PI / 180.f;  //Convert to radians
-			 pInst->mpComponent_Physics->mVelocity.x = cosf(angle); 
-			 pInst->mpComponent_Physics->mVelocity.y = sinf(angle);
-		}
-	
-	}
-
-	//sgpHero->mpComponent_MapCollision->mMapCollisionFlag = 0;
-
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	// TO DO 6:
-	// Update the velocity of each active game object instance that has a "Physics" component
-	// -- velocities are updated here (V1.y = GRAVITY*t + V0.y)
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	//Update object instances physics and behavior
-	
-	//PHYSICS - VELOCITY HERE
-	for (i = 0; i < GAME_OBJ_INST_NUM_MAX; ++i)
-	{
-		GameObjectInstance* pInst = sgGameObjectInstanceList + i;
-
-		// skip non-active object
-		if (pInst==NULL ||( 0 ==  pInst->mFlag & FLAG_ACTIVE)  || pInst->mpComponent_Physics == NULL)
-			continue;
-
-		if (pInst->mpComponent_Sprite->mpShape->mType == OBJECT_TYPE_HERO || pInst->mpComponent_Sprite->mpShape->mType == OBJECT_TYPE_ENEMY1 || pInst->mpComponent_Sprite->mpShape->mType == PARTICLE_TYPE_JUMP_EFFECT)
-		{
-			pInst->mpComponent_Physics->mVelocity.y = pInst->mpComponent_Physics->mVelocity.y + GRAVITY * frameTime;
-		}
-
-		else if (pInst->mpComponent_Sprite->mpShape->mType == PARTICLE_TYPE_ENEMY_BURN && pInst->mpComponent_Physics->mVelocity.y <=0)
-		{
-			pInst->mpComponent_Physics->mVelocity.y -= GRAVITY * frameTime / 2.f;
-			pInst->mpComponent_Physics->mVelocity.x += (-1 + rand() % 3) / 30.f;
-		}
-		/*{
-			pInst->mpComponent_MapCollision->mMapCollisionFlag = 0;
-			pInst->mpComponent_MapCollision->mMapCollisionFlag = CheckInstanceBinaryMapCollision(pInst->mpComponent_Transform->mPosition.x, pInst->mpComponent_Transform->mPosition.y, pInst->mpComponent_Transform->mScaleX, pInst->mpComponent_Transform->mScaleY);
-			if (pInst->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_BOTTOM > 0)
-			{
-				pInst->mpComponent_Physics->mVelocity.y = pInst->mpComponent_Physics->mVelocity.y + GRAVITY * frameTime;
-			}
-		}*/
-
-		/////////////////////////////////////////////////////////////////////////////////////////////////
-		/////////////////////////////////////////////////////////////////////////////////////////////////
-		// TO DO 10:
-		// If the object instance is an enemy, update its state machine by calling the "EnemyStateMachine"
-		// function.
-		/////////////////////////////////////////////////////////////////////////////////////////////////
-		/////////////////////////////////////////////////////////////////////////////////////////////////
-
-		if (pInst->mpComponent_Sprite->mpShape->mType == OBJECT_TYPE_ENEMY1)
-		{
-			EnemyStateMachine(pInst);//, frameTime);
-		}
-	
-	}
-
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	// TO DO 5:
-	// Update the positions of all active game object instances
-	// -- Positions are updated here (P1 = V1*t + P0)
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	////////////////////////////////////////////////////////////////////////////////////////////////
-	
-	//PHYSICS - POSITION HERE
-	for (i = 0; i < GAME_OBJ_INST_NUM_MAX; ++i)
-	{
-		GameObjectInstance* pInst = sgGameObjectInstanceList + i;
-
-		// skip non-active object
-		if (pInst == NULL || (0 == pInst->mFlag & FLAG_ACTIVE) || pInst->mpComponent_Physics == NULL)
-			continue;
-
-		if (pInst->mpComponent_Sprite->mpShape->mType == OBJECT_TYPE_HERO || pInst->mpComponent_Sprite->mpShape->mType == OBJECT_TYPE_ENEMY1 || pInst->mpComponent_Sprite->mpShape->mType == PARTICLE_TYPE_ENEMY_BURN || pInst->mpComponent_Sprite->mpShape->mType == PARTICLE_TYPE_JUMP_EFFECT)
-		{
-		//	Vector2DScaleAdd(&(pInst->mpComponent_Transform->mPosition), &(pInst->mpComponent_Physics->mVelocity), &(pInst->mpComponent_Transform->mPosition), frameTime);
-		
-			pInst->mpComponent_Transform->mPosition.x += frameTime* pInst->mpComponent_Physics->mVelocity.x;
-			pInst->mpComponent_Transform->mPosition.y += frameTime* pInst->mpComponent_Physics->mVelocity.y;
-
-		
-		}
-
-		if (pInst->mpComponent_Sprite->mpShape->mType == PARTICLE_TYPE_ENEMY_BURN || pInst->mpComponent_Sprite->mpShape->mType == PARTICLE_TYPE_JUMP_EFFECT)
-		{
-			pInst->mpComponent_AI->mCounter += frameTime;
-			if (pInst->mpComponent_AI->mCounter > PARTICLE_LIFETIME)
-			{
-				GameObjectInstanceDestroy(pInst);
-			}
-		}
-
-		}
-
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	// TO DO 7:
-	// -- Check for collision between active game object instances that have a "Component_CollisionWithMap"
-	//	  component and the map, by calling the CheckInstanceBinaryMapCollision.
-	//    Store the bit field in the instance's Component_CollisionWithMap.
-	// -- In case of an intersection with the map, set the respective velocity coordinate to 0 and snap the 
-	//    respective position coordinate.
-	// -- If implemented correctly, object instances should stop falling down through the platforms.
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	//Check for grid collision
-	for (i = 0; i < GAME_OBJ_INST_NUM_MAX; ++i)
-	{
-		GameObjectInstance* pInst = sgGameObjectInstanceList + i;
-
-		// skip non-active object instances
-		if (pInst==NULL ||( 0 ==  pInst->mFlag & FLAG_ACTIVE)  || pInst->mpComponent_MapCollision == NULL)
-			continue;
-		//MAP COLLISION & CLIPPING HERE
-		if(pInst->mpComponent_Sprite->mpShape->mType != OBJECT_TYPE_MAP_CELL_COLLISION && pInst->mpComponent_Sprite->mpShape->mType != OBJECT_TYPE_MAP_CELL_EMPTY  && pInst->mpComponent_Sprite->mpShape->mType != OBJECT_TYPE_COIN)
-		{
-			pInst->mpComponent_MapCollision->mMapCollisionFlag = 0;
-			pInst->mpComponent_MapCollision->mMapCollisionFlag = CheckInstanceBinaryMapCollision(pInst->mpComponent_Transform->mPosition.x, pInst->mpComponent_Transform->mPosition.y, pInst->mpComponent_Transform->mScaleX, pInst->mpComponent_Transform->mScaleY);
-
-	/*		if (pInst->mpComponent_Sprite->mpShape->mType == OBJECT_TYPE_HERO)
-			{
-				int x;
-				x = 2;
-			}*/
-
-			if ((pInst->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_LEFT))// == COLLISION_LEFT)// || if(pInst->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_RIGHT >0)
-			{
-			//	if (pInst->mpComponent_Physics->mVelocity.x < 0)
-			//	{
-					pInst->mpComponent_Physics->mVelocity.x = 0.f;
-				//}
-				//pInst->mpComponent_Transform->mPosition.x =
-				//pInst->mpComponent_Transform->mPosition.x += 0.5f;
-				pInst->mpComponent_Transform->mPosition.x= SnapToCell(&(pInst->mpComponent_Transform->mPosition.x));
-				
-			}
-
-			if ((pInst->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_RIGHT))// == COLLISION_RIGHT)
-			{
-
-				//if (pInst->mpComponent_Physics->mVelocity.x > 0)
-				//{
-					pInst->mpComponent_Physics->mVelocity.x = 0.f;
-				//}
-				//pInst->mpComponent_Physics->mVelocity.x = 0.f;
-				//pInst->mpComponent_Transform->mPosition.x =
-				//pInst->mpComponent_Transform->mPosition.x -= 0.5f;
-				pInst->mpComponent_Transform->mPosition.x = SnapToCell(&(pInst->mpComponent_Transform->mPosition.x));
-				
-			}
-
-			if ((pInst->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_TOP))// == COLLISION_TOP)// || )
-			{
-				//if (pInst->mpComponent_Physics->mVelocity.y>0)// < 0)
-				//{
-					pInst->mpComponent_Physics->mVelocity.y = 0.f;
-				//}
-				//pInst->mpComponent_Physics->mVelocity.y = 0.f;
-				pInst->mpComponent_Transform->mPosition.y=SnapToCell(&(pInst->mpComponent_Transform->mPosition.y));
-			}
-
-			if((pInst->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_BOTTOM))// == COLLISION_BOTTOM)
-			{
-			//	if (pInst->mpComponent_Physics->mVelocity.y < 0)
-			//	{
-					pInst->mpComponent_Physics->mVelocity.y = 0.f;
-			//	}
-				//pInst->mpComponent_Physics->mVelocity.y = 0.f;
-				pInst->mpComponent_Transform->mPosition.y = SnapToCell(&(pInst->mpComponent_Transform->mPosition.y));
-			}
-
-			//pInst->mpComponent_MapCollision->mMapCollisionFlag = 0;
-		}
-
-	}
 
+void GameStatePlatformInput(World *pWorld)
+{
+	sgFrameInput[SIM_INPUT_LEFT] = AEInputCheckCurr(VK_LEFT);
+	sgFrameInput[SIM_INPUT_RIGHT] = AEInputCheckCurr(VK_RIGHT);
+	sgFrameInput[SIM_INPUT_JUMP] = AEInputCheckCurr(VK_SPACE);
+}
 
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	// TO DO 11:
-	// -- Check for collision among objects instances.
-	//    Hero-Enemy intersection: Rectangle-Rectangle: The hero's position should be reset to its
-	//		value
-	//    Hero-Coin intersection: Rectangle-Circle: The coin should be deleted.
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	for(i = 0; i < GAME_OBJ_INST_NUM_MAX; ++i)
-	{
-		GameObjectInstance* pInst = sgGameObjectInstanceList + i;
-
-		// skip non-active object instances
-		if (pInst==NULL ||( 0 ==  pInst->mFlag & FLAG_ACTIVE))
-			continue;
-
-		if (pInst->mpComponent_Sprite->mpShape->mType == OBJECT_TYPE_ENEMY1)
-		{
-			if (StaticRectToStaticRect(&(sgpHero->mpComponent_Transform->mPosition), sgpHero->mpComponent_Transform->mScaleX, sgpHero->mpComponent_Transform->mScaleY, &(pInst->mpComponent_Transform->mPosition), pInst->mpComponent_Transform->mScaleX, pInst->mpComponent_Transform->mScaleY))
-			{
-			HeroLives--;
-			Vector2DSet(&(sgpHero->mpComponent_Transform->mPosition), Hero_Initial_X, Hero_Initial_Y);
-
-			}
-		}
-		else if (pInst->mpComponent_Sprite->mpShape->mType == OBJECT_TYPE_COIN)
-		{
-			if (StaticCircleToStaticRectangle(&(pInst->mpComponent_Transform->mPosition), pInst->mpComponent_Transform->mScaleY/3, &(sgpHero->mpComponent_Transform->mPosition), pInst->mpComponent_Transform->mScaleX, sgpHero->mpComponent_Transform->mScaleY))
-			{
-				//NumCoins++
-				//Play 'coin collected' particle effect here
-				GameObjectInstanceDestroy(pInst);
-			}
-
-		}
-	}
+void GameStatePlatformUpdate(World *pWorld)
+{
+	SimUpdate(pWorld);
+	FollowHero(pWorld, 0);
+}
 
-	
-	//Computing the transformation matrices of the game object instances
-	for(i = 0; i < GAME_OBJ_INST_NUM_MAX; ++i)
-	{
-		Matrix2D scale, rot, trans;
-		GameObjectInstance* pInst = sgGameObjectInstanceList + i;
+void GameStatePlatformSnapshot(World *pWorld)
+{
+	RenderPacket *pPacket = RenderPacketQueueBeginWrite(&sgPackets);
+	float minX, minY, maxX, maxY;
+	float prevMinX, prevMinY, prevMaxX, prevMaxY;
 
-		// skip non-active object
-		if (pInst==NULL ||( 0 ==  pInst->mFlag & FLAG_ACTIVE))
-			continue;
+	pPacket->mCamera = sgCamera;
+	pPacket->mAlpha = GameStateMgrGetInterpolation();
 
-		Matrix2DScale(&scale, pInst->mpComponent_Transform->mScaleX, pInst->mpComponent_Transform->mScaleY);
-		Matrix2DRotRad(&rot, pInst->mpComponent_Transform->mAngle);
-		Matrix2DTranslate(&trans, pInst->mpComponent_Transform->mPosition.x, pInst->mpComponent_Transform->mPosition.y);
+	// The view can be anywhere between the camera's last two positions when it is drawn
+	CameraGetVisibleRect(&sgCamera, 0.f, &prevMinX, &prevMinY, &prevMaxX, &prevMaxY);
+	CameraGetVisibleRect(&sgCamera, 1.f, &minX, &minY, &maxX, &maxY);
+	PlatformerRenderCapture(pWorld, pPacket, &sgMapAffine, fminf(minX, prevMinX), fminf(minY, prevMinY), fmaxf(maxX, prevMaxX), fmaxf(maxY, prevMaxY));
 
-		Matrix2DConcat(&pInst->mpComponent_Transform->mTransform, &trans, &rot);
-		Matrix2DConcat(&pInst->mpComponent_Transform->mTransform, &pInst->mpComponent_Transform->mTransform, &scale);
-	}
+	RenderPacketQueuePublish(&sgPackets);
 }
 
-void GameStatePlatformDraw(void)
+void GameStatePlatformDraw(World *pWorld)
 {
 	//Drawing the tile map (the grid)
-	int i, j;
-	Matrix2D cellTranslation, cellFinalTransformation;
-	double frameTime;
+	const RenderPacket *pPacket = RenderPacketQueueAcquire(&sgPackets);
+	float alpha;
+	float minX, minY, maxX, maxY;
+	Matrix2D identity;
+	Affine2D view;
 
-	i = j = 0;
-	Matrix2DIdentity(&cellTranslation);
-	Matrix2DIdentity(&cellFinalTransformation);
+	alpha = pPacket->mAlpha;
 
-	// ======================
-	// Getting the frame time
-	// ======================
-
-	frameTime = AEFrameRateControllerGetFrameTime();
+	// What the window shows, in map space, and where the camera is this frame. The
+	// Alpha Engine applies the camera to everything drawn below
+	CameraGetVisibleRect(&pPacket->mCamera, alpha, &minX, &minY, &maxX, &maxY);
+	CameraGetViewTransform(&pPacket->mCamera, 1.f, alpha, &view);
+	AEGfxSetCamPosition(-view.m[0][2], -view.m[1][2]);
 
 	AEGfxSetRenderMode(AE_GFX_RM_COLOR);
 	AEGfxTextureSet(NULL, 0, 0);
@@ -879,678 +206,133 @@ void GameStatePlatformDraw(void)
 	/////////////////////////////////////////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////////////////////////
 
-	for (i = 0; i < GAME_OBJ_INST_NUM_MAX; i++)
-	{
-		GameObjectInstance* pInst = sgGameObjectInstanceList + i;
-
-		// skip non-active object
-		if (pInst==NULL ||( 0 ==  pInst->mFlag & FLAG_ACTIVE))
-			continue;
-		
-		Matrix2DConcat(&(pInst->mpComponent_Transform->mTransform.m), &sgMapTransform, &(pInst->mpComponent_Transform->mTransform.m));
-		AEGfxSetTransform(pInst->mpComponent_Transform->mTransform.m);
-		
-		AEGfxMeshDraw(pInst->mpComponent_Sprite->mpShape->mpMesh, AE_GFX_MDM_TRIANGLES);
+	// The map: one draw per chunk on screen
+	TileMapRenderDraw(&sgMapTransform, minX, minY, maxX, maxY);
 
-	//	Matrix2DConcat(&sgMapTransform, &sgMapTransform, &(pInst->mpComponent_Transform->mTransform.m));
-	//	Matrix2DConcat(&sgMapTransform, &(pInst->mpComponent_Transform->mTransform), &sgMapTransform);
-
-	}
+	// The sprites: one draw per shape. Their vertices are already in screen space
+	Matrix2DIdentity(&identity);
+	AEGfxSetTransform(identity.m);
+	PlatformerRenderDraw(pPacket, minX, minY, maxX, maxY);
 }
 
-
-void GameStatePlatformFree(void)
+void GameStatePlatformFree(World *pWorld)
 {
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	// TO DO 12:
-	//  -- Destroy all the active game object instances, using the GameObjectInstanceDestroy function.
-	//  -- Reset the number of active game objects instances
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-
-	for (int i = 0; i < GAME_OBJ_INST_NUM_MAX; i++)
-	{
-		GameObjectInstanceDestroy(&(sgGameObjectInstanceList[i]));
-	}
+	SimFree(pWorld);
+}
 
+void GameStatePlatformRestart(World *pWorld)
+{
+	SimRestart(pWorld);
+	StartPlay(pWorld);
 }
 
-void GameStatePlatformUnload(void)
+void GameStatePlatformUnload(World *pWorld)
 {
 	/////////////////////////////////////////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////////////////////////
 	// TO DO 13:
-	// -- Destroy all the shapes, using the AEGfxMeshFree function.
+	// -- Destroy all the shapes, using the "AEGfxMeshFree" function.
 	// -- Free the map data
 	/////////////////////////////////////////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////////////////////////
 
-	for (int i = 0; i < sgShapeNum; i++)
-	{
-		AEGfxMeshFree((sgShapes[i].mpMesh));
-		//free(MapData);
-		//free(BinaryCollisionArray);
-	}
-	FreeMapData();
-}
-
-
-GameObjectInstance* GameObjectInstanceCreate(unsigned int ObjectType)			// From OBJECT_TYPE enum)
-{
-	unsigned long i;
-
-	// loop through the object instance list to find a non-used object instance
-	for (i = 0; i < GAME_OBJ_INST_NUM_MAX; i++)
-	{
-		GameObjectInstance* pInst = sgGameObjectInstanceList + i;
-
-		// Check if current instance is not used
-		if (pInst->mFlag == 0)
-		{
-			// It is not used => use it to create the new instance
-
-			// Active the game object instance
-			pInst->mFlag = FLAG_ACTIVE;
-
-			pInst->mpComponent_Transform = 0;
-			pInst->mpComponent_Sprite = 0;
-			pInst->mpComponent_Physics = 0;
-			pInst->mpComponent_AI = 0;
-
-			// Add the components, based on the object type
-			switch (ObjectType)
-			{
-			case OBJECT_TYPE_MAP_CELL_EMPTY:
-				AddComponent_Sprite(pInst, OBJECT_TYPE_MAP_CELL_EMPTY);
-				AddComponent_Transform(pInst, 0, 0.0f, 1.0f, 1.0f);
-				break;
-
-			case OBJECT_TYPE_MAP_CELL_COLLISION:
-				AddComponent_Sprite(pInst, OBJECT_TYPE_MAP_CELL_COLLISION);
-				AddComponent_Transform(pInst, 0, 0.0f, 1.0f, 1.0f);
-				break;
-
-			case OBJECT_TYPE_HERO:
-				AddComponent_Sprite(pInst, OBJECT_TYPE_HERO);
-				AddComponent_Transform(pInst, 0, 0.0f, 1.0f, 1.0f);
-				AddComponent_Physics(pInst, 0);
-				AddComponent_MapCollision(pInst);
-				break;
-
-			case OBJECT_TYPE_ENEMY1:
-				AddComponent_Sprite(pInst, OBJECT_TYPE_ENEMY1);
-				AddComponent_Transform(pInst, 0, 0.0f, 1.0f, 1.0f);
-				AddComponent_Physics(pInst, 0);
-				AddComponent_AI(pInst, 0, STATE_GOING_LEFT, INNER_STATE_ON_ENTER);
-				AddComponent_MapCollision(pInst);
-				break;
-
-			case OBJECT_TYPE_COIN:
-				AddComponent_Sprite(pInst, OBJECT_TYPE_COIN);
-				AddComponent_Transform(pInst, 0, 0.0f, 1.0f, 1.0f);
-				AddComponent_Physics(pInst, 0);
-				AddComponent_MapCollision(pInst);
-				break;
-			case PARTICLE_TYPE_JUMP_EFFECT:
-				AddComponent_Sprite(pInst, PARTICLE_TYPE_JUMP_EFFECT);
-				AddComponent_Transform(pInst, 0, 0.f, 3.f/SCREEN_X_SCALE, 3.f/SCREEN_Y_SCALE);
-				AddComponent_Physics(pInst, 0);
-				AddComponent_AI(pInst, 0, STATE_NONE, STATE_NONE);
-				break;
-			case PARTICLE_TYPE_ENEMY_BURN:
-				AddComponent_Sprite(pInst, PARTICLE_TYPE_ENEMY_BURN);
-				AddComponent_Transform(pInst, 0, 0.f, 3.f / SCREEN_X_SCALE, 3.f / SCREEN_Y_SCALE);
-				AddComponent_Physics(pInst, 0);
-				AddComponent_AI(pInst, 0, STATE_NONE, STATE_NONE);
-			}
-
-			++sgGameObjectInstanceNum;
-
-			// return the newly created instance
-			return pInst;
-		}
-	}
-
-	// Cannot find empty slot => return 0
-	return 0;
-}
-
-// ---------------------------------------------------------------------------
-
-void GameObjectInstanceDestroy(GameObjectInstance* pInst)
-{
-	// if instance is destroyed before, just return
-	if (pInst->mFlag == 0)
-		return;
-
-	// Zero out the mFlag
-	pInst->mFlag = 0;
-
-	RemoveComponent_Transform(pInst);
-	RemoveComponent_Sprite(pInst);
-	RemoveComponent_Physics(pInst);
-	RemoveComponent_AI(pInst);
-	RemoveComponent_MapCollision(pInst);
-
-	--sgGameObjectInstanceNum;
+	RenderPacketQueueFree(&sgPackets);
+	PlatformerRenderFree();
+	TileMapRenderFree();
+	SimUnload(pWorld);
 }
 
 // ---------------------------------------------------------------------------
 
-void AddComponent_Transform(GameObjectInstance *pInst, Vector2D *pPosition, float Angle, float ScaleX, float ScaleY)
+double AEBackendGetFrameTime(void *pContext)
 {
-	if (0 != pInst)
-	{
-		if (0 == pInst->mpComponent_Transform)
-		{
-			pInst->mpComponent_Transform = (Component_Transform *)calloc(1, sizeof(Component_Transform));
-		}
-
-		Vector2D zeroVec2;
-		Vector2DZero(&zeroVec2);
-
-		pInst->mpComponent_Transform->mScaleX = ScaleX;
-		pInst->mpComponent_Transform->mScaleY = ScaleY;
-		pInst->mpComponent_Transform->mPosition = pPosition ? *pPosition : zeroVec2;;
-		pInst->mpComponent_Transform->mAngle = Angle;
-		pInst->mpComponent_Transform->mpOwner = pInst;
-	}
+	return GameStateMgrGetUpdateTime();
 }
 
 // ---------------------------------------------------------------------------
 
-void AddComponent_Sprite(GameObjectInstance *pInst, unsigned int ShapeType)
+// The copy made by GameStatePlatformInput: the Alpha Engine is not called from the
+// updates, which can run on another thread
+int AEBackendCheckInputCurr(void *pContext, unsigned int Input)
 {
-	if (0 != pInst)
-	{
-		if (0 == pInst->mpComponent_Sprite)
-		{
-			pInst->mpComponent_Sprite = (Component_Sprite *)calloc(1, sizeof(Component_Sprite));
-		}
-
-		pInst->mpComponent_Sprite->mpShape = sgShapes + ShapeType;
-		pInst->mpComponent_Sprite->mpOwner = pInst;
-	}
+	return Input < SIM_INPUT_NUM ? sgFrameInput[Input] : 0;
 }
 
 // ---------------------------------------------------------------------------
 
-void AddComponent_Physics(GameObjectInstance *pInst, Vector2D *pVelocity)
+// With a fixed time step a frame can run several updates or none, so "triggered"
+// is relative to the previous update rather than to the previous frame.
+// The simulation asks once per update for each input it checks
+int AEBackendCheckInputTriggered(void *pContext, unsigned int Input)
 {
-	if (0 != pInst)
-	{
-		if (0 == pInst->mpComponent_Physics)
-		{
-			pInst->mpComponent_Physics = (Component_Physics *)calloc(1, sizeof(Component_Physics));
-		}
-
-		Vector2D zeroVec2;
-		Vector2DZero(&zeroVec2);
-
-		pInst->mpComponent_Physics->mVelocity = pVelocity ? *pVelocity : zeroVec2;
-		pInst->mpComponent_Physics->mpOwner = pInst;
-	}
-}
-
-// ---------------------------------------------------------------------------
-
-void AddComponent_AI(GameObjectInstance *pInst, double Counter, enum STATE State, enum INNER_STATE InnerState)
-{
-	if (0 != pInst)
-	{
-		if (0 == pInst->mpComponent_AI)
-		{
-			pInst->mpComponent_AI = (Component_AI *)calloc(1, sizeof(Component_AI));
-		}
-
-		pInst->mpComponent_AI->mCounter = Counter;
-		pInst->mpComponent_AI->mState = State;
-		pInst->mpComponent_AI->mInnerState = InnerState;
-		pInst->mpComponent_AI->mpOwner = pInst;
-	}
-}
-
-// ---------------------------------------------------------------------------
-
-void AddComponent_MapCollision(GameObjectInstance *pInst)
-{
-	if (0 != pInst)
-	{
-		if (0 == pInst->mpComponent_MapCollision)
-		{
-			pInst->mpComponent_MapCollision = (Component_CollisionWithMap *)calloc(1, sizeof(Component_CollisionWithMap));
-		}
+	int curr, triggered;
 
-		pInst->mpComponent_MapCollision->mMapCollisionFlag = 0;
-	}
-}
+	if (Input >= SIM_INPUT_NUM)
+		return 0;
 
-// ---------------------------------------------------------------------------
+	curr = AEBackendCheckInputCurr(pContext, Input);
+	triggered = curr && !sgPrevUpdateInput[Input];
+	sgPrevUpdateInput[Input] = curr;
 
-void RemoveComponent_Transform(GameObjectInstance *pInst)
-{
-	if (0 != pInst)
-	{
-		if (0 != pInst->mpComponent_Transform)
-		{
-			free(pInst->mpComponent_Transform);
-			pInst->mpComponent_Transform = 0;
-		}
-	}
+	return triggered;
 }
 
 // ---------------------------------------------------------------------------
 
-void RemoveComponent_Sprite(GameObjectInstance *pInst)
+// What Init and Restart do once the level is set up: the input copies start
+// released, and the camera on the hero
+void StartPlay(World *pWorld)
 {
-	if (0 != pInst)
-	{
-		if (0 != pInst->mpComponent_Sprite)
-		{
-			free(pInst->mpComponent_Sprite);
-			pInst->mpComponent_Sprite = 0;
-		}
-	}
-}
+	memset(sgFrameInput, 0, sizeof(sgFrameInput));
+	memset(sgPrevUpdateInput, 0, sizeof(sgPrevUpdateInput));
 
-// ---------------------------------------------------------------------------
+	FollowHero(pWorld, 1);
 
-void RemoveComponent_Physics(GameObjectInstance *pInst)
-{
-	if (0 != pInst)
-	{
-		if (0 != pInst->mpComponent_Physics)
-		{
-			free(pInst->mpComponent_Physics);
-			pInst->mpComponent_Physics = 0;
-		}
-	}
-}
-
-// ---------------------------------------------------------------------------
-
-void RemoveComponent_AI(GameObjectInstance *pInst)
-{
-	if (0 != pInst)
-	{
-		if (0 != pInst->mpComponent_AI)
-		{
-			free(pInst->mpComponent_AI);
-			pInst->mpComponent_AI = 0;
-		}
-	}
+	// The first frame is drawn before any update
+	GameStatePlatformSnapshot(pWorld);
 }
 
 // ---------------------------------------------------------------------------
 
-void RemoveComponent_MapCollision(GameObjectInstance *pInst)
+// Moves the camera after the hero, or centers it on the hero when "Snap" is set
+void FollowHero(World *pWorld, int Snap)
 {
-	if (0 != pInst)
-	{
-		if (0 != pInst->mpComponent_MapCollision)
-		{
-			free(pInst->mpComponent_MapCollision);
-			pInst->mpComponent_MapCollision = 0;
-		}
-	}
-}
-
-// ---------------------------------------------------------------------------
-
-// ---------------------------------------------------------------------------
-
-int GetCellValue( int X, int Y)
-{
-	//return 0;
-
-	if (X < 0 || Y < 0 || X >= BINARY_MAP_HEIGHT || Y >= BINARY_MAP_WIDTH)
-	{
-		return 0;
-	}
-
-	else
-	{
-		return BinaryCollisionArray[X][Y];
-	}
-}
-
- int CheckInstanceBinaryMapCollision(float PosX, float PosY, float scaleX, float scaleY)
-{
-	//return 0;
-	float length2 = scaleY / 2.f;
-	float length4 = length2 / 2.f;
-	float width2 = scaleX / 2.f;
-	float width4 = width2 / 2.f;
-
-	int topLeftX = (PosX - width4);
-	int topLeftY = (PosY + length2);
-
-	int topRightX = (PosX + width4);
-	int topRightY = (PosY + length2);
-
-	int leftTopX = (PosX - width2);
-	int leftTopY = (PosY + length4);
-
-	int leftBotX = (PosX - width2);
-	int leftBotY = (PosY - length4);
-
-	int botLeftX = (PosX - width4); //15.25
-	int botLeftY = (PosY - length2); //3.0
-
-	int botRightX = (PosX + width4);//15.75
-	int botRightY = (PosY - length2);//3.0
-
-	int rightTopX = (PosX + width2);
-	int rightTopY = (PosY + length4);
-
-	int rightBotX = (PosX + width2);
-	int rightBotY = (PosY - length4);
+	GameObjectInstance *pHero = SimGetHero(pWorld);
+	Component_Transform *pTransform;
 
-	int flag = 0;
-
-	//Assuming that we're only checking the points on each side for its respective collision vs. dividing into quadrants
-	if ((GetCellValue(topLeftX, topLeftY)==1) || (GetCellValue(topRightX, topRightY)) ==1 )  //Might need to change these to explicitly check for 1 for both
-	{
-		flag |= COLLISION_TOP;
-	}
-
-	if ((GetCellValue(rightTopX, rightTopY)==1) || (GetCellValue(rightBotX, rightBotY)) ==1)
-	{
-		flag |= COLLISION_RIGHT;
-	}
-
-	if ((GetCellValue(leftTopX, leftTopY)==1) || (GetCellValue(leftBotX, leftBotY)) ==1)
-	{
-		flag |= COLLISION_LEFT;
-	}
-
-	if ((GetCellValue(botLeftX, botLeftY)==1) || (GetCellValue(botRightX, botRightY)) ==1)
-	{
-		flag |= COLLISION_BOTTOM;
-	}
-
-	return flag;
-	
-	/*
-	int FLAG = 0;
-	//return 0;
-
-	//Top right, right side
-	int xTRR = PosX + .5*scaleX;
-	int yTRR = PosY + .25*scaleY;
-
-	//Top right, top side
-	int xTRT = PosX + .25*scaleX;
-	int yTRT = PosY + .5*scaleY;
-
-	//Bottom right, right side
-	int xBRR = PosX + .5*scaleX;
-	int yBRR = PosY - .25*scaleY;
-
-	//Bottom right, bottom side
-	int xBRB = PosX + .25*scaleX;
-	int yBRB = PosY - .5*scaleY;
-
-	//Bottom left, bottom side
-	int xBLB = PosX - .25*scaleX;
-	int yBLB = PosY - .5*scaleY;
-
-	//Bottom left, left side
-	int xBLL = PosX - .5*scaleX;
-	int yBLL = PosY - .25*scaleY;
-
-	//Top left, left side
-	int xTLL = PosX - .5*scaleX;
-	int yTLL = PosY + .25*scaleY;
-
-	//Top left, top side
-	int xTLT = PosX - .25*scaleX;
-	int yTLT = PosY + .5*scaleY;
-
-
-	if (1 == GetCellValue(xTRR, yTRR) || (1 == GetCellValue(xBRR, yBRR)))
-	{
-		FLAG = FLAG | COLLISION_RIGHT;
-	}
-
-	if (1 == GetCellValue(xTRT, yTRT) || (1 == GetCellValue(xTLT, yTLT)))
-	{
-		FLAG = FLAG | COLLISION_TOP;
-	}
-	if (1 == GetCellValue(xBRB, yBRB) || (1 == GetCellValue(xBLB, yBLB)))
-	{
-		FLAG = FLAG | COLLISION_BOTTOM;
-	}
-	if (1 == GetCellValue(xTLL, yTLL) || (1 == GetCellValue(xBLL, yBLL)))
-	{
-		FLAG = FLAG | COLLISION_LEFT;
-	}
-
-	return FLAG;
-	*/
-
-}
-
-float SnapToCell(float *Coordinate)  //Would need to add a scale factor to this to make it work for non-unit-sized objects
-{
-	float fl = ((int)(*Coordinate)) + 0.5f;
-	//int c = (int)(*Coordinate);
-	//(*Coordinate) = fl;
-	return fl;
-
-}
+	if (0 == pHero)
+		return;
 
-int ImportMapDataFromFile(char *FileName)
-{
-	//	return 0;
-	int w = -1;
-	int l = -1;
-	char trash[10];
-	FILE* input;
-	input = fopen(FileName, "r");
-	if (input == NULL)
-	{
-		return 0;
-	}
+	pTransform = pHero->mpComponent_Transform;
 
+	if (Snap)
+		CameraSnap(&sgCamera, pTransform->mPosition.x, pTransform->mPosition.y);
 	else
-	{
-		fscanf(input, "%s %i", trash, &w);
-		fscanf(input, "%s %i", trash, &l);
-
-
-
-		if (w > 0 && l > 0)
-		{
-			BINARY_MAP_WIDTH = w;
-			BINARY_MAP_HEIGHT = l;
-
-			MapData = malloc(l * sizeof(int*));
-			BinaryCollisionArray = malloc(l * sizeof(int*));
-
-
-
-			for (int j = BINARY_MAP_HEIGHT - 1; j >= 0; --j)
-			{
-
-
-				for (int i = 0; i < BINARY_MAP_WIDTH; ++i)
-				{
-					if (j == BINARY_MAP_HEIGHT - 1)
-					{
-						BinaryCollisionArray[i] = malloc(w * sizeof(int));
-						MapData[i] = malloc(w * sizeof(int));
-					}
-
-					fscanf(input, "%i", &MapData[i][j]);
-
-					if (MapData[i][j] == 1)
-					{
-						BinaryCollisionArray[i][j] = 1;
-					}
-
-					else
-					{
-						BinaryCollisionArray[i][j] = 0;
-					}
-
-				}
-
-
-			}
-
-
-
-			//for(int i=BINARY_MAP_HEIGHT-1;i>=0;i--)//<BINARY_MAP_HEIGHT;i++)
-			//{
-			//	BinaryCollisionArray[i] = malloc(w * sizeof(int));
-			//	MapData[i] = malloc(w * sizeof(int));
-
-			//	for (int j =0;j<BINARY_MAP_WIDTH;j++)
-			//	{
-			//		
-			//		fscanf(input,"%i", &MapData[j][i]);
-
-			//		if (MapData[j][i] ==1)
-			//		{
-			//			BinaryCollisionArray[j][i] = 1;
-			//		}
-
-			//		else
-			//		{
-			//			BinaryCollisionArray[j][i] = 0;
-			//		}
-			//	}
-			//}
-			fclose(input);
-			input = NULL;
-			return 1;
-		}
-
-		else
-		{
-			return 0;
-		}
-	}
-
-
-}
-
-void FreeMapData(void)
-{
-	for (int i = 0; i<BINARY_MAP_HEIGHT; i++)
-	{
-		free(BinaryCollisionArray[i]);
-		free(MapData[i]);
-	}
-
-	free(BinaryCollisionArray);
-	free(MapData);
+		CameraFollow(&sgCamera, pTransform->mPosition.x, pTransform->mPosition.y, pHero->mpComponent_Physics->mVelocity.x, (float)GameStateMgrGetUpdateTime());
 }
 
+// ---------------------------------------------------------------------------
 
-void EnemyStateMachine(GameObjectInstance *pInst)//, float frametime)
+// Each call is one mesh, made for the call and freed right after the draw: the
+// Alpha Engine has no vertex buffer that can be filled again
+void AEBatchDrawTriangles(unsigned int Shape, const SpriteVertex *pVertices, unsigned int TriangleNum)
 {
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	// TO DO 9:
-	// -- Implement the enemys state machine.
-	// -- Each enemys current movement status is controlled by its state, innerState and 
-	//    counter member variables.
-	//    Refer to the provided enemy movement flowchart.
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	/////////////////////////////////////////////////////////////////////////////////////////////////
-	float frametime = AEFrameRateControllerGetFrameTime();
-
-	if (pInst->mpComponent_AI->mState == STATE_NONE)
-	{
-		pInst->mpComponent_AI->mState = STATE_GOING_LEFT;
-		pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_ENTER;
-	}
+	AEGfxVertexList *pMesh;
+	unsigned int t;
 
-	if (pInst->mpComponent_AI->mState == STATE_GOING_LEFT)
-	{
-		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_ENTER)
-		{
-			pInst->mpComponent_Physics->mVelocity.x = -1 * MOVE_VELOCITY_ENEMY;
-			pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_UPDATE;
-		}
-
-		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_UPDATE)
-		{
-			//pInst->mpComponent_MapCollision->mMapCollisionFlag = CheckInstanceBinaryMapCollision(pInst->mpComponent_Transform->mPosition.x, pInst->mpComponent_Transform->mPosition.y, pInst->mpComponent_Transform->mScaleX, pInst->mpComponent_Transform->mScaleY);
-			
-			if (GetCellValue(pInst->mpComponent_Transform->mPosition.x - 1, pInst->mpComponent_Transform->mPosition.y - 1)==0 || (pInst->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_LEFT)==COLLISION_LEFT)
-			{
-				pInst->mpComponent_Physics->mVelocity.x = 0.f;
-				pInst->mpComponent_AI->mCounter = 2.f;
-				pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_EXIT;
-			}
-		
-		}
-
-		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_EXIT)
-		{
-			pInst->mpComponent_AI->mCounter -= frametime;
-			GameObjectInstance* temp;
-			temp=GameObjectInstanceCreate(PARTICLE_TYPE_ENEMY_BURN);
-			temp->mpComponent_Transform->mPosition.x = pInst->mpComponent_Transform->mPosition.x + (-1 + rand() % 3) / 2.f;
-			temp->mpComponent_Transform->mPosition.y = pInst->mpComponent_Transform->mPosition.y + 0.25f;
-			if (pInst->mpComponent_AI->mCounter <= 0)
-			{
-				pInst->mpComponent_AI->mState = STATE_GOING_RIGHT;
-				pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_ENTER;
-			}
-		}
-	}
+	AEGfxMeshStart();
 
-	else if (pInst->mpComponent_AI->mState == STATE_GOING_RIGHT)
+	for (t = 0; t < TriangleNum; ++t, pVertices += 3)
 	{
-
-		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_ENTER)
-		{
-			pInst->mpComponent_Physics->mVelocity.x =  MOVE_VELOCITY_ENEMY;
-			pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_UPDATE;
-		}
-
-		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_UPDATE)
-		{
-			pInst->mpComponent_MapCollision->mMapCollisionFlag = CheckInstanceBinaryMapCollision(pInst->mpComponent_Transform->mPosition.x, pInst->mpComponent_Transform->mPosition.y, pInst->mpComponent_Transform->mScaleX, pInst->mpComponent_Transform->mScaleY);
-
-			if (GetCellValue(pInst->mpComponent_Transform->mPosition.x + 1, pInst->mpComponent_Transform->mPosition.y - 1) ==0 || (pInst->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_RIGHT)==COLLISION_RIGHT)
-			{
-				pInst->mpComponent_Physics->mVelocity.x = 0.f;
-				pInst->mpComponent_AI->mCounter = 2.f;
-				pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_EXIT;
-			}
-
-		}
-
-		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_EXIT)
-		{
-			pInst->mpComponent_AI->mCounter -= frametime;
-			GameObjectInstance* temp;
-			temp = GameObjectInstanceCreate(PARTICLE_TYPE_ENEMY_BURN);
-			temp->mpComponent_Transform->mPosition.x = pInst->mpComponent_Transform->mPosition.x + (-1 + rand() % 3) / 2.f;
-			temp->mpComponent_Transform->mPosition.y = pInst->mpComponent_Transform->mPosition.y + 0.25f;
-			if (pInst->mpComponent_AI->mCounter <= 0)
-			{
-				pInst->mpComponent_AI->mState = STATE_GOING_LEFT;
-				pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_ENTER;
-			}
-		}
+		AEGfxTriAdd(
+			pVertices[0].mX, pVertices[0].mY, pVertices[0].mColor, 0.0f, 0.0f,
+			pVertices[1].mX, pVertices[1].mY, pVertices[1].mColor, 0.0f, 0.0f,
+			pVertices[2].mX, pVertices[2].mY, pVertices[2].mColor, 0.0f, 0.0f);
 	}
 
-
-
-
+	pMesh = AEGfxMeshEnd();
+	AEGfxMeshDraw(pMesh, AE_GFX_MDM_TRIANGLES);
+	AEGfxMeshFree(pMesh);
 }
 
-
-
-
-
-
-
 // ---------------------------------------------------------------------------
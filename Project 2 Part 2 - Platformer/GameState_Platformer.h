@@ -5,7 +5,10 @@
 // Creation Date	:	2008/03/04
 // Purpose			:	Header file of the platform game state
 // History			:
-//	- 
+//	- 2026/10/17	:	The functions get the World they run
+//	- 2026/10/17	:	GameStatePlatformLoadData, the map import, which can be
+//						prefetched on another thread
+//	- 2026/10/17	:	GameStatePlatformRestart
 // ---------------------------------------------------------------------------
 
 #ifndef GAME_STATE_PLATFORM_H
@@ -13,12 +16,26 @@
 
 // ---------------------------------------------------------------------------
 
-void GameStatePlatformLoad(void);
-void GameStatePlatformInit(void);
-void GameStatePlatformUpdate(void);
-void GameStatePlatformDraw(void);
-void GameStatePlatformFree(void);
-void GameStatePlatformUnload(void);
+#include "PlatformerSim.h"
+
+// ---------------------------------------------------------------------------
+
+// Imports the map into "pWorld". Does not call the Alpha Engine, nor touch the state's
+// own data: the game state manager can run it on another thread. Returns 0 if the map
+// could not be loaded
+int GameStatePlatformLoadData(World *pWorld);
+
+void GameStatePlatformLoad(World *pWorld);
+void GameStatePlatformInit(World *pWorld);
+void GameStatePlatformInput(World *pWorld);
+void GameStatePlatformUpdate(World *pWorld);
+void GameStatePlatformSnapshot(World *pWorld);
+void GameStatePlatformDraw(World *pWorld);
+void GameStatePlatformFree(World *pWorld);
+void GameStatePlatformUnload(World *pWorld);
+
+// Puts the level back as GameStatePlatformInit left it, without freeing it first
+void GameStatePlatformRestart(World *pWorld);
 
 // ---------------------------------------------------------------------------
 
@@ -0,0 +1,454 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	HeadlessMain.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Entry point of the headless simulation (no window, no
+//						Alpha Engine). Steps the world with a fixed time step.
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- scripted input (-demo) and per tick trace (-trace), to
+//						  check that a change keeps the simulation's results
+//	- 2026/10/17	:	- -render submits every tick to the sprite batch, with a
+//						  backend that only counts
+//	- 2026/10/17	:	- -render culls to an 800x600 window
+//	- 2026/10/17	:	- -render culls to a Camera that follows the hero
+//	- 2026/10/17	:	- -render draws RenderPackets, -pipelined makes them on a
+//						  second thread while the last one is drawn. Runs are
+//						  timed with a wall clock
+//	- 2026/10/17	:	- the World is passed to the simulation, the tick to
+//						  the backend
+//	- 2026/10/17	:	- -restart: the runs after the first restart the level
+//						  with SimRestart instead of loading it again
+//	- 2026/10/17	:	- reports the chunks that ran out of instance slots
+//	- 2026/10/17	:	- -draws writes the draw calls of each frame, for
+//						  "make test" to check the batching
+//	- 2026/10/17	:	- the -demo input is SimDemo's
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+// includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "PlatformerSim.h"
+#include "SimDemo.h"
+#include "PlatformerRender.h"
+#include "Camera.h"
+#include "RenderPacket.h"
+#include "Thread.h"
+#include "BinaryMap.h"
+
+// ---------------------------------------------------------------------------
+// Defines
+
+#define RENDER_WIN_WIDTH		800.0f		// The game's window, for -render
+#define RENDER_WIN_HEIGHT		600.0f
+
+// ---------------------------------------------------------------------------
+// Static function protoypes
+
+static double	HeadlessGetFrameTime(void *pContext);
+static int		HeadlessCheckInput(void *pContext, unsigned int Input);
+static void		WriteTrace(FILE *pFile, unsigned long Tick);
+static void		CountDrawTriangles(unsigned int Shape, const SpriteVertex *pVertices, unsigned int TriangleNum);
+static void		StepTick(void);
+static void		Snapshot(void);
+static void		DrawSnapshot(void);
+static void		UpdateThreadMain(void *pContext);
+
+// ---------------------------------------------------------------------------
+// globals
+
+static double	sgFrameTime = 1.0 / 60.0;
+static unsigned long sgTick;			// Current tick of the run, drives the demo input
+
+static const SimBackend sgHeadlessBackend =
+{
+	HeadlessGetFrameTime,
+	HeadlessCheckInput,
+	HeadlessCheckInput,
+	0
+};
+
+// Runs right, then left, then right again, jumping every now and then. The context
+// is the tick
+static const SimBackend sgDemoBackend =
+{
+	HeadlessGetFrameTime,
+	SimDemoCheckInputCurr,
+	SimDemoCheckInputTriggered,
+	&sgTick
+};
+
+// Draws nothing: counts the calls, and sums the vertices so they are really computed
+static const SpriteBatchBackend sgCountBatchBackend =
+{
+	CountDrawTriangles
+};
+
+static double	sgVertexSum;
+
+// The run, as StepTick sees it
+static World	*sgpWorld;
+static int		sgRender;
+static FILE		*sgpTrace;				// Written on the last run only
+static FILE		*sgpDraws;				// Written on the last run only
+static unsigned int sgFrameDrawCallNum;
+static Affine2D	sgMap;
+static Camera	sgCamera;
+static RenderPacketQueue sgPackets;
+
+// Draw counts, over all the ticks
+static unsigned long sgSpriteNum;
+static unsigned long sgDrawCallNum, sgDrawCallMax, sgTriangleNum;
+
+// -pipelined: the ticks run on sgUpdateThread while the main thread draws
+static Semaphore sgUpdateStart;
+static Semaphore sgUpdateDone;
+static int		sgUpdateThreadQuit;
+
+// ---------------------------------------------------------------------------
+// main
+
+int main(int argc, char **argv)
+{
+	char *pMapFile = "Exported.txt";
+	unsigned long ticks = 600;
+	unsigned long runs = 1;
+	unsigned long run;
+	double start;
+	double seconds;
+	GameObjectInstance *pHero;
+	SimStats stats;
+	const SimBackend *pBackend = &sgHeadlessBackend;
+	char *pTraceFile = 0;
+	FILE *pTrace = 0;
+	char *pDrawsFile = 0;
+	FILE *pDraws = 0;
+	int pipelined = 0;
+	int restart = 0;
+	Thread updateThread;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (0 == strcmp(argv[i], "-map") && i + 1 < argc)
+			pMapFile = argv[++i];
+		else if (0 == strcmp(argv[i], "-ticks") && i + 1 < argc)
+			ticks = strtoul(argv[++i], 0, 10);
+		else if (0 == strcmp(argv[i], "-hz") && i + 1 < argc)
+			sgFrameTime = 1.0 / strtod(argv[++i], 0);
+		else if (0 == strcmp(argv[i], "-runs") && i + 1 < argc)
+			runs = strtoul(argv[++i], 0, 10);
+		else if (0 == strcmp(argv[i], "-demo"))
+			pBackend = &sgDemoBackend;
+		else if (0 == strcmp(argv[i], "-trace") && i + 1 < argc)
+			pTraceFile = argv[++i];
+		else if (0 == strcmp(argv[i], "-draws") && i + 1 < argc)
+		{
+			pDrawsFile = argv[++i];
+			sgRender = 1;
+		}
+		else if (0 == strcmp(argv[i], "-render"))
+			sgRender = 1;
+		else if (0 == strcmp(argv[i], "-pipelined"))
+			sgRender = pipelined = 1;
+		else if (0 == strcmp(argv[i], "-restart"))
+			restart = 1;
+		else
+		{
+			printf("usage: %s [-map file] [-ticks n] [-hz rate] [-runs n] [-demo] [-trace file] [-render] [-draws file] [-pipelined] [-restart]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// The trace is the state after each tick of the last run. The same map, options and
+	// code must give the same file: "make test" diffs it against the ones in Traces/
+	if (pTraceFile)
+	{
+		pTrace = fopen(pTraceFile, "w");
+		if (!pTrace)
+		{
+			printf("could not open %s\n", pTraceFile);
+			return 1;
+		}
+	}
+
+	// One line per drawn frame, one "shape:triangles" per draw call
+	if (pDrawsFile)
+	{
+		pDraws = fopen(pDrawsFile, "w");
+		if (!pDraws)
+		{
+			printf("could not open %s\n", pDrawsFile);
+			return 1;
+		}
+	}
+
+	sgpWorld = WorldCreate();
+	if (!sgpWorld)
+	{
+		printf("could not allocate the world\n");
+		return 1;
+	}
+
+	SimSetBackend(sgpWorld, pBackend);
+
+	if (sgRender && (!PlatformerRenderInit(&sgCountBatchBackend) || !RenderPacketQueueInit(&sgPackets, GAME_OBJ_INST_NUM_MAX + PARTICLE_NUM_MAX)))
+	{
+		printf("could not allocate the sprite batch\n");
+		return 1;
+	}
+
+	if (pipelined && (!SemaphoreInit(&sgUpdateStart, 0) || !SemaphoreInit(&sgUpdateDone, 0) || !ThreadCreate(&updateThread, UpdateThreadMain, 0)))
+	{
+		printf("could not start the update thread\n");
+		return 1;
+	}
+
+	start = ThreadGetTime();
+
+	for (run = 0; run < runs; ++run)
+	{
+		// Same random sequence on every run
+		if (restart && run > 0)
+			SimRestart(sgpWorld);
+		else
+		{
+			if (!SimLoad(sgpWorld, pMapFile))
+			{
+				printf("could not load %s\n", pMapFile);
+				return 1;
+			}
+
+			// The game state's map transformation: 30 pixels per cell
+			Affine2DIdentity(&sgMap);
+			sgMap.m[0][0] = 30.f;
+			sgMap.m[1][1] = 30.f;
+			SimSetWorldTransform(sgpWorld, &sgMap);
+
+			SimSeedRandom(sgpWorld, 1);
+			SimInit(sgpWorld);
+		}
+
+		// The game state's camera
+		CameraInit(&sgCamera, RENDER_WIN_WIDTH, RENDER_WIN_HEIGHT, 30.f);
+		CameraSetBounds(&sgCamera, 0.f, 0.f, (float)GetMapWidth(SimGetMap(sgpWorld)), (float)GetMapHeight(SimGetMap(sgpWorld)));
+		CameraSetDeadZone(&sgCamera, 2.f, 1.5f);
+		CameraSetLookAhead(&sgCamera, 3.f, 6.f);
+
+		pHero = SimGetHero(sgpWorld);
+		if (pHero)
+			CameraSnap(&sgCamera, pHero->mpComponent_Transform->mPosition.x, pHero->mpComponent_Transform->mPosition.y);
+
+		sgpTrace = run + 1 == runs ? pTrace : 0;
+		sgpDraws = run + 1 == runs ? pDraws : 0;
+		if (sgRender)
+			Snapshot();
+
+		for (sgTick = 0; sgTick < ticks; ++sgTick)
+		{
+			if (pipelined)
+			{
+				// This tick is run while the last one is drawn
+				SemaphorePost(&sgUpdateStart);
+				DrawSnapshot();
+				SemaphoreWait(&sgUpdateDone);
+			}
+			else
+			{
+				StepTick();
+				if (sgRender)
+					DrawSnapshot();
+			}
+		}
+
+		pHero = SimGetHero(sgpWorld);
+		if (run + 1 == runs && pHero)
+			printf("hero: %f %f\n", pHero->mpComponent_Transform->mPosition.x, pHero->mpComponent_Transform->mPosition.y);
+
+		SimGetStats(sgpWorld, &stats);
+		if (run + 1 == runs && stats.mSpawnFailNum)
+			printf("%d chunk spawn(s) ran out of instance slots\n", stats.mSpawnFailNum);
+
+		// A restarted level stays loaded until the last run
+		if (!restart || run + 1 == runs)
+		{
+			SimFree(sgpWorld);
+			SimUnload(sgpWorld);
+		}
+	}
+
+	seconds = ThreadGetTime() - start;
+
+	if (pipelined)
+	{
+		sgUpdateThreadQuit = 1;
+		SemaphorePost(&sgUpdateStart);
+		ThreadJoin(&updateThread);
+		SemaphoreFree(&sgUpdateStart);
+		SemaphoreFree(&sgUpdateDone);
+	}
+
+	WorldDestroy(sgpWorld);
+
+	if (pTrace)
+		fclose(pTrace);
+	if (pDraws)
+		fclose(pDraws);
+
+	printf("%lu run(s) of %lu ticks in %.3f s", runs, ticks, seconds);
+	if (seconds > 0.0)
+		printf(" (%.0f ticks/s)", runs * ticks / seconds);
+	printf("\n");
+
+	if (sgRender)
+	{
+		if (runs * ticks > 0)
+			printf("render: %.0f sprites, %.1f draw calls (max %lu), %.0f triangles per tick\n", (double)sgSpriteNum / (runs * ticks), (double)sgDrawCallNum / (runs * ticks), sgDrawCallMax, (double)sgTriangleNum / (runs * ticks));
+		RenderPacketQueueFree(&sgPackets);
+		PlatformerRenderFree();
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// One update, then what the game state does after it
+void StepTick(void)
+{
+	SimUpdate(sgpWorld);
+
+	if (sgRender)
+	{
+		GameObjectInstance *pHero = SimGetHero(sgpWorld);
+
+		if (pHero)
+			CameraFollow(&sgCamera, pHero->mpComponent_Transform->mPosition.x, pHero->mpComponent_Transform->mPosition.y, pHero->mpComponent_Physics->mVelocity.x, (float)sgFrameTime);
+		Snapshot();
+	}
+
+	if (sgpTrace)
+		WriteTrace(sgpTrace, sgTick);
+}
+
+// ---------------------------------------------------------------------------
+
+// Like GameStatePlatformSnapshot, drawn half way between two ticks
+void Snapshot(void)
+{
+	RenderPacket *pPacket = RenderPacketQueueBeginWrite(&sgPackets);
+	float minX, minY, maxX, maxY;
+	float prevMinX, prevMinY, prevMaxX, prevMaxY;
+
+	pPacket->mCamera = sgCamera;
+	pPacket->mAlpha = 0.5f;
+
+	CameraGetVisibleRect(&sgCamera, 0.f, &prevMinX, &prevMinY, &prevMaxX, &prevMaxY);
+	CameraGetVisibleRect(&sgCamera, 1.f, &minX, &minY, &maxX, &maxY);
+	PlatformerRenderCapture(sgpWorld, pPacket, &sgMap, fminf(minX, prevMinX), fminf(minY, prevMinY), fmaxf(maxX, prevMaxX), fmaxf(maxY, prevMaxY));
+
+	RenderPacketQueuePublish(&sgPackets);
+}
+
+// ---------------------------------------------------------------------------
+
+// Like GameStatePlatformDraw, without the map
+void DrawSnapshot(void)
+{
+	const RenderPacket *pPacket = RenderPacketQueueAcquire(&sgPackets);
+	const SpriteBatch *pBatch = PlatformerRenderGetBatch();
+	float minX, minY, maxX, maxY;
+
+	CameraGetVisibleRect(&pPacket->mCamera, pPacket->mAlpha, &minX, &minY, &maxX, &maxY);
+	sgFrameDrawCallNum = 0;
+	PlatformerRenderDraw(pPacket, minX, minY, maxX, maxY);
+	if (sgpDraws)
+		fprintf(sgpDraws, "\n");
+
+	sgSpriteNum += pBatch->mNum;
+	sgDrawCallNum += pBatch->mDrawCallNum;
+	sgTriangleNum += pBatch->mTriangleNum;
+	if (pBatch->mDrawCallNum > sgDrawCallMax)
+		sgDrawCallMax = pBatch->mDrawCallNum;
+}
+
+// ---------------------------------------------------------------------------
+
+void UpdateThreadMain(void *pContext)
+{
+	for (;;)
+	{
+		SemaphoreWait(&sgUpdateStart);
+
+		if (sgUpdateThreadQuit)
+			return;
+
+		StepTick();
+		SemaphorePost(&sgUpdateDone);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+double HeadlessGetFrameTime(void *pContext)
+{
+	return sgFrameTime;
+}
+
+// ---------------------------------------------------------------------------
+
+int HeadlessCheckInput(void *pContext, unsigned int Input)
+{
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// Only counts, and logs the call for -draws. Nothing is drawn
+void CountDrawTriangles(unsigned int Shape, const SpriteVertex *pVertices, unsigned int TriangleNum)
+{
+	unsigned int v;
+
+	for (v = 0; v < TriangleNum * 3; ++v)
+		sgVertexSum += pVertices[v].mX + pVertices[v].mY;
+
+	if (sgpDraws)
+		fprintf(sgpDraws, sgFrameDrawCallNum ? " %u:%u" : "%u:%u", Shape, TriangleNum);
+	++sgFrameDrawCallNum;
+}
+
+// ---------------------------------------------------------------------------
+
+// One line per tick: the hero, the enemies and the number of coins left.
+// Particles are left out, their jitter depends on the order the random numbers are drawn in
+void WriteTrace(FILE *pFile, unsigned long Tick)
+{
+	GameObjectInstance *pInstances = SimGetInstances(sgpWorld);
+	GameObjectInstance *pHero = SimGetHero(sgpWorld);
+	int i, coins = 0;
+
+	fprintf(pFile, "%lu", Tick);
+	if (pHero)
+		fprintf(pFile, " H %.9g %.9g", pHero->mpComponent_Transform->mPosition.x, pHero->mpComponent_Transform->mPosition.y);
+
+	// In slot order, which does not depend on how the update walks the instances
+	for (i = 0; i < GAME_OBJ_INST_NUM_MAX; ++i)
+	{
+		GameObjectInstance *pInst = pInstances + i;
+
+		if (0 == (pInst->mFlag & FLAG_ACTIVE))
+			continue;
+
+		if (pInst->mpComponent_Sprite->mShapeType == OBJECT_TYPE_ENEMY1)
+			fprintf(pFile, " E %.9g %.9g", pInst->mpComponent_Transform->mPosition.x, pInst->mpComponent_Transform->mPosition.y);
+		else if (pInst->mpComponent_Sprite->mShapeType == OBJECT_TYPE_COIN)
+			++coins;
+	}
+
+	fprintf(pFile, " C %d\n", coins);
+}
+
+// ---------------------------------------------------------------------------
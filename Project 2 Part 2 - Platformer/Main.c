@@ -6,6 +6,7 @@
 // Purpose			:	main entry point for the test program
 // History			:
 // - 2007/04/26		:	- initial implementation
+// - 2026/10/17		:	- The first level is prefetched while the window is made
 // ---------------------------------------------------------------------------
 
 // ---------------------------------------------------------------------------
@@ -44,12 +45,25 @@ int WINAPI WinMain(HINSTANCE instanceH, HINSTANCE prevInstanceH, LPSTR command_l
 	sysInitInfo.mWindowHandle = NULL;
 	sysInitInfo.mHandleWindowMessages = 1;
 
+	// Import the first level on another thread while the window is made
+	GameStateMgrPrefetch(GS_PLATFORMER);
+
 	// Initialize the system
 	if (0 != AESysInit(&sysInitInfo))
+	{
+		GameStateMgrCancelPrefetch();
 		return 1;
+	}
 
 
 	GameStateMgrInit(GS_PLATFORMER);
+
+	// Simulate at 60 ticks per second whatever the display rate is
+	GameStateMgrSetFixedTimeStep(60, 8);
+
+	// Update the next frame on a second thread while this one is drawn
+	GameStateMgrSetPipelined(1);
+
 	GSM_MainLoop();
 
 	// free the system
@@ -0,0 +1,60 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	MapConvert.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Offline converter from the text map format (Exported.txt)
+//						to the binary one (see BinaryMap.h)
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- the map is a MapContext passed to BinaryMap
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+// includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "BinaryMap.h"
+
+// ---------------------------------------------------------------------------
+// main
+
+int main(int argc, char **argv)
+{
+	int tileBits = 4;
+	MapContext *pMap;
+
+	if (argc == 5 && 0 == strcmp(argv[3], "-bits"))
+		tileBits = atoi(argv[4]);
+	else if (argc != 3)
+	{
+		printf("usage: %s input.txt output.pmap [-bits 4|8]\n", argv[0]);
+		return 1;
+	}
+
+	pMap = MapContextCreate();
+	if (!pMap)
+		return 1;
+
+	if (!ImportMapDataFromFile(pMap, argv[1]))
+	{
+		printf("could not load %s\n", argv[1]);
+		return 1;
+	}
+
+	if (!ExportMapDataToBinaryFile(pMap, argv[2], tileBits))
+	{
+		printf("could not write %s\n", argv[2]);
+		MapContextDestroy(pMap);
+		return 1;
+	}
+
+	printf("%s: %i x %i cells\n", argv[2], GetMapWidth(pMap), GetMapHeight(pMap));
+	MapContextDestroy(pMap);
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,192 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	MathBatch.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the batch math operations
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include "MathBatch.h"
+
+// ---------------------------------------------------------------------------
+
+// The kernels are written once against these lane macros, each loop is followed by
+// a scalar loop for the elements left over
+#if defined(MATH_BATCH_SCALAR)
+
+#define MATH_BATCH_KERNEL_NAME		"scalar"
+
+#elif defined(__AVX__)
+
+#include <immintrin.h>
+
+#define MATH_BATCH_KERNEL_NAME		"avx"
+#define LANE_WIDTH					8
+typedef __m256 Lane;
+#define LaneLoad(p)					_mm256_loadu_ps(p)
+#define LaneStore(p, a)				_mm256_storeu_ps(p, a)
+#define LaneSet(c)					_mm256_set1_ps(c)
+#define LaneAdd(a, b)				_mm256_add_ps(a, b)
+#define LaneSub(a, b)				_mm256_sub_ps(a, b)
+#define LaneMul(a, b)				_mm256_mul_ps(a, b)
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>
+
+#define MATH_BATCH_KERNEL_NAME		"sse2"
+#define LANE_WIDTH					4
+typedef __m128 Lane;
+#define LaneLoad(p)					_mm_loadu_ps(p)
+#define LaneStore(p, a)				_mm_storeu_ps(p, a)
+#define LaneSet(c)					_mm_set1_ps(c)
+#define LaneAdd(a, b)				_mm_add_ps(a, b)
+#define LaneSub(a, b)				_mm_sub_ps(a, b)
+#define LaneMul(a, b)				_mm_mul_ps(a, b)
+
+#else
+
+#define MATH_BATCH_KERNEL_NAME		"scalar"
+
+#endif
+
+// ---------------------------------------------------------------------------
+
+const char* MathBatchGetKernelName(void)
+{
+	return MATH_BATCH_KERNEL_NAME;
+}
+
+// ---------------------------------------------------------------------------
+
+void FloatBatchScaleAdd(float *pResult, const float *pAdd, float c, unsigned int Num)
+{
+	unsigned int i = 0;
+
+#ifdef LANE_WIDTH
+	Lane lc = LaneSet(c);
+
+	for (; i + LANE_WIDTH <= Num; i += LANE_WIDTH)
+		LaneStore(pResult + i, LaneAdd(LaneLoad(pResult + i), LaneMul(LaneLoad(pAdd + i), lc)));
+#endif
+
+	for (; i < Num; ++i)
+		pResult[i] += pAdd[i] * c;
+}
+
+// ---------------------------------------------------------------------------
+
+void Vector2DBatchScaleAdd(float *pResultX, float *pResultY, const float *pAddX, const float *pAddY, float c, unsigned int Num)
+{
+	FloatBatchScaleAdd(pResultX, pAddX, c, Num);
+	FloatBatchScaleAdd(pResultY, pAddY, c, Num);
+}
+
+// ---------------------------------------------------------------------------
+
+void Matrix2DBatchMultVec(float *pResultX, float *pResultY, const Matrix2D *pMtx, const float *pX, const float *pY, unsigned int Num)
+{
+	float m00 = pMtx->m[0][0], m01 = pMtx->m[0][1], m02 = pMtx->m[0][2];
+	float m10 = pMtx->m[1][0], m11 = pMtx->m[1][1], m12 = pMtx->m[1][2];
+	unsigned int i = 0;
+
+#ifdef LANE_WIDTH
+	Lane l00 = LaneSet(m00), l01 = LaneSet(m01), l02 = LaneSet(m02);
+	Lane l10 = LaneSet(m10), l11 = LaneSet(m11), l12 = LaneSet(m12);
+
+	for (; i + LANE_WIDTH <= Num; i += LANE_WIDTH)
+	{
+		Lane x = LaneLoad(pX + i);
+		Lane y = LaneLoad(pY + i);
+
+		LaneStore(pResultX + i, LaneAdd(LaneAdd(LaneMul(l00, x), LaneMul(l01, y)), l02));
+		LaneStore(pResultY + i, LaneAdd(LaneAdd(LaneMul(l10, x), LaneMul(l11, y)), l12));
+	}
+#endif
+
+	for (; i < Num; ++i)
+	{
+		float x = pX[i];
+		float y = pY[i];
+
+		pResultX[i] = m00 * x + m01 * y + m02;
+		pResultY[i] = m10 * x + m11 * y + m12;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+/*
+T * R * S is
+	| cos*sx  -sin*sy  x |
+	| sin*sx   cos*sy  y |
+	|   0        0     1 |
+The sines and cosines are computed one by one, the products in lanes
+*/
+void Matrix2DBatchTRS(Matrix2D *pResults, const float *pX, const float *pY, const float *pAngle, const float *pScaleX, const float *pScaleY, unsigned int Num)
+{
+	unsigned int i = 0;
+
+#ifdef LANE_WIDTH
+	unsigned int k;
+	float c[LANE_WIDTH], s[LANE_WIDTH];
+	float m00[LANE_WIDTH], m01[LANE_WIDTH], m10[LANE_WIDTH], m11[LANE_WIDTH];
+
+	for (; i + LANE_WIDTH <= Num; i += LANE_WIDTH)
+	{
+		Lane lc, ls, sx, sy;
+
+		for (k = 0; k < LANE_WIDTH; ++k)
+		{
+			c[k] = cosf(pAngle[i + k]);
+			s[k] = sinf(pAngle[i + k]);
+		}
+
+		lc = LaneLoad(c);
+		ls = LaneLoad(s);
+		sx = LaneLoad(pScaleX + i);
+		sy = LaneLoad(pScaleY + i);
+
+		LaneStore(m00, LaneMul(lc, sx));
+		LaneStore(m01, LaneSub(LaneSet(0.0f), LaneMul(ls, sy)));
+		LaneStore(m10, LaneMul(ls, sx));
+		LaneStore(m11, LaneMul(lc, sy));
+
+		for (k = 0; k < LANE_WIDTH; ++k)
+		{
+			Matrix2D *pResult = pResults + i + k;
+
+			pResult->m[0][0] = m00[k];
+			pResult->m[0][1] = m01[k];
+			pResult->m[0][2] = pX[i + k];
+			pResult->m[1][0] = m10[k];
+			pResult->m[1][1] = m11[k];
+			pResult->m[1][2] = pY[i + k];
+			pResult->m[2][0] = 0.0f;
+			pResult->m[2][1] = 0.0f;
+			pResult->m[2][2] = 1.0f;
+		}
+	}
+#endif
+
+	for (; i < Num; ++i)
+	{
+		Matrix2D *pResult = pResults + i;
+		float cs = cosf(pAngle[i]);
+		float sn = sinf(pAngle[i]);
+
+		pResult->m[0][0] = cs * pScaleX[i];
+		pResult->m[0][1] = -sn * pScaleY[i];
+		pResult->m[0][2] = pX[i];
+		pResult->m[1][0] = sn * pScaleX[i];
+		pResult->m[1][1] = cs * pScaleY[i];
+		pResult->m[1][2] = pY[i];
+		pResult->m[2][0] = 0.0f;
+		pResult->m[2][1] = 0.0f;
+		pResult->m[2][2] = 1.0f;
+	}
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	MathBatch.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Vector2D and Matrix2D operations over whole arrays, with
+//						SSE2/AVX kernels and a scalar fallback
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef MATH_BATCH_H
+#define MATH_BATCH_H
+
+// ---------------------------------------------------------------------------
+
+#include "Matrix2D.h"
+
+// ---------------------------------------------------------------------------
+
+/*
+The kernel set is picked at compile time: AVX when the compiler targets it
+(/arch:AVX or /arch:AVX2, -mavx or -mavx2), else SSE2 on x86/x64, else plain C.
+Define MATH_BATCH_SCALAR to force the plain C loops.
+
+The vectors are passed as separate X and Y arrays. The arrays do not need to be
+aligned, and an output array may be the same as an input array, but must not
+partially overlap one.
+*/
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function returns the name of the kernel set: "avx", "sse2" or "scalar"
+*/
+const char* MathBatchGetKernelName(void);
+
+/*
+In this function, each pResult[i] will be pResult[i] + pAdd[i] * c
+*/
+void FloatBatchScaleAdd(float *pResult, const float *pAdd, float c, unsigned int Num);
+
+/*
+In this function, each vector (pResultX[i], pResultY[i]) will be increased by
+(pAddX[i], pAddY[i]) scaled by c. With the velocities and the frame time, this
+integrates the positions
+*/
+void Vector2DBatchScaleAdd(float *pResultX, float *pResultY, const float *pAddX, const float *pAddY, float c, unsigned int Num);
+
+/*
+This function multiplies the matrix Mtx with the Num vectors (pX[i], pY[i]) and
+saves the results in (pResultX[i], pResultY[i])
+*/
+void Matrix2DBatchMultVec(float *pResultX, float *pResultY, const Matrix2D *pMtx, const float *pX, const float *pY, unsigned int Num);
+
+/*
+This function builds Num matrices Translate * Rotate * Scale, from the positions,
+angles (in radian) and scaling values, without concatenating matrices
+*/
+void Matrix2DBatchTRS(Matrix2D *pResults, const float *pX, const float *pY, const float *pAngle, const float *pScaleX, const float *pScaleY, unsigned int Num);
+
+// ---------------------------------------------------------------------------
+
+#endif // MATH_BATCH_H
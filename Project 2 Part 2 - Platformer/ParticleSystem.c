@@ -0,0 +1,102 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	ParticleSystem.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the particle system
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- integration goes through the MathBatch kernels
+// ---------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "ParticleSystem.h"
+#include "MathBatch.h"
+
+// ---------------------------------------------------------------------------
+
+#define PARTICLE_INDEX_MASK			(PARTICLE_NUM_MAX - 1)
+
+// ---------------------------------------------------------------------------
+
+static void IntegrateParticles(ParticleSystem *pSystem, unsigned int Start, unsigned int Num, float FrameTime);
+
+// ---------------------------------------------------------------------------
+
+void ParticleSystemReset(ParticleSystem *pSystem)
+{
+	pSystem->mTail = 0;
+	pSystem->mNum = 0;
+	pSystem->mDroppedNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+int ParticleSystemSpawn(ParticleSystem *pSystem, unsigned int Type, float PosX, float PosY, float VelX, float VelY, float Gravity)
+{
+	unsigned int i;
+
+	if (pSystem->mNum == PARTICLE_NUM_MAX)
+	{
+		++pSystem->mDroppedNum;
+		return 0;
+	}
+
+	i = (pSystem->mTail + pSystem->mNum) & PARTICLE_INDEX_MASK;
+	++pSystem->mNum;
+
+	pSystem->mPosX[i] = PosX;
+	pSystem->mPosY[i] = PosY;
+	pSystem->mPrevPosX[i] = PosX;
+	pSystem->mPrevPosY[i] = PosY;
+	pSystem->mVelX[i] = VelX;
+	pSystem->mVelY[i] = VelY;
+	pSystem->mGravity[i] = Gravity;
+	pSystem->mAge[i] = 0.0f;
+	pSystem->mType[i] = (unsigned char)Type;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void ParticleSystemUpdate(ParticleSystem *pSystem, float FrameTime, float LifeTime)
+{
+	unsigned int firstNum;
+
+	// The live particles are at most 2 contiguous runs: from the tail to the end of the
+	// arrays, then from the start of the arrays
+	firstNum = PARTICLE_NUM_MAX - pSystem->mTail;
+	if (firstNum > pSystem->mNum)
+		firstNum = pSystem->mNum;
+
+	IntegrateParticles(pSystem, pSystem->mTail, firstNum, FrameTime);
+	IntegrateParticles(pSystem, 0, pSystem->mNum - firstNum, FrameTime);
+
+	// The oldest particles are at the tail
+	while (pSystem->mNum > 0 && pSystem->mAge[pSystem->mTail] > LifeTime)
+	{
+		pSystem->mTail = (pSystem->mTail + 1) & PARTICLE_INDEX_MASK;
+		--pSystem->mNum;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void IntegrateParticles(ParticleSystem *pSystem, unsigned int Start, unsigned int Num, float FrameTime)
+{
+	float *pAge = pSystem->mAge + Start;
+	unsigned int i;
+
+	memcpy(pSystem->mPrevPosX + Start, pSystem->mPosX + Start, Num * sizeof(float));
+	memcpy(pSystem->mPrevPosY + Start, pSystem->mPosY + Start, Num * sizeof(float));
+
+	FloatBatchScaleAdd(pSystem->mVelY + Start, pSystem->mGravity + Start, FrameTime, Num);
+	Vector2DBatchScaleAdd(pSystem->mPosX + Start, pSystem->mPosY + Start, pSystem->mVelX + Start, pSystem->mVelY + Start, FrameTime, Num);
+
+	for (i = 0; i < Num; ++i)
+		pAge[i] += FrameTime;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	ParticleSystem.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Particles kept apart from the game object instances, in
+//						a fixed capacity ring of structure of arrays
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+// ---------------------------------------------------------------------------
+
+#define PARTICLE_NUM_MAX			(1 << 17)		// Capacity of a particle system, a power of 2
+
+// ---------------------------------------------------------------------------
+
+/*
+Every particle lives for the same time, so they die in the order they were spawned:
+the live particles are the mNum entries from mTail on, wrapping around at
+PARTICLE_NUM_MAX, the oldest first.
+*/
+typedef struct
+{
+	float			mPosX[PARTICLE_NUM_MAX];		// Current position
+	float			mPosY[PARTICLE_NUM_MAX];
+	float			mPrevPosX[PARTICLE_NUM_MAX];	// Position before the last update, used to interpolate the drawing
+	float			mPrevPosY[PARTICLE_NUM_MAX];
+	float			mVelX[PARTICLE_NUM_MAX];		// Current velocity
+	float			mVelY[PARTICLE_NUM_MAX];
+	float			mGravity[PARTICLE_NUM_MAX];		// Added to the Y velocity every second
+	float			mAge[PARTICLE_NUM_MAX];			// Time since the spawn, in seconds
+	unsigned char	mType[PARTICLE_NUM_MAX];		// From OBJECT_TYPE enum (PARTICLE_TYPE_*)
+
+	unsigned int	mTail;							// Index of the oldest particle
+	unsigned int	mNum;							// The number of live particles
+	unsigned long	mDroppedNum;					// Spawns that did not fit since the last reset
+}ParticleSystem;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function kills every particle
+*/
+void ParticleSystemReset(ParticleSystem *pSystem);
+
+/*
+This function adds a particle. When the system is full the particle is dropped:
+the function counts it in mDroppedNum and returns 0
+*/
+int ParticleSystemSpawn(ParticleSystem *pSystem, unsigned int Type, float PosX, float PosY, float VelX, float VelY, float Gravity);
+
+/*
+This function moves the particles (V1.y = Gravity*t + V0.y, then P1 = V1*t + P0),
+ages them by "FrameTime", and kills the ones older than "LifeTime"
+*/
+void ParticleSystemUpdate(ParticleSystem *pSystem, float FrameTime, float LifeTime);
+
+// ---------------------------------------------------------------------------
+
+#endif // PARTICLE_SYSTEM_H
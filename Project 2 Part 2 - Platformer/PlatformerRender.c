@@ -0,0 +1,270 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	PlatformerRender.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the platformer's sprite drawing
+// History			:
+//	- 2026/10/17	:	- initial implementation, the shapes come from
+//						  GameState_Platformer.c
+//	- 2026/10/17	:	- culling against the visible rectangle
+//	- 2026/10/17	:	- split into the capture to a RenderPacket and its draw
+//	- 2026/10/17	:	- the capture takes the World it reads
+// ---------------------------------------------------------------------------
+
+#include "PlatformerRender.h"
+#include "PlatformerSim.h"
+
+// ---------------------------------------------------------------------------
+
+#ifndef PI
+#define	PI		3.1415926f
+#endif
+
+#define SCREEN_X_SCALE 30
+
+#define COIN_PART_NUM				12							// Triangles of the coin's circle
+#define PARTICLE_SCALE				(3.f / SCREEN_X_SCALE)		// In cells: 3 pixels wide
+#define CULL_QUERY_MARGIN			1.f							// Instances are at most 1 cell wide
+
+// ---------------------------------------------------------------------------
+
+static SpriteBatch sgBatch;
+static GameObjectInstance *sgVisibleInstances[GAME_OBJ_INST_NUM_MAX];
+
+// ---------------------------------------------------------------------------
+
+static int	IsMoveOutside(float X, float Y, float PrevX, float PrevY, float Extent, float MinX, float MinY, float MaxX, float MaxY);
+static void SetQuadShape(unsigned int Shape, unsigned int Color);
+static void SetCircleShape(unsigned int Shape, unsigned int Color, int Parts);
+static void SetTriangleShape(unsigned int Shape, unsigned int Color);
+
+// ---------------------------------------------------------------------------
+
+int PlatformerRenderInit(const SpriteBatchBackend *pBackend)
+{
+	if (!SpriteBatchInit(&sgBatch, GAME_OBJ_INST_NUM_MAX + PARTICLE_NUM_MAX, pBackend))
+		return 0;
+
+	// The map cells are drawn by the tile map renderer, they have no shape here
+	SetQuadShape(OBJECT_TYPE_HERO, 0xFF0000FF);						// Blue square
+	SetQuadShape(OBJECT_TYPE_ENEMY1, 0xFFFF0000);					// Red square
+	SetCircleShape(OBJECT_TYPE_COIN, 0xFFFFFF00, COIN_PART_NUM);	// Yellow circle
+	SetTriangleShape(PARTICLE_TYPE_JUMP_EFFECT, 0xFFFF00FF);		// Purple triangle
+	SetTriangleShape(PARTICLE_TYPE_ENEMY_BURN, 0xFFFFA500);			// Orange triangle
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void PlatformerRenderCapture(World *pWorld, RenderPacket *pPacket, const Affine2D *pMapTransform, float MinX, float MinY, float MaxX, float MaxY)
+{
+	const ParticleSystem *pParticles = SimGetParticles(pWorld);
+	unsigned int i, instanceNum;
+	unsigned int n;
+	Affine2D world;
+
+	pPacket->mMapTransform = *pMapTransform;
+
+	// The grid gives the instances around the rectangle, each one is then checked with
+	// its size and the box of its last move
+	instanceNum = SimQueryInstances(pWorld, MinX - CULL_QUERY_MARGIN, MinY - CULL_QUERY_MARGIN, MaxX + CULL_QUERY_MARGIN, MaxY + CULL_QUERY_MARGIN, sgVisibleInstances, GAME_OBJ_INST_NUM_MAX);
+
+	for (i = 0; i < instanceNum; i++)
+	{
+		GameObjectInstance* pInst = sgVisibleInstances[i];
+		Component_Transform *pTransform = pInst->mpComponent_Transform;
+		const Vector2D *pPos = &pTransform->mPosition;
+		const Vector2D *pPrev = &pTransform->mPrevPosition;
+		// Half the size, large enough for any angle
+		float extent = 0.5f * (fabsf(pTransform->mScaleX) + fabsf(pTransform->mScaleY));
+
+		if (IsMoveOutside(pPos->x, pPos->y, pPrev->x, pPrev->y, extent, MinX, MinY, MaxX, MaxY))
+			continue;
+
+		// The simulation keeps the map * instance transformation up to date
+		RenderPacketAdd(pPacket, pInst->mpComponent_Sprite->mShapeType, 0xFFFFFFFF, &pTransform->mWorldTransform, pPos->x, pPos->y, pPrev->x, pPrev->y, extent);
+	}
+
+	for (n = 0; n < pParticles->mNum; ++n)
+	{
+		unsigned int p = (pParticles->mTail + n) & (PARTICLE_NUM_MAX - 1);
+		float x = pParticles->mPosX[p];
+		float y = pParticles->mPosY[p];
+		float prevX = pParticles->mPrevPosX[p];
+		float prevY = pParticles->mPrevPosY[p];
+
+		if (IsMoveOutside(x, y, prevX, prevY, PARTICLE_SCALE, MinX, MinY, MaxX, MaxY))
+			continue;
+
+		Affine2DBuildParentTRS(&world, pMapTransform, x, y, 0.f, PARTICLE_SCALE, PARTICLE_SCALE);
+		RenderPacketAdd(pPacket, pParticles->mType[p], 0xFFFFFFFF, &world, x, y, prevX, prevY, PARTICLE_SCALE);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void PlatformerRenderDraw(const RenderPacket *pPacket, float MinX, float MinY, float MaxX, float MaxY)
+{
+	float alpha = pPacket->mAlpha;
+	unsigned int s;
+	Affine2D world;
+
+	SpriteBatchBegin(&sgBatch);
+
+	for (s = 0; s < pPacket->mNum; ++s)
+	{
+		const RenderSprite *pSprite = pPacket->mpSprites + s;
+		const Vector2D *pPos = &pSprite->mPosition;
+		const Vector2D *pPrev = &pSprite->mPrevPosition;
+		float extent = pSprite->mExtent;
+		float x = pPrev->x + alpha * (pPos->x - pPrev->x);
+		float y = pPrev->y + alpha * (pPos->y - pPrev->y);
+
+		if (x + extent < MinX || x - extent > MaxX || y + extent < MinY || y - extent > MaxY)
+			continue;
+
+		// Only the sprites that moved in the last step need their translation moved
+		// back to in between the previous and the current position
+		world = pSprite->mTransform;
+
+		if (pPrev->x != pPos->x || pPrev->y != pPos->y)
+		{
+			Vector2D position, mapPosition;
+
+			position.x = x;
+			position.y = y;
+			Affine2DMultVec(&mapPosition, &pPacket->mMapTransform, &position);
+
+			world.m[0][2] = mapPosition.x;
+			world.m[1][2] = mapPosition.y;
+		}
+
+		SpriteBatchAdd(&sgBatch, pSprite->mShape, &world, pSprite->mColor);
+	}
+
+	SpriteBatchEnd(&sgBatch);
+}
+
+// ---------------------------------------------------------------------------
+
+void PlatformerRenderGetVisibleRect(const Affine2D *pMapTransform, float ScreenMinX, float ScreenMinY, float ScreenMaxX, float ScreenMaxY, float *pMinX, float *pMinY, float *pMaxX, float *pMaxY)
+{
+	Affine2D screenToMap;
+	Vector2D corners[4], mapCorner;
+	int c;
+
+	if (!Affine2DInverse(&screenToMap, pMapTransform))
+	{
+		*pMinX = *pMinY = *pMaxX = *pMaxY = 0.f;
+		return;
+	}
+
+	Vector2DSet(corners + 0, ScreenMinX, ScreenMinY);
+	Vector2DSet(corners + 1, ScreenMaxX, ScreenMinY);
+	Vector2DSet(corners + 2, ScreenMinX, ScreenMaxY);
+	Vector2DSet(corners + 3, ScreenMaxX, ScreenMaxY);
+
+	for (c = 0; c < 4; ++c)
+	{
+		Affine2DMultVec(&mapCorner, &screenToMap, corners + c);
+
+		if (c == 0 || mapCorner.x < *pMinX)
+			*pMinX = mapCorner.x;
+		if (c == 0 || mapCorner.x > *pMaxX)
+			*pMaxX = mapCorner.x;
+		if (c == 0 || mapCorner.y < *pMinY)
+			*pMinY = mapCorner.y;
+		if (c == 0 || mapCorner.y > *pMaxY)
+			*pMaxY = mapCorner.y;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+const SpriteBatch* PlatformerRenderGetBatch(void)
+{
+	return &sgBatch;
+}
+
+// ---------------------------------------------------------------------------
+
+void PlatformerRenderFree(void)
+{
+	SpriteBatchFree(&sgBatch);
+}
+
+// ---------------------------------------------------------------------------
+
+// Is a sprite of half size "Extent" outside [MinX, MaxX] x [MinY, MaxY] all the way
+// from (PrevX;PrevY) to (X;Y)?
+int IsMoveOutside(float X, float Y, float PrevX, float PrevY, float Extent, float MinX, float MinY, float MaxX, float MaxY)
+{
+	float moveMinX = X < PrevX ? X : PrevX;
+	float moveMaxX = X < PrevX ? PrevX : X;
+	float moveMinY = Y < PrevY ? Y : PrevY;
+	float moveMaxY = Y < PrevY ? PrevY : Y;
+
+	return moveMaxX + Extent < MinX || moveMinX - Extent > MaxX || moveMaxY + Extent < MinY || moveMinY - Extent > MaxY;
+}
+
+// ---------------------------------------------------------------------------
+
+// 1x1, centered on the origin
+void SetQuadShape(unsigned int Shape, unsigned int Color)
+{
+	SpriteVertex vertices[6] =
+	{
+		{ -0.5f, -0.5f, 0 }, { 0.5f, -0.5f, 0 }, { -0.5f, 0.5f, 0 },
+		{ -0.5f,  0.5f, 0 }, { 0.5f, -0.5f, 0 }, {  0.5f, 0.5f, 0 }
+	};
+	int v;
+
+	for (v = 0; v < 6; ++v)
+		vertices[v].mColor = Color;
+
+	SpriteBatchSetShape(&sgBatch, Shape, vertices, 2);
+}
+
+// ---------------------------------------------------------------------------
+
+// Diameter 1, centered on the origin
+void SetCircleShape(unsigned int Shape, unsigned int Color, int Parts)
+{
+	SpriteVertex vertices[SPRITE_BATCH_SHAPE_TRIANGLE_NUM_MAX * 3];
+	float circleAngleStep = PI / Parts;
+	int i;
+
+	for (i = 0; i < Parts; ++i)
+	{
+		SpriteVertex *pTriangle = vertices + i * 3;
+
+		pTriangle[0].mX = 0.0f;
+		pTriangle[0].mY = 0.0f;
+		pTriangle[1].mX = cosf(i * 2 * circleAngleStep) *0.5f;
+		pTriangle[1].mY = sinf(i * 2 * circleAngleStep) *0.5f;
+		pTriangle[2].mX = cosf((i + 1) * 2 * circleAngleStep) *0.5f;
+		pTriangle[2].mY = sinf((i + 1) * 2 * circleAngleStep) *0.5f;
+		pTriangle[0].mColor = pTriangle[1].mColor = pTriangle[2].mColor = Color;
+	}
+
+	SpriteBatchSetShape(&sgBatch, Shape, vertices, Parts);
+}
+
+// ---------------------------------------------------------------------------
+
+// The bottom left half of the 1x1 quad
+void SetTriangleShape(unsigned int Shape, unsigned int Color)
+{
+	SpriteVertex vertices[3] =
+	{
+		{ -0.5f, -0.5f, 0 }, { 0.5f, -0.5f, 0 }, { -0.5f, 0.5f, 0 }
+	};
+
+	vertices[0].mColor = vertices[1].mColor = vertices[2].mColor = Color;
+
+	SpriteBatchSetShape(&sgBatch, Shape, vertices, 1);
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,70 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	PlatformerRender.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	The shapes of the platformer's sprites, and the code that
+//						puts the simulation's instances and particles in a
+//						SpriteBatch. Shared by the game state and the headless
+//						runner
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- only the sprites in the visible rectangle are drawn
+//	- 2026/10/17	:	- the sprites are copied to a RenderPacket by the update,
+//						  the draw only reads the packet
+//	- 2026/10/17	:	- the capture takes the World it reads
+// ---------------------------------------------------------------------------
+
+#ifndef PLATFORMER_RENDER_H
+#define PLATFORMER_RENDER_H
+
+// ---------------------------------------------------------------------------
+
+#include "SpriteBatch.h"
+#include "RenderPacket.h"
+#include "PlatformerSim.h"
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function sets up the sprite batch and its shapes (one per OBJECT_TYPE that
+is drawn as a sprite). Returns 0 if the batch could not be allocated
+*/
+int PlatformerRenderInit(const SpriteBatchBackend *pBackend);
+
+/*
+This function copies the active instances and the particles to "pPacket", the
+ones that are in [MinX, MaxX] x [MinY, MaxY] (in map space) anywhere between their
+previous and their current position. "pMapTransform" takes map space to the
+screen, and must be the simulation's world transformation (see
+SimSetWorldTransform). It reads "pWorld": call it from its update
+*/
+void PlatformerRenderCapture(World *pWorld, RenderPacket *pPacket, const Affine2D *pMapTransform, float MinX, float MinY, float MaxX, float MaxY);
+
+/*
+This function draws the sprites of "pPacket", mAlpha of the way from their
+previous position to their current one. Sprites entirely outside [MinX, MaxX] x
+[MinY, MaxY] (in map space) are not submitted. It does not read the simulation
+*/
+void PlatformerRenderDraw(const RenderPacket *pPacket, float MinX, float MinY, float MaxX, float MaxY);
+
+/*
+This function computes the map space rectangle seen by the screen rectangle
+[ScreenMinX, ScreenMaxX] x [ScreenMinY, ScreenMaxY], through "pMapTransform"
+*/
+void PlatformerRenderGetVisibleRect(const Affine2D *pMapTransform, float ScreenMinX, float ScreenMinY, float ScreenMaxX, float ScreenMaxY, float *pMinX, float *pMinY, float *pMaxX, float *pMaxY);
+
+/*
+This function returns the batch, to read the counts of the last draw
+*/
+const SpriteBatch* PlatformerRenderGetBatch(void);
+
+/*
+This function frees the sprite batch
+*/
+void PlatformerRenderFree(void);
+
+// ---------------------------------------------------------------------------
+
+#endif // PLATFORMER_RENDER_H
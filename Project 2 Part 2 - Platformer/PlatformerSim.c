@@ -0,0 +1,1431 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	PlatformerSim.c
+// Author			:	Antoine Abi Chakra, Sean Higgins
+// Creation Date	:	2008/03/04
+// Purpose			:	Implementation of the headless platformer simulation
+// History			:
+//	- 2015/09/28	:	Turned into a step by step project.
+//  - 2015/12/10	:	Implemented C style component based architecture
+//  - 2026/10/17	:	Moved out of GameState_Platformer.c. Input and frame
+//						time now come from a SimBackend
+//  - 2026/10/17	:	Components are stored in one array per component type
+//						instead of being allocated one by one
+//  - 2026/10/17	:	Free instances are kept in a SlotPool instead of being
+//						searched for
+//  - 2026/10/17	:	The update passes walk a packed list of the active
+//						instances instead of every slot
+//  - 2026/10/17	:	The update passes are fused into one kernel per
+//						archetype, walking a packed list per object type
+//  - 2026/10/17	:	The map cells are no longer instances, the renderer
+//						draws them from the map data (see TileMapRender.c)
+//  - 2026/10/17	:	Entities are spawned chunk by chunk, as the map is
+//						streamed in around the hero
+//  - 2026/10/17	:	Particles are no longer instances, they live in a
+//						ParticleSystem
+//  - 2026/10/17	:	Transformations are built straight into an Affine2D,
+//						and only for the instances that moved
+//  - 2026/10/17	:	Positions are written through the transform setters.
+//						The world transformation is cached with the local one
+//  - 2026/10/17	:	The instances are filed in a SpatialGrid, to find the
+//						ones in a rectangle
+//  - 2026/10/17	:	Hero collisions are found by a Broadphase, with one
+//						callback per pair of types
+//  - 2026/10/17	:	Map collision sweeps the move (SweepInstanceBinaryMap)
+//						instead of checking hot spots at the end of it
+//  - 2026/10/17	:	The enemies' hot spots are checked in one batch
+//						(CheckInstancesBinaryMapCollision) before their update
+//  - 2026/10/17	:	The state of a level is kept in a World, one current
+//						world per thread. The random sequence is the world's
+//  - 2026/10/17	:	The World is passed to every function instead of
+//						being current
+//  - 2026/10/17	:	SimInit keeps a copy of what it set up, SimRestart
+//						copies it back instead of spawning the level again
+//  - 2026/10/17	:	The hero's contacts are resolved in slot order again,
+//						coins and enemies together
+//  - 2026/10/17	:	Entities are despawned with the chunk they came from,
+//						and picked up coins are not spawned again
+// ---------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "PlatformerSim.h"
+#include "Math2D.h"
+#include "Matrix2D.h"
+#include "BinaryMap.h"
+#include "Vector2D.h"
+#include "SlotPool.h"
+#include "ParticleSystem.h"
+#include "Broadphase.h"
+
+// ---------------------------------------------------------------------------
+
+#ifndef PI
+#define	PI		3.1415926f
+#endif
+
+//Gameplay related variables and values
+#define GRAVITY -20.0f
+#define JUMP_VELOCITY 11.0f
+#define MOVE_VELOCITY_HERO 4.0f
+#define MOVE_VELOCITY_ENEMY 7.5f
+#define ENEMY_IDLE_TIME 2.0
+#define HERO_LIVES 3
+#define SCREEN_X_SCALE 30
+#define SCREEN_Y_SCALE 30
+#define PARTICLE_LIFETIME 1.75f
+#define INSTANCE_GRID_CELL_SIZE 4.0f
+#define INSTANCE_PAIR_NUM_MAX 4096
+
+// ---------------------------------------------------------------------------
+
+//Component mask bits
+#define COMPONENT_SPRITE			0x01
+#define COMPONENT_TRANSFORM			0x02
+#define COMPONENT_PHYSICS			0x04
+#define COMPONENT_AI				0x08
+#define COMPONENT_MAP_COLLISION		0x10
+
+// Everything a level needs while it runs. Nothing is shared between two worlds
+struct World
+{
+	//Parent of the instances' mWorldTransform
+	Affine2D					mWorldTransform;
+
+	//State of the random sequence (particles), started from mRandomSeed by SimInit
+	unsigned int				mRandomSeed;
+	unsigned int				mRandom;
+
+	int							mHeroLives;
+	int							mHeroInitialX;
+	int							mHeroInitialY;
+	int							mCoinsCollected;
+	int							mSpawnFailNum;		// Chunks that could not be spawned, see SimStats
+
+	// list of object instances
+	GameObjectInstance			mGameObjectInstanceList[GAME_OBJ_INST_NUM_MAX];		// Each element in this array represents a unique game object instance
+	unsigned long				mGameObjectInstanceNum;								// The number of active game object instances
+
+	// Free list and generations of the instance slots
+	SlotPool					mInstancePool;
+	SlotPoolEntry				mInstancePoolEntries[GAME_OBJ_INST_NUM_MAX];
+
+	// Packed list of the active instances: the first mGameObjectInstanceNum elements are the
+	// slots of the active instances, in no particular order. Destroying an instance moves the
+	// last element in its place, so passes that destroy instances walk the list backwards.
+	unsigned int				mActiveList[GAME_OBJ_INST_NUM_MAX];
+	unsigned int				mActiveListIndex[GAME_OBJ_INST_NUM_MAX];			// Position of each active slot in mActiveList
+
+	// The same kind of packed list, one per object type, for the update kernels
+	unsigned int				mTypeLists[OBJECT_TYPE_NUM][GAME_OBJ_INST_NUM_MAX];
+	unsigned int				mTypeListNums[OBJECT_TYPE_NUM];
+	unsigned int				mTypeListIndex[GAME_OBJ_INST_NUM_MAX];				// Position of each active slot in its type list
+	unsigned char				mInstanceTypes[GAME_OBJ_INST_NUM_MAX];				// Object type of each active slot
+	int							mSpawnCellsX[GAME_OBJ_INST_NUM_MAX];				// Map cell each active slot was spawned from
+	int							mSpawnCellsY[GAME_OBJ_INST_NUM_MAX];
+
+	// Component storage: one array per component type, indexed like mGameObjectInstanceList.
+	// The index of an instance is its handle in every array, and does not change while the
+	// instance is alive. The update passes walk these arrays directly, using the masks to
+	// skip the instances that do not have the component.
+	Component_Sprite			mComponentSprites[GAME_OBJ_INST_NUM_MAX];
+	Component_Transform			mComponentTransforms[GAME_OBJ_INST_NUM_MAX];
+	Component_Physics			mComponentPhysics[GAME_OBJ_INST_NUM_MAX];
+	Component_AI				mComponentAIs[GAME_OBJ_INST_NUM_MAX];
+	Component_CollisionWithMap	mComponentMapCollisions[GAME_OBJ_INST_NUM_MAX];
+	unsigned char				mComponentMasks[GAME_OBJ_INST_NUM_MAX];			// COMPONENT_* bits of each instance, 0 when not active
+
+	// Platform functions (frame time, input)
+	SimBackend					mBackend;
+
+	//We need a pointer to the hero's instance for input purposes
+	GameObjectInstance			*mpHero;
+
+	//The jump and burn particles
+	ParticleSystem				mParticles;
+
+	//The instances by position, filed by slot. Its grid is queried by SimQueryInstances
+	Broadphase					mBroadphase;
+	unsigned int				mQuerySlots[GAME_OBJ_INST_NUM_MAX];
+
+	//The coins and enemies touching a hero, found by the broadphase, then again around
+	//the hero's start when an enemy sends it back. Each is hero slot * GAME_OBJ_INST_NUM_MAX
+	//+ instance slot, so sorting them gives the slot order of each hero's contacts
+	unsigned int				mHeroContacts[INSTANCE_PAIR_NUM_MAX];
+	unsigned int				mHeroContactNum;
+	unsigned int				mHeroRetests[GAME_OBJ_INST_NUM_MAX];
+
+	//The enemies' positions and scales, gathered for the batched map collision check,
+	//and its flags. Indexed like mTypeLists[OBJECT_TYPE_ENEMY1]
+	float						mEnemyPosX[GAME_OBJ_INST_NUM_MAX];
+	float						mEnemyPosY[GAME_OBJ_INST_NUM_MAX];
+	float						mEnemyScaleX[GAME_OBJ_INST_NUM_MAX];
+	float						mEnemyScaleY[GAME_OBJ_INST_NUM_MAX];
+	int							mEnemyMapFlags[GAME_OBJ_INST_NUM_MAX];
+
+	//The imported map
+	MapContext					*mpMap;
+
+	//Slots below it were used since SimInit, the others are as SimInit left them
+	unsigned int				mSlotEnd;
+
+	//The world as SimInit left it, and the map's streaming state then: SimRestart copies
+	//them back (see CopyInitialState). Allocated by SimLoad. The instances and pointers
+	//of the copy point into this world
+	World						*mpInitialState;
+	unsigned char				*mpInitialStreamState;
+	int							mInitialStateSaved;		// Set once SimInit filled them
+};
+
+// functions to create/destroy a game object instance
+static GameObjectInstance*			GameObjectInstanceCreate(World *pWorld, unsigned int ObjectType);			// From OBJECT_TYPE enum
+static void							GameObjectInstanceDestroy(World *pWorld, GameObjectInstance* pInst);
+
+// ---------------------------------------------------------------------------
+
+// Functions to add/remove components
+static void AddComponent_Transform(World *pWorld, GameObjectInstance *pInst, Vector2D *pPosition, float Angle, float ScaleX, float ScaleY);
+static void AddComponent_Sprite(World *pWorld, GameObjectInstance *pInst, unsigned int ShapeType);
+static void AddComponent_Physics(World *pWorld, GameObjectInstance *pInst, Vector2D *pVelocity);
+static void AddComponent_AI(World *pWorld, GameObjectInstance *pInst, double Counter, enum STATE State, enum INNER_STATE InnerState);
+static void AddComponent_MapCollision(World *pWorld, GameObjectInstance *pInst);
+
+static void RemoveComponent_Transform(World *pWorld, GameObjectInstance *pInst);
+static void RemoveComponent_Sprite(World *pWorld, GameObjectInstance *pInst);
+static void RemoveComponent_Physics(World *pWorld, GameObjectInstance *pInst);
+static void RemoveComponent_AI(World *pWorld, GameObjectInstance *pInst);
+static void RemoveComponent_MapCollision(World *pWorld, GameObjectInstance *pInst);
+
+// ---------------------------------------------------------------------------
+
+//The next number of the world's random sequence, from 0 to 32767
+static int SimRandom(World *pWorld);
+
+//State machine functions
+//"MapCollisionFlag" is the instance's hot spot check at its current position
+static void EnemyStateMachine(World *pWorld, GameObjectInstance *pInst, int MapCollisionFlag);
+
+//Create and destroy the entities of a chunk of the map, called by MapStreamFocus with the world
+static int SpawnMapChunk(void *pContext, int ChunkX, int ChunkY);
+static void DespawnMapChunk(void *pContext, int ChunkX, int ChunkY);
+
+//Update kernels, one per archetype
+static void UpdateHeroes(World *pWorld, double frameTime);
+static void UpdateEnemies(World *pWorld, double frameTime);
+static void UpdateHeroCollisions(World *pWorld);
+
+//Called by the broadphase with the world and the slots of a hero and of a coin or an enemy
+static void HeroContact(void *pContext, unsigned int Hero, unsigned int Other);
+
+//Narrowphase of the contacts, in slot order
+static void ResolveHeroContacts(World *pWorld, unsigned int Hero, const unsigned int *pContacts, unsigned int Num);
+static unsigned int FindHeroContacts(World *pWorld, unsigned int Hero, unsigned int FirstSlot);
+static void HeroCoinCollision(World *pWorld, unsigned int Hero, unsigned int Coin);
+static int HeroEnemyCollision(World *pWorld, unsigned int Hero, unsigned int Enemy);
+static int CompareContacts(const void *pA, const void *pB);
+
+static void ResolveMapCollision(World *pWorld, Vector2D *pPosition, float DeltaX, float DeltaY, float ScaleX, float ScaleY, Component_Physics *pPhysics, Component_CollisionWithMap *pMapCollision);
+static void BuildTransform(World *pWorld, Component_Transform *pTransform);
+
+//Copies what SimInit sets up from one world to the other, both loaded from the same map
+static void CopyInitialState(World *pDst, const World *pSrc);
+static void CopySlots(void *pDst, const void *pSrc, size_t ElementSize, unsigned int CopyNum, unsigned int ClearNum);
+static void FreeInitialState(World *pWorld);
+
+
+World* WorldCreate(void)
+{
+	World *pWorld = calloc(1, sizeof(World));
+
+	if (!pWorld)
+		return 0;
+
+	pWorld->mpMap = MapContextCreate();
+	if (!pWorld->mpMap)
+	{
+		free(pWorld);
+		return 0;
+	}
+
+	Affine2DIdentity(&pWorld->mWorldTransform);
+	pWorld->mRandomSeed = 1;
+	pWorld->mRandom = 1;
+
+	return pWorld;
+}
+
+// ---------------------------------------------------------------------------
+
+void WorldDestroy(World *pWorld)
+{
+	if (!pWorld)
+		return;
+
+	FreeInitialState(pWorld);
+	BroadphaseFree(&pWorld->mBroadphase);
+	MapContextDestroy(pWorld->mpMap);
+	free(pWorld);
+}
+
+// ---------------------------------------------------------------------------
+
+MapContext* SimGetMap(World *pWorld)
+{
+	return pWorld->mpMap;
+}
+
+// ---------------------------------------------------------------------------
+
+void SimSetBackend(World *pWorld, const SimBackend *pBackend)
+{
+	pWorld->mBackend = *pBackend;
+}
+
+// ---------------------------------------------------------------------------
+
+void SimSeedRandom(World *pWorld, unsigned int Seed)
+{
+	pWorld->mRandomSeed = Seed;
+	pWorld->mRandom = Seed;
+}
+
+// ---------------------------------------------------------------------------
+
+GameObjectInstance* SimGetInstances(World *pWorld)
+{
+	return pWorld->mGameObjectInstanceList;
+}
+
+// ---------------------------------------------------------------------------
+
+GameObjectInstance* SimGetHero(World *pWorld)
+{
+	return pWorld->mpHero;
+}
+
+// ---------------------------------------------------------------------------
+
+const ParticleSystem* SimGetParticles(const World *pWorld)
+{
+	return &pWorld->mParticles;
+}
+
+// ---------------------------------------------------------------------------
+
+unsigned long SimGetActiveInstanceNum(const World *pWorld)
+{
+	return pWorld->mGameObjectInstanceNum;
+}
+
+// ---------------------------------------------------------------------------
+
+GameObjectInstance* SimGetActiveInstance(World *pWorld, unsigned long Index)
+{
+	return pWorld->mGameObjectInstanceList + pWorld->mActiveList[Index];
+}
+
+// ---------------------------------------------------------------------------
+
+GameObjectHandle SimGetInstanceHandle(World *pWorld, GameObjectInstance *pInst)
+{
+	return SlotPoolGetHandle(&pWorld->mInstancePool, (unsigned int)(pInst - pWorld->mGameObjectInstanceList));
+}
+
+// ---------------------------------------------------------------------------
+
+GameObjectInstance* SimGetInstanceFromHandle(World *pWorld, GameObjectHandle Handle)
+{
+	unsigned int slot = SlotPoolGetSlot(&pWorld->mInstancePool, Handle);
+
+	return slot == SLOT_POOL_INVALID ? 0 : pWorld->mGameObjectInstanceList + slot;
+}
+
+// ---------------------------------------------------------------------------
+
+void SimGetStats(const World *pWorld, SimStats *pStats)
+{
+	pStats->mCoinNum = GetMapEntityNum(pWorld->mpMap, TYPE_OBJECT_COIN);
+	pStats->mCoinsLeft = pStats->mCoinNum - pWorld->mCoinsCollected;
+	pStats->mDeathNum = HERO_LIVES - pWorld->mHeroLives;
+	pStats->mSpawnFailNum = pWorld->mSpawnFailNum;
+}
+
+// ---------------------------------------------------------------------------
+
+int SimLoad(World *pWorld, char *pFileName)
+{
+	SlotPoolInit(&pWorld->mInstancePool, pWorld->mInstancePoolEntries, GAME_OBJ_INST_NUM_MAX);
+
+	// The copy of the previous level is never put back, even if this one fails to load
+	FreeInitialState(pWorld);
+
+	//Importing Data
+	if (!ImportMapDataFromFile(pWorld->mpMap, pFileName))
+		return 0;
+
+	BroadphaseFree(&pWorld->mBroadphase);
+	if (!BroadphaseInit(&pWorld->mBroadphase, 0.0f, 0.0f, (float)GetMapWidth(pWorld->mpMap), (float)GetMapHeight(pWorld->mpMap), INSTANCE_GRID_CELL_SIZE, GAME_OBJ_INST_NUM_MAX, INSTANCE_PAIR_NUM_MAX))
+	{
+		FreeMapData(pWorld->mpMap);
+		return 0;
+	}
+
+	// The broadphase only gathers the contacts: UpdateHeroCollisions resolves them in slot order
+	BroadphaseSetCallback(&pWorld->mBroadphase, OBJECT_TYPE_HERO, OBJECT_TYPE_COIN, HeroContact);
+	BroadphaseSetCallback(&pWorld->mBroadphase, OBJECT_TYPE_HERO, OBJECT_TYPE_ENEMY1, HeroContact);
+
+	// The copy SimInit fills for SimRestart, with tables of the same sizes
+	pWorld->mpInitialState = calloc(1, sizeof(World));
+	pWorld->mpInitialStreamState = malloc(GetMapStreamStateSize(pWorld->mpMap));
+	if (!pWorld->mpInitialState || !pWorld->mpInitialStreamState
+		|| !BroadphaseInit(&pWorld->mpInitialState->mBroadphase, 0.0f, 0.0f, (float)GetMapWidth(pWorld->mpMap), (float)GetMapHeight(pWorld->mpMap), INSTANCE_GRID_CELL_SIZE, GAME_OBJ_INST_NUM_MAX, INSTANCE_PAIR_NUM_MAX))
+	{
+		FreeInitialState(pWorld);
+		BroadphaseFree(&pWorld->mBroadphase);
+		FreeMapData(pWorld->mpMap);
+		return 0;
+	}
+	SlotPoolInit(&pWorld->mpInitialState->mInstancePool, pWorld->mpInitialState->mInstancePoolEntries, GAME_OBJ_INST_NUM_MAX);
+
+	return 1;
+}
+
+void SimSetWorldTransform(World *pWorld, const Affine2D *pTransform)
+{
+	unsigned long i;
+
+	pWorld->mWorldTransform = *pTransform;
+
+	// Every world transformation depends on it
+	for (i = 0; i < pWorld->mGameObjectInstanceNum; ++i)
+	{
+		Component_Transform *pTransform = pWorld->mComponentTransforms + pWorld->mActiveList[i];
+
+		pTransform->mDirty = 1;
+		BuildTransform(pWorld, pTransform);
+	}
+}
+
+void SimInit(World *pWorld)
+{
+	int heroX, heroY;
+
+	// zero the game object instance array and the component arrays
+	memset(pWorld->mGameObjectInstanceList, 0, sizeof(GameObjectInstance)* GAME_OBJ_INST_NUM_MAX);
+	memset(pWorld->mComponentSprites, 0, sizeof(pWorld->mComponentSprites));
+	memset(pWorld->mComponentTransforms, 0, sizeof(pWorld->mComponentTransforms));
+	memset(pWorld->mComponentPhysics, 0, sizeof(pWorld->mComponentPhysics));
+	memset(pWorld->mComponentAIs, 0, sizeof(pWorld->mComponentAIs));
+	memset(pWorld->mComponentMapCollisions, 0, sizeof(pWorld->mComponentMapCollisions));
+	memset(pWorld->mComponentMasks, 0, sizeof(pWorld->mComponentMasks));
+	SlotPoolReset(&pWorld->mInstancePool);
+	// No game object instances (sprites) at this point
+	pWorld->mGameObjectInstanceNum = 0;
+	pWorld->mSlotEnd = 0;
+	memset(pWorld->mTypeListNums, 0, sizeof(pWorld->mTypeListNums));
+	ParticleSystemReset(&pWorld->mParticles);
+	BroadphaseClear(&pWorld->mBroadphase);
+
+	pWorld->mpHero = 0;
+	pWorld->mCoinsCollected = 0;
+	pWorld->mSpawnFailNum = 0;
+	pWorld->mRandom = pWorld->mRandomSeed;
+
+	//Setting the inital number of hero lives
+	pWorld->mHeroLives = HERO_LIVES;
+
+	// Creating the main character, the enemies and the coins according to their initial positions in MapData
+	// (see SpawnMapChunk).
+	// The map cells are static: they are drawn straight from the map data and do not need instances
+
+	// Only the chunks around the hero are spawned now, the others when the hero gets close to them
+	MapStreamReset(pWorld->mpMap);
+
+	if (GetMapHeroStart(pWorld->mpMap, &heroX, &heroY))
+		MapStreamFocus(pWorld->mpMap, heroX + 0.5f, heroY + 0.5f, SpawnMapChunk, DespawnMapChunk, pWorld);
+
+	// What SimRestart puts back. There is nowhere to put it if SimLoad failed
+	if (pWorld->mpInitialState)
+	{
+		CopyInitialState(pWorld->mpInitialState, pWorld);
+		pWorld->mpInitialState->mWorldTransform = pWorld->mWorldTransform;
+		MapStreamSaveState(pWorld->mpMap, pWorld->mpInitialStreamState);
+		pWorld->mInitialStateSaved = 1;
+	}
+}
+
+void SimRestart(World *pWorld)
+{
+	// Nothing to copy back: the level is spawned again
+	if (!pWorld->mInitialStateSaved)
+	{
+		SimFree(pWorld);
+		SimInit(pWorld);
+		return;
+	}
+
+	CopyInitialState(pWorld, pWorld->mpInitialState);
+	MapStreamRestoreState(pWorld->mpMap, pWorld->mpInitialStreamState);
+	pWorld->mRandom = pWorld->mRandomSeed;
+
+	// The copied instances were built under the transformation SimInit had
+	if (memcmp(&pWorld->mWorldTransform, &pWorld->mpInitialState->mWorldTransform, sizeof(Affine2D)))
+		SimSetWorldTransform(pWorld, &pWorld->mWorldTransform);
+}
+
+void SimUpdate(World *pWorld)
+{
+	double frameTime;
+
+	// ======================
+	// Getting the frame time
+	// ======================
+
+	frameTime = pWorld->mBackend.GetFrameTime(pWorld->mBackend.mpContext);
+
+	// A map can have no hero: then there is nothing to page in around nor to control
+	if (pWorld->mpHero)
+	{
+		// Page in the map around the hero, spawning the entities of the chunks it gets close to
+		// and despawning those of the chunks it left behind
+		MapStreamFocus(pWorld->mpMap, pWorld->mpHero->mpComponent_Transform->mPosition.x, pWorld->mpHero->mpComponent_Transform->mPosition.y, SpawnMapChunk, DespawnMapChunk, pWorld);
+
+		// Control the hero's movement:
+		// -- If Left/Right are pressed: Set the hero velocity's X coordinate to -/+ MOVE_VELOCITY_HERO.
+		//    Set it to 0 when neither are pressed.
+		// -- If SPACE is pressed AND the hero is on a platform: Jump. Use "JUMP_VELOCITY" as the upward
+		//    jump velocity.
+
+		//INPUT CHECK HERE
+		if (pWorld->mBackend.CheckInputCurr(pWorld->mBackend.mpContext, SIM_INPUT_LEFT))
+		{
+			pWorld->mpHero->mpComponent_Physics->mVelocity.x = -1* MOVE_VELOCITY_HERO;
+		}
+		else if (pWorld->mBackend.CheckInputCurr(pWorld->mBackend.mpContext, SIM_INPUT_RIGHT))
+		{
+			pWorld->mpHero->mpComponent_Physics->mVelocity.x = MOVE_VELOCITY_HERO;
+		}
+		else
+		{
+			pWorld->mpHero->mpComponent_Physics->mVelocity.x = 0.f;
+		}
+
+		if (pWorld->mBackend.CheckInputTriggered(pWorld->mBackend.mpContext, SIM_INPUT_JUMP) && COLLISION_BOTTOM==(pWorld->mpHero->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_BOTTOM) )
+		{
+			pWorld->mpHero->mpComponent_Physics->mVelocity.y = JUMP_VELOCITY;
+
+		//Spawn 10-15 particles that shoot out from player in random dir. upon jumping
+			int numParticles = 10 + SimRandom(pWorld) % 5;
+			for (int i = 0; i < numParticles; i++)
+			{
+				 float angle = (180.f + SimRandom(pWorld) % 180)* PI / 180.f;  //Convert to radians
+				 ParticleSystemSpawn(&pWorld->mParticles, PARTICLE_TYPE_JUMP_EFFECT, pWorld->mpHero->mpComponent_Transform->mPosition.x, pWorld->mpHero->mpComponent_Transform->mPosition.y, cosf(angle), sinf(angle), GRAVITY);
+			}
+
+		}
+	}
+
+	// Each archetype is updated by its own kernel, which does the gravity, the integration,
+	// the map collision and the matrix of an instance in one go.
+	// Enemies go first, since they spawn burn particles that are updated on the same frame.
+	// The hero's matrix is built after the object collisions, which can move it back to
+	// its starting position.
+	UpdateEnemies(pWorld, frameTime);
+	UpdateHeroes(pWorld, frameTime);
+	UpdateHeroCollisions(pWorld);
+	ParticleSystemUpdate(&pWorld->mParticles, (float)frameTime, PARTICLE_LIFETIME);
+}
+
+// ---------------------------------------------------------------------------
+
+int SpawnMapChunk(void *pContext, int ChunkX, int ChunkY)
+{
+	World *pWorld = pContext;
+	int x, y, value;
+	GameObjectInstance* pCurr;
+
+	/***********
+	Loop through the cells of the chunk in MapData
+
+		 - if the element represents the hero
+			Create a hero instance
+			Set its position depending on its array indices in MapData
+			Save its array indices in mHeroInitialX and mHeroInitialY (Used when the hero dies and its position needs to be reset)
+
+		 - if the element represents an enemy or a coin
+			Create an enemy or a coin instance
+			Set its position depending on its array indices in MapData
+
+	***********/
+	for (x = ChunkX * MAP_CHUNK_SIZE; x < (ChunkX + 1) * MAP_CHUNK_SIZE && x < GetMapWidth(pWorld->mpMap); ++x)
+	{
+		for (y = ChunkY * MAP_CHUNK_SIZE; y < (ChunkY + 1) * MAP_CHUNK_SIZE && y < GetMapHeight(pWorld->mpMap); ++y)
+		{
+			value = GetMapDataValue(pWorld->mpMap, x, y);
+
+			if (value != OBJECT_TYPE_HERO && value != OBJECT_TYPE_ENEMY1 && value != OBJECT_TYPE_COIN)
+				continue;
+
+			// Picked up, or the hero that was already spawned
+			if (IsMapEntityRemoved(pWorld->mpMap, x, y))
+				continue;
+
+			pCurr = GameObjectInstanceCreate(pWorld, value);
+
+			// No slot left: take back what was spawned of the chunk, MapStreamFocus tries
+			// it again on the next update
+			if (!pCurr)
+			{
+				++pWorld->mSpawnFailNum;
+				DespawnMapChunk(pWorld, ChunkX, ChunkY);
+				return 0;
+			}
+
+			pWorld->mSpawnCellsX[pCurr - pWorld->mGameObjectInstanceList] = x;
+			pWorld->mSpawnCellsY[pCurr - pWorld->mGameObjectInstanceList] = y;
+
+			// The hero is never despawned, so never spawned again
+			if (value == OBJECT_TYPE_HERO)
+			{
+				pWorld->mpHero = pCurr;
+				pWorld->mHeroInitialX = x;
+				pWorld->mHeroInitialY = y;
+				MapStreamRemoveEntity(pWorld->mpMap, x, y);
+			}
+
+			SetTransformPosition(pWorld, pCurr->mpComponent_Transform, x + 0.5f, y + 0.5f);
+			pCurr->mpComponent_MapCollision->mMapCollisionFlag = 0;
+
+			// Only the moving archetypes rebuild their matrix each frame: build it once here,
+			// and start the interpolation from where the instance was placed
+			pCurr->mpComponent_Transform->mPrevPosition = pCurr->mpComponent_Transform->mPosition;
+			BuildTransform(pWorld, pCurr->mpComponent_Transform);
+		}
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+// Destroys the enemies and coins spawned from the chunk, wherever they are now. The
+// chunk spawns them again, where they started, when the hero comes back
+void DespawnMapChunk(void *pContext, int ChunkX, int ChunkY)
+{
+	static const unsigned int types[] = { OBJECT_TYPE_ENEMY1, OBJECT_TYPE_COIN };
+	World *pWorld = pContext;
+	unsigned int t, n;
+
+	for (t = 0; t < sizeof(types) / sizeof(types[0]); ++t)
+	{
+		// Backwards, since destroying an instance moves the last one of the list in its place
+		for (n = pWorld->mTypeListNums[types[t]]; n-- > 0; )
+		{
+			unsigned int i = pWorld->mTypeLists[types[t]][n];
+
+			if (pWorld->mSpawnCellsX[i] / MAP_CHUNK_SIZE == ChunkX && pWorld->mSpawnCellsY[i] / MAP_CHUNK_SIZE == ChunkY)
+				GameObjectInstanceDestroy(pWorld, pWorld->mGameObjectInstanceList + i);
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void UpdateHeroes(World *pWorld, double frameTime)
+{
+	unsigned int n;
+
+	for (n = 0; n < pWorld->mTypeListNums[OBJECT_TYPE_HERO]; ++n)
+	{
+		unsigned int i = pWorld->mTypeLists[OBJECT_TYPE_HERO][n];
+		Component_Transform *pTransform = pWorld->mComponentTransforms + i;
+		Component_Physics *pPhysics = pWorld->mComponentPhysics + i;
+		Component_CollisionWithMap *pMapCollision = pWorld->mComponentMapCollisions + i;
+		Vector2D position;
+
+		// Velocity (V1.y = GRAVITY*t + V0.y) and position (P1 = V1*t + P0)
+		pPhysics->mVelocity.y = pPhysics->mVelocity.y + GRAVITY * frameTime;
+
+		pTransform->mPrevPosition = pTransform->mPosition;
+		position = pTransform->mPosition;
+
+		ResolveMapCollision(pWorld, &position, (float)(frameTime* pPhysics->mVelocity.x), (float)(frameTime* pPhysics->mVelocity.y), pTransform->mScaleX, pTransform->mScaleY, pPhysics, pMapCollision);
+		SetTransformPosition(pWorld, pTransform, position.x, position.y);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void UpdateEnemies(World *pWorld, double frameTime)
+{
+	unsigned int n;
+	unsigned int enemyNum = pWorld->mTypeListNums[OBJECT_TYPE_ENEMY1];
+
+	//Each enemy only moves itself, so its hot spots can all be checked up front
+	for (n = 0; n < enemyNum; ++n)
+	{
+		Component_Transform *pTransform = pWorld->mComponentTransforms + pWorld->mTypeLists[OBJECT_TYPE_ENEMY1][n];
+
+		pWorld->mEnemyPosX[n] = pTransform->mPosition.x;
+		pWorld->mEnemyPosY[n] = pTransform->mPosition.y;
+		pWorld->mEnemyScaleX[n] = pTransform->mScaleX;
+		pWorld->mEnemyScaleY[n] = pTransform->mScaleY;
+	}
+
+	CheckInstancesBinaryMapCollision(pWorld->mpMap, pWorld->mEnemyPosX, pWorld->mEnemyPosY, pWorld->mEnemyScaleX, pWorld->mEnemyScaleY, pWorld->mEnemyMapFlags, enemyNum);
+
+	for (n = 0; n < enemyNum; ++n)
+	{
+		unsigned int i = pWorld->mTypeLists[OBJECT_TYPE_ENEMY1][n];
+		Component_Transform *pTransform = pWorld->mComponentTransforms + i;
+		Component_Physics *pPhysics = pWorld->mComponentPhysics + i;
+		Component_CollisionWithMap *pMapCollision = pWorld->mComponentMapCollisions + i;
+		Vector2D position;
+
+		pPhysics->mVelocity.y = pPhysics->mVelocity.y + GRAVITY * frameTime;
+
+		// The state machine sees last frame's map collision flags
+		EnemyStateMachine(pWorld, pWorld->mGameObjectInstanceList + i, pWorld->mEnemyMapFlags[n]);
+
+		pTransform->mPrevPosition = pTransform->mPosition;
+		position = pTransform->mPosition;
+
+		ResolveMapCollision(pWorld, &position, (float)(frameTime* pPhysics->mVelocity.x), (float)(frameTime* pPhysics->mVelocity.y), pTransform->mScaleX, pTransform->mScaleY, pPhysics, pMapCollision);
+		SetTransformPosition(pWorld, pTransform, position.x, position.y);
+
+		BuildTransform(pWorld, pTransform);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void UpdateHeroCollisions(World *pWorld)
+{
+	unsigned int c, next, n;
+
+	// -- Check for collision among objects instances.
+	//    Hero-Enemy intersection: Rectangle-Rectangle: The hero's position should be reset to its
+	//		initial value
+	//    Hero-Coin intersection: Rectangle-Circle: The coin should be deleted.
+	// The broadphase only hands over the pairs whose boxes overlap (see SimLoad for the callbacks)
+	pWorld->mHeroContactNum = 0;
+	BroadphaseUpdate(&pWorld->mBroadphase, pWorld);
+
+	// The instances are tested in slot order, coins and enemies together, like a loop over
+	// every slot would: an enemy that sends the hero back does so before the coins after it
+	// are tested
+	qsort(pWorld->mHeroContacts, pWorld->mHeroContactNum, sizeof(unsigned int), CompareContacts);
+
+	for (c = 0; c < pWorld->mHeroContactNum; c = next)
+	{
+		unsigned int hero = pWorld->mHeroContacts[c] / GAME_OBJ_INST_NUM_MAX;
+
+		for (next = c + 1; next < pWorld->mHeroContactNum && pWorld->mHeroContacts[next] / GAME_OBJ_INST_NUM_MAX == hero; ++next)
+			;
+
+		ResolveHeroContacts(pWorld, hero, pWorld->mHeroContacts + c, next - c);
+	}
+
+	for (n = 0; n < pWorld->mTypeListNums[OBJECT_TYPE_HERO]; ++n)
+	{
+		BuildTransform(pWorld, pWorld->mComponentTransforms + pWorld->mTypeLists[OBJECT_TYPE_HERO][n]);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void HeroContact(void *pContext, unsigned int Hero, unsigned int Other)
+{
+	World *pWorld = pContext;
+
+	if (pWorld->mHeroContactNum < INSTANCE_PAIR_NUM_MAX)
+		pWorld->mHeroContacts[pWorld->mHeroContactNum++] = Hero * GAME_OBJ_INST_NUM_MAX + Other;
+}
+
+// ---------------------------------------------------------------------------
+
+// "pContacts" are sorted, and all of "Hero"
+void ResolveHeroContacts(World *pWorld, unsigned int Hero, const unsigned int *pContacts, unsigned int Num)
+{
+	unsigned int k = 0;
+
+	while (k < Num)
+	{
+		unsigned int other = pContacts[k++] % GAME_OBJ_INST_NUM_MAX;
+
+		// Picked up by another hero
+		if (0 == (pWorld->mGameObjectInstanceList[other].mFlag & FLAG_ACTIVE))
+			continue;
+
+		if (pWorld->mInstanceTypes[other] == OBJECT_TYPE_COIN)
+			HeroCoinCollision(pWorld, Hero, other);
+		else if (HeroEnemyCollision(pWorld, Hero, other))
+		{
+			// The hero is back at its start: the instances after this enemy are tested
+			// there, and the contacts found where it was are dropped
+			Num = FindHeroContacts(pWorld, Hero, other + 1);
+			pContacts = pWorld->mHeroRetests;
+			k = 0;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+// Writes in mHeroRetests the contacts of "Hero" with the coins and enemies from "FirstSlot" up,
+// sorted like mHeroContacts, and returns how many there are
+unsigned int FindHeroContacts(World *pWorld, unsigned int Hero, unsigned int FirstSlot)
+{
+	Broadphase *pBroadphase = &pWorld->mBroadphase;
+	float x = pBroadphase->mpX[Hero];
+	float y = pBroadphase->mpY[Hero];
+	float reachX = pBroadphase->mpHalfWidths[Hero] + pBroadphase->mHalfSizeMax;
+	float reachY = pBroadphase->mpHalfHeights[Hero] + pBroadphase->mHalfSizeMax;
+	unsigned int i, num, contactNum = 0;
+
+	num = SpatialGridQuery(&pBroadphase->mGrid, x - reachX, y - reachY, x + reachX, y + reachY, pWorld->mQuerySlots, GAME_OBJ_INST_NUM_MAX);
+
+	for (i = 0; i < num; ++i)
+	{
+		unsigned int other = pWorld->mQuerySlots[i];
+		float dx = fabsf(pBroadphase->mpX[other] - x);
+		float dy = fabsf(pBroadphase->mpY[other] - y);
+
+		if (other < FirstSlot || (pWorld->mInstanceTypes[other] != OBJECT_TYPE_COIN && pWorld->mInstanceTypes[other] != OBJECT_TYPE_ENEMY1))
+			continue;
+
+		// The box test of the broadphase
+		if (dx <= pBroadphase->mpHalfWidths[Hero] + pBroadphase->mpHalfWidths[other] && dy <= pBroadphase->mpHalfHeights[Hero] + pBroadphase->mpHalfHeights[other])
+			pWorld->mHeroRetests[contactNum++] = Hero * GAME_OBJ_INST_NUM_MAX + other;
+	}
+
+	qsort(pWorld->mHeroRetests, contactNum, sizeof(unsigned int), CompareContacts);
+
+	return contactNum;
+}
+
+// ---------------------------------------------------------------------------
+
+void HeroCoinCollision(World *pWorld, unsigned int Hero, unsigned int Coin)
+{
+	Component_Transform *pHeroTransform = pWorld->mComponentTransforms + Hero;
+	Component_Transform *pTransform = pWorld->mComponentTransforms + Coin;
+
+	if (StaticCircleToStaticRectangle(&(pTransform->mPosition), pTransform->mScaleY/3, &(pHeroTransform->mPosition), pTransform->mScaleX, pHeroTransform->mScaleY))
+	{
+		++pWorld->mCoinsCollected;
+		//Play 'coin collected' particle effect here
+		MapStreamRemoveEntity(pWorld->mpMap, pWorld->mSpawnCellsX[Coin], pWorld->mSpawnCellsY[Coin]);
+		GameObjectInstanceDestroy(pWorld, pWorld->mGameObjectInstanceList + Coin);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+// Returns 1 if the enemy sent the hero back to its start
+int HeroEnemyCollision(World *pWorld, unsigned int Hero, unsigned int Enemy)
+{
+	Component_Transform *pHeroTransform = pWorld->mComponentTransforms + Hero;
+	Component_Transform *pTransform = pWorld->mComponentTransforms + Enemy;
+
+	if (StaticRectToStaticRect(&(pHeroTransform->mPosition), pHeroTransform->mScaleX, pHeroTransform->mScaleY, &(pTransform->mPosition), pTransform->mScaleX, pTransform->mScaleY))
+	{
+		pWorld->mHeroLives--;
+		SetTransformPosition(pWorld, pHeroTransform, (float)pWorld->mHeroInitialX, (float)pWorld->mHeroInitialY);
+		return 1;
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+int CompareContacts(const void *pA, const void *pB)
+{
+	unsigned int a = *(const unsigned int *)pA;
+	unsigned int b = *(const unsigned int *)pB;
+
+	return a < b ? -1 : a > b;
+}
+
+// ---------------------------------------------------------------------------
+
+// Moves *pPosition by (DeltaX;DeltaY), stopping it against the map
+void ResolveMapCollision(World *pWorld, Vector2D *pPosition, float DeltaX, float DeltaY, float ScaleX, float ScaleY, Component_Physics *pPhysics, Component_CollisionWithMap *pMapCollision)
+{
+	MapSweepResult sweep;
+
+	// -- Sweep the instance along its move, so it cannot go through a cell however fast it goes.
+	//    Store the bit field of the sides that hit in the instance's Component_CollisionWithMap.
+	// -- In case of a hit, set the respective velocity coordinate to 0. The sweep already stopped
+	//    the instance against the cell.
+	SweepInstanceBinaryMap(pWorld->mpMap, &(pPosition->x), &(pPosition->y), ScaleX, ScaleY, DeltaX, DeltaY, &sweep);
+	pMapCollision->mMapCollisionFlag = sweep.mFlag;
+
+	if (sweep.mFlag & (COLLISION_LEFT | COLLISION_RIGHT))
+		pPhysics->mVelocity.x = 0.f;
+
+	if (sweep.mFlag & (COLLISION_TOP | COLLISION_BOTTOM))
+		pPhysics->mVelocity.y = 0.f;
+}
+
+// ---------------------------------------------------------------------------
+
+// Writing the value it already has does not dirty the transformations: instances
+// standing still (idle enemies, the hero on the ground) are not rebuilt
+void SetTransformPosition(World *pWorld, Component_Transform *pTransform, float x, float y)
+{
+	if (pTransform->mPosition.x == x && pTransform->mPosition.y == y)
+		return;
+
+	pTransform->mPosition.x = x;
+	pTransform->mPosition.y = y;
+	pTransform->mDirty = 1;
+
+	BroadphaseMove(&pWorld->mBroadphase, (unsigned int)(pTransform - pWorld->mComponentTransforms), x, y);
+}
+
+// ---------------------------------------------------------------------------
+
+void SetTransformAngle(World *pWorld, Component_Transform *pTransform, float Angle)
+{
+	// The broadphase boxes stay axis aligned, so turning does not move them
+	(void)pWorld;
+
+	if (pTransform->mAngle == Angle)
+		return;
+
+	pTransform->mAngle = Angle;
+	pTransform->mDirty = 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void SetTransformScale(World *pWorld, Component_Transform *pTransform, float ScaleX, float ScaleY)
+{
+	if (pTransform->mScaleX == ScaleX && pTransform->mScaleY == ScaleY)
+		return;
+
+	pTransform->mScaleX = ScaleX;
+	pTransform->mScaleY = ScaleY;
+	pTransform->mDirty = 1;
+
+	BroadphaseSetBox(&pWorld->mBroadphase, (unsigned int)(pTransform - pWorld->mComponentTransforms), pWorld->mInstanceTypes[pTransform - pWorld->mComponentTransforms], ScaleX / 2.f, ScaleY / 2.f);
+}
+
+// ---------------------------------------------------------------------------
+
+void BuildTransform(World *pWorld, Component_Transform *pTransform)
+{
+	if (0 == pTransform->mDirty)
+		return;
+
+	Affine2DBuildTRS(&pTransform->mTransform, pTransform->mPosition.x, pTransform->mPosition.y, pTransform->mAngle, pTransform->mScaleX, pTransform->mScaleY);
+	Affine2DBuildParentTRS(&pTransform->mWorldTransform, &pWorld->mWorldTransform, pTransform->mPosition.x, pTransform->mPosition.y, pTransform->mAngle, pTransform->mScaleX, pTransform->mScaleY);
+	pTransform->mDirty = 0;
+}
+
+void SimFree(World *pWorld)
+{
+	//  -- Destroy all the active game object instances, using the "GameObjectInstanceDestroy" function.
+	//  -- Reset the number of active game objects instances
+
+	while (pWorld->mGameObjectInstanceNum > 0)
+	{
+		GameObjectInstanceDestroy(pWorld, pWorld->mGameObjectInstanceList + pWorld->mActiveList[pWorld->mGameObjectInstanceNum - 1]);
+	}
+
+}
+
+void SimUnload(World *pWorld)
+{
+	// -- Free the map data
+	FreeMapData(pWorld->mpMap);
+	BroadphaseFree(&pWorld->mBroadphase);
+	FreeInitialState(pWorld);
+}
+
+unsigned int SimQueryInstances(World *pWorld, float MinX, float MinY, float MaxX, float MaxY, GameObjectInstance **ppResults, unsigned int MaxResults)
+{
+	unsigned int i, num;
+
+	if (MaxResults > GAME_OBJ_INST_NUM_MAX)
+		MaxResults = GAME_OBJ_INST_NUM_MAX;
+
+	num = SpatialGridQuery(&pWorld->mBroadphase.mGrid, MinX, MinY, MaxX, MaxY, pWorld->mQuerySlots, MaxResults);
+
+	for (i = 0; i < num; ++i)
+		ppResults[i] = pWorld->mGameObjectInstanceList + pWorld->mQuerySlots[i];
+
+	return num;
+}
+
+
+GameObjectInstance* GameObjectInstanceCreate(World *pWorld, unsigned int ObjectType)			// From OBJECT_TYPE enum)
+{
+	unsigned int slot;
+	GameObjectInstance* pInst;
+
+	if (ObjectType >= OBJECT_TYPE_NUM)
+		return 0;
+
+	// take a non-used object instance from the free list
+	slot = SlotPoolAcquire(&pWorld->mInstancePool);
+
+	// Cannot find empty slot => return 0
+	if (slot == SLOT_POOL_INVALID)
+		return 0;
+
+	// SimRestart only looks at the slots used since SimInit
+	if (slot >= pWorld->mSlotEnd)
+		pWorld->mSlotEnd = slot + 1;
+
+	pInst = pWorld->mGameObjectInstanceList + slot;
+
+	// Active the game object instance
+	pInst->mFlag = FLAG_ACTIVE;
+
+	pInst->mpComponent_Transform = 0;
+	pInst->mpComponent_Sprite = 0;
+	pInst->mpComponent_Physics = 0;
+	pInst->mpComponent_AI = 0;
+	pInst->mpComponent_MapCollision = 0;
+
+	// Add the components, based on the object type
+	switch (ObjectType)
+	{
+	case OBJECT_TYPE_MAP_CELL_EMPTY:
+		AddComponent_Sprite(pWorld, pInst, OBJECT_TYPE_MAP_CELL_EMPTY);
+		AddComponent_Transform(pWorld, pInst, 0, 0.0f, 1.0f, 1.0f);
+		break;
+
+	case OBJECT_TYPE_MAP_CELL_COLLISION:
+		AddComponent_Sprite(pWorld, pInst, OBJECT_TYPE_MAP_CELL_COLLISION);
+		AddComponent_Transform(pWorld, pInst, 0, 0.0f, 1.0f, 1.0f);
+		break;
+
+	case OBJECT_TYPE_HERO:
+		AddComponent_Sprite(pWorld, pInst, OBJECT_TYPE_HERO);
+		AddComponent_Transform(pWorld, pInst, 0, 0.0f, 1.0f, 1.0f);
+		AddComponent_Physics(pWorld, pInst, 0);
+		AddComponent_MapCollision(pWorld, pInst);
+		break;
+
+	case OBJECT_TYPE_ENEMY1:
+		AddComponent_Sprite(pWorld, pInst, OBJECT_TYPE_ENEMY1);
+		AddComponent_Transform(pWorld, pInst, 0, 0.0f, 1.0f, 1.0f);
+		AddComponent_Physics(pWorld, pInst, 0);
+		AddComponent_AI(pWorld, pInst, 0, STATE_GOING_LEFT, INNER_STATE_ON_ENTER);
+		AddComponent_MapCollision(pWorld, pInst);
+		break;
+
+	case OBJECT_TYPE_COIN:
+		AddComponent_Sprite(pWorld, pInst, OBJECT_TYPE_COIN);
+		AddComponent_Transform(pWorld, pInst, 0, 0.0f, 1.0f, 1.0f);
+		AddComponent_Physics(pWorld, pInst, 0);
+		AddComponent_MapCollision(pWorld, pInst);
+		break;
+	}
+
+	// Append it to the active list
+	pWorld->mActiveListIndex[slot] = pWorld->mGameObjectInstanceNum;
+	pWorld->mActiveList[pWorld->mGameObjectInstanceNum] = slot;
+	++pWorld->mGameObjectInstanceNum;
+
+	// and to the list of its type
+	pWorld->mInstanceTypes[slot] = (unsigned char)ObjectType;
+	pWorld->mTypeListIndex[slot] = pWorld->mTypeListNums[ObjectType];
+	pWorld->mTypeLists[ObjectType][pWorld->mTypeListNums[ObjectType]] = slot;
+	++pWorld->mTypeListNums[ObjectType];
+
+	// and its box to the broadphase
+	BroadphaseSetBox(&pWorld->mBroadphase, slot, ObjectType, pInst->mpComponent_Transform->mScaleX / 2.f, pInst->mpComponent_Transform->mScaleY / 2.f);
+
+	// return the newly created instance
+	return pInst;
+}
+
+// ---------------------------------------------------------------------------
+
+void GameObjectInstanceDestroy(World *pWorld, GameObjectInstance* pInst)
+{
+	unsigned int slot, last, type;
+
+	// if instance is destroyed before, just return
+	if (pInst->mFlag == 0)
+		return;
+
+	slot = (unsigned int)(pInst - pWorld->mGameObjectInstanceList);
+
+	// Zero out the mFlag
+	pInst->mFlag = 0;
+
+	// Give the slot back to the free list
+	SlotPoolRelease(&pWorld->mInstancePool, slot);
+
+	// Move the last active instance in its place in the active list
+	--pWorld->mGameObjectInstanceNum;
+	last = pWorld->mActiveList[pWorld->mGameObjectInstanceNum];
+	pWorld->mActiveList[pWorld->mActiveListIndex[slot]] = last;
+	pWorld->mActiveListIndex[last] = pWorld->mActiveListIndex[slot];
+
+	// Same for the list of its type
+	type = pWorld->mInstanceTypes[slot];
+	--pWorld->mTypeListNums[type];
+	last = pWorld->mTypeLists[type][pWorld->mTypeListNums[type]];
+	pWorld->mTypeLists[type][pWorld->mTypeListIndex[slot]] = last;
+	pWorld->mTypeListIndex[last] = pWorld->mTypeListIndex[slot];
+
+	RemoveComponent_Transform(pWorld, pInst);
+	RemoveComponent_Sprite(pWorld, pInst);
+	RemoveComponent_Physics(pWorld, pInst);
+	RemoveComponent_AI(pWorld, pInst);
+	RemoveComponent_MapCollision(pWorld, pInst);
+}
+
+// ---------------------------------------------------------------------------
+
+void AddComponent_Transform(World *pWorld, GameObjectInstance *pInst, Vector2D *pPosition, float Angle, float ScaleX, float ScaleY)
+{
+	if (0 != pInst)
+	{
+		if (0 == pInst->mpComponent_Transform)
+		{
+			pInst->mpComponent_Transform = pWorld->mComponentTransforms + (pInst - pWorld->mGameObjectInstanceList);
+			memset(pInst->mpComponent_Transform, 0, sizeof(Component_Transform));
+			pWorld->mComponentMasks[pInst - pWorld->mGameObjectInstanceList] |= COMPONENT_TRANSFORM;
+		}
+
+		Vector2D zeroVec2;
+		Vector2DZero(&zeroVec2);
+
+		pInst->mpComponent_Transform->mScaleX = ScaleX;
+		pInst->mpComponent_Transform->mScaleY = ScaleY;
+		pInst->mpComponent_Transform->mPosition = pPosition ? *pPosition : zeroVec2;;
+		pInst->mpComponent_Transform->mPrevPosition = pInst->mpComponent_Transform->mPosition;
+		pInst->mpComponent_Transform->mAngle = Angle;
+		pInst->mpComponent_Transform->mDirty = 1;
+		pInst->mpComponent_Transform->mpOwner = pInst;
+
+		BroadphaseMove(&pWorld->mBroadphase, (unsigned int)(pInst - pWorld->mGameObjectInstanceList), pInst->mpComponent_Transform->mPosition.x, pInst->mpComponent_Transform->mPosition.y);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void AddComponent_Sprite(World *pWorld, GameObjectInstance *pInst, unsigned int ShapeType)
+{
+	if (0 != pInst)
+	{
+		if (0 == pInst->mpComponent_Sprite)
+		{
+			pInst->mpComponent_Sprite = pWorld->mComponentSprites + (pInst - pWorld->mGameObjectInstanceList);
+			memset(pInst->mpComponent_Sprite, 0, sizeof(Component_Sprite));
+			pWorld->mComponentMasks[pInst - pWorld->mGameObjectInstanceList] |= COMPONENT_SPRITE;
+		}
+
+		pInst->mpComponent_Sprite->mShapeType = ShapeType;
+		pInst->mpComponent_Sprite->mpOwner = pInst;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void AddComponent_Physics(World *pWorld, GameObjectInstance *pInst, Vector2D *pVelocity)
+{
+	if (0 != pInst)
+	{
+		if (0 == pInst->mpComponent_Physics)
+		{
+			pInst->mpComponent_Physics = pWorld->mComponentPhysics + (pInst - pWorld->mGameObjectInstanceList);
+			memset(pInst->mpComponent_Physics, 0, sizeof(Component_Physics));
+			pWorld->mComponentMasks[pInst - pWorld->mGameObjectInstanceList] |= COMPONENT_PHYSICS;
+		}
+
+		Vector2D zeroVec2;
+		Vector2DZero(&zeroVec2);
+
+		pInst->mpComponent_Physics->mVelocity = pVelocity ? *pVelocity : zeroVec2;
+		pInst->mpComponent_Physics->mpOwner = pInst;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void AddComponent_AI(World *pWorld, GameObjectInstance *pInst, double Counter, enum STATE State, enum INNER_STATE InnerState)
+{
+	if (0 != pInst)
+	{
+		if (0 == pInst->mpComponent_AI)
+		{
+			pInst->mpComponent_AI = pWorld->mComponentAIs + (pInst - pWorld->mGameObjectInstanceList);
+			memset(pInst->mpComponent_AI, 0, sizeof(Component_AI));
+			pWorld->mComponentMasks[pInst - pWorld->mGameObjectInstanceList] |= COMPONENT_AI;
+		}
+
+		pInst->mpComponent_AI->mCounter = Counter;
+		pInst->mpComponent_AI->mState = State;
+		pInst->mpComponent_AI->mInnerState = InnerState;
+		pInst->mpComponent_AI->mpOwner = pInst;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void AddComponent_MapCollision(World *pWorld, GameObjectInstance *pInst)
+{
+	if (0 != pInst)
+	{
+		if (0 == pInst->mpComponent_MapCollision)
+		{
+			pInst->mpComponent_MapCollision = pWorld->mComponentMapCollisions + (pInst - pWorld->mGameObjectInstanceList);
+			memset(pInst->mpComponent_MapCollision, 0, sizeof(Component_CollisionWithMap));
+			pWorld->mComponentMasks[pInst - pWorld->mGameObjectInstanceList] |= COMPONENT_MAP_COLLISION;
+		}
+
+		pInst->mpComponent_MapCollision->mMapCollisionFlag = 0;
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void RemoveComponent_Transform(World *pWorld, GameObjectInstance *pInst)
+{
+	if (0 != pInst)
+	{
+		if (0 != pInst->mpComponent_Transform)
+		{
+			pWorld->mComponentMasks[pInst - pWorld->mGameObjectInstanceList] &= ~COMPONENT_TRANSFORM;
+			BroadphaseRemove(&pWorld->mBroadphase, (unsigned int)(pInst - pWorld->mGameObjectInstanceList));
+			pInst->mpComponent_Transform = 0;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void RemoveComponent_Sprite(World *pWorld, GameObjectInstance *pInst)
+{
+	if (0 != pInst)
+	{
+		if (0 != pInst->mpComponent_Sprite)
+		{
+			pWorld->mComponentMasks[pInst - pWorld->mGameObjectInstanceList] &= ~COMPONENT_SPRITE;
+			pInst->mpComponent_Sprite = 0;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void RemoveComponent_Physics(World *pWorld, GameObjectInstance *pInst)
+{
+	if (0 != pInst)
+	{
+		if (0 != pInst->mpComponent_Physics)
+		{
+			pWorld->mComponentMasks[pInst - pWorld->mGameObjectInstanceList] &= ~COMPONENT_PHYSICS;
+			pInst->mpComponent_Physics = 0;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void RemoveComponent_AI(World *pWorld, GameObjectInstance *pInst)
+{
+	if (0 != pInst)
+	{
+		if (0 != pInst->mpComponent_AI)
+		{
+			pWorld->mComponentMasks[pInst - pWorld->mGameObjectInstanceList] &= ~COMPONENT_AI;
+			pInst->mpComponent_AI = 0;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void RemoveComponent_MapCollision(World *pWorld, GameObjectInstance *pInst)
+{
+	if (0 != pInst)
+	{
+		if (0 != pInst->mpComponent_MapCollision)
+		{
+			pWorld->mComponentMasks[pInst - pWorld->mGameObjectInstanceList] &= ~COMPONENT_MAP_COLLISION;
+			pInst->mpComponent_MapCollision = 0;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void EnemyStateMachine(World *pWorld, GameObjectInstance *pInst, int MapCollisionFlag)
+{
+	// -- Each enemy's current movement status is controlled by its "state", "innerState" and
+	//    "counter" member variables.
+	//    Refer to the provided enemy movement flowchart.
+	float frametime = pWorld->mBackend.GetFrameTime(pWorld->mBackend.mpContext);
+
+	if (pInst->mpComponent_AI->mState == STATE_NONE)
+	{
+		pInst->mpComponent_AI->mState = STATE_GOING_LEFT;
+		pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_ENTER;
+	}
+
+	if (pInst->mpComponent_AI->mState == STATE_GOING_LEFT)
+	{
+		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_ENTER)
+		{
+			pInst->mpComponent_Physics->mVelocity.x = -1 * MOVE_VELOCITY_ENEMY;
+			pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_UPDATE;
+		}
+
+		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_UPDATE)
+		{
+			if (GetCellValue(pWorld->mpMap, pInst->mpComponent_Transform->mPosition.x - 1, pInst->mpComponent_Transform->mPosition.y - 1)==0 || (pInst->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_LEFT)==COLLISION_LEFT)
+			{
+				pInst->mpComponent_Physics->mVelocity.x = 0.f;
+				pInst->mpComponent_AI->mCounter = 2.f;
+				pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_EXIT;
+			}
+
+		}
+
+		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_EXIT)
+		{
+			pInst->mpComponent_AI->mCounter -= frametime;
+			//The burn particles drift up and sideways. They start with the speed the
+			//first half step of gravity would give them, and keep it
+			float burnX = pInst->mpComponent_Transform->mPosition.x + (-1 + SimRandom(pWorld) % 3) / 2.f;
+			ParticleSystemSpawn(&pWorld->mParticles, PARTICLE_TYPE_ENEMY_BURN, burnX, pInst->mpComponent_Transform->mPosition.y + 0.25f, (-1 + SimRandom(pWorld) % 3) / 30.f, -GRAVITY * frametime / 2.f, 0.f);
+			if (pInst->mpComponent_AI->mCounter <= 0)
+			{
+				pInst->mpComponent_AI->mState = STATE_GOING_RIGHT;
+				pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_ENTER;
+			}
+		}
+	}
+
+	else if (pInst->mpComponent_AI->mState == STATE_GOING_RIGHT)
+	{
+
+		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_ENTER)
+		{
+			pInst->mpComponent_Physics->mVelocity.x =  MOVE_VELOCITY_ENEMY;
+			pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_UPDATE;
+		}
+
+		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_UPDATE)
+		{
+			pInst->mpComponent_MapCollision->mMapCollisionFlag = MapCollisionFlag;
+
+			if (GetCellValue(pWorld->mpMap, pInst->mpComponent_Transform->mPosition.x + 1, pInst->mpComponent_Transform->mPosition.y - 1) ==0 || (pInst->mpComponent_MapCollision->mMapCollisionFlag & COLLISION_RIGHT)==COLLISION_RIGHT)
+			{
+				pInst->mpComponent_Physics->mVelocity.x = 0.f;
+				pInst->mpComponent_AI->mCounter = 2.f;
+				pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_EXIT;
+			}
+
+		}
+
+		if (pInst->mpComponent_AI->mInnerState == INNER_STATE_ON_EXIT)
+		{
+			pInst->mpComponent_AI->mCounter -= frametime;
+			//The burn particles drift up and sideways. They start with the speed the
+			//first half step of gravity would give them, and keep it
+			float burnX = pInst->mpComponent_Transform->mPosition.x + (-1 + SimRandom(pWorld) % 3) / 2.f;
+			ParticleSystemSpawn(&pWorld->mParticles, PARTICLE_TYPE_ENEMY_BURN, burnX, pInst->mpComponent_Transform->mPosition.y + 0.25f, (-1 + SimRandom(pWorld) % 3) / 30.f, -GRAVITY * frametime / 2.f, 0.f);
+			if (pInst->mpComponent_AI->mCounter <= 0)
+			{
+				pInst->mpComponent_AI->mState = STATE_GOING_LEFT;
+				pInst->mpComponent_AI->mInnerState = INNER_STATE_ON_ENTER;
+			}
+		}
+	}
+
+}
+
+// ---------------------------------------------------------------------------
+
+// The same linear congruential generator as the Microsoft C runtime's rand(), so every
+// platform gets the same particles from the same seed
+int SimRandom(World *pWorld)
+{
+	pWorld->mRandom = pWorld->mRandom * 214013u + 2531011u;
+
+	return (int)((pWorld->mRandom >> 16) & 0x7FFF);
+}
+
+// ---------------------------------------------------------------------------
+
+// The instances and the pointers of the copy are left pointing into the world the copy
+// was made from: copied back, they point into it again
+void CopyInitialState(World *pDst, const World *pSrc)
+{
+	unsigned int slotNum = pSrc->mSlotEnd;
+	unsigned int clearNum = pDst->mSlotEnd > slotNum ? pDst->mSlotEnd - slotNum : 0;
+	unsigned int t;
+
+	// The slots pSrc used, then the ones only pDst used, cleared like SimInit does
+	CopySlots(pDst->mGameObjectInstanceList, pSrc->mGameObjectInstanceList, sizeof(GameObjectInstance), slotNum, clearNum);
+	CopySlots(pDst->mComponentSprites, pSrc->mComponentSprites, sizeof(Component_Sprite), slotNum, clearNum);
+	CopySlots(pDst->mComponentTransforms, pSrc->mComponentTransforms, sizeof(Component_Transform), slotNum, clearNum);
+	CopySlots(pDst->mComponentPhysics, pSrc->mComponentPhysics, sizeof(Component_Physics), slotNum, clearNum);
+	CopySlots(pDst->mComponentAIs, pSrc->mComponentAIs, sizeof(Component_AI), slotNum, clearNum);
+	CopySlots(pDst->mComponentMapCollisions, pSrc->mComponentMapCollisions, sizeof(Component_CollisionWithMap), slotNum, clearNum);
+	CopySlots(pDst->mComponentMasks, pSrc->mComponentMasks, sizeof(unsigned char), slotNum, clearNum);
+	memcpy(pDst->mActiveListIndex, pSrc->mActiveListIndex, slotNum * sizeof(unsigned int));
+	memcpy(pDst->mTypeListIndex, pSrc->mTypeListIndex, slotNum * sizeof(unsigned int));
+	memcpy(pDst->mInstanceTypes, pSrc->mInstanceTypes, slotNum * sizeof(unsigned char));
+	memcpy(pDst->mSpawnCellsX, pSrc->mSpawnCellsX, slotNum * sizeof(int));
+	memcpy(pDst->mSpawnCellsY, pSrc->mSpawnCellsY, slotNum * sizeof(int));
+
+	memcpy(pDst->mActiveList, pSrc->mActiveList, pSrc->mGameObjectInstanceNum * sizeof(unsigned int));
+	pDst->mGameObjectInstanceNum = pSrc->mGameObjectInstanceNum;
+
+	for (t = 0; t < OBJECT_TYPE_NUM; ++t)
+	{
+		memcpy(pDst->mTypeLists[t], pSrc->mTypeLists[t], pSrc->mTypeListNums[t] * sizeof(unsigned int));
+		pDst->mTypeListNums[t] = pSrc->mTypeListNums[t];
+	}
+
+	SlotPoolCopy(&pDst->mInstancePool, &pSrc->mInstancePool, slotNum + clearNum);
+	BroadphaseCopy(&pDst->mBroadphase, &pSrc->mBroadphase, slotNum + clearNum);
+
+	// SimInit leaves no particles
+	ParticleSystemReset(&pDst->mParticles);
+
+	pDst->mpHero = pSrc->mpHero;
+	pDst->mHeroLives = pSrc->mHeroLives;
+	pDst->mHeroInitialX = pSrc->mHeroInitialX;
+	pDst->mHeroInitialY = pSrc->mHeroInitialY;
+	pDst->mCoinsCollected = pSrc->mCoinsCollected;
+	pDst->mSpawnFailNum = pSrc->mSpawnFailNum;
+	pDst->mSlotEnd = slotNum;
+}
+
+// ---------------------------------------------------------------------------
+
+void CopySlots(void *pDst, const void *pSrc, size_t ElementSize, unsigned int CopyNum, unsigned int ClearNum)
+{
+	memcpy(pDst, pSrc, CopyNum * ElementSize);
+	memset((char *)pDst + CopyNum * ElementSize, 0, ClearNum * ElementSize);
+}
+
+// ---------------------------------------------------------------------------
+
+void FreeInitialState(World *pWorld)
+{
+	if (pWorld->mpInitialState)
+		BroadphaseFree(&pWorld->mpInitialState->mBroadphase);
+
+	free(pWorld->mpInitialState);
+	free(pWorld->mpInitialStreamState);
+	pWorld->mpInitialState = 0;
+	pWorld->mpInitialStreamState = 0;
+	pWorld->mInitialStateSaved = 0;
+}
+
+// ---------------------------------------------------------------------------
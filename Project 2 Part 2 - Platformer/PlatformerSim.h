@@ -0,0 +1,268 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	PlatformerSim.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Header file of the headless platformer simulation
+// History			:
+//	- 2026/10/17	:	Split out of GameState_Platformer.c so the gameplay
+//						can run without the Alpha Engine.
+//	- 2026/10/17	:	Particles moved to a ParticleSystem
+//	- 2026/10/17	:	Instance transformations are Affine2D, rebuilt only when dirty
+//	- 2026/10/17	:	Transform setters, and a cached world transformation
+//	- 2026/10/17	:	SimQueryInstances
+//	- 2026/10/17	:	Worlds, SimSeedRandom and SimGetStats
+//	- 2026/10/17	:	Every function takes its World, the backend a context
+//	- 2026/10/17	:	SimRestart
+//	- 2026/10/17	:	SimStats counts the chunks that could not be spawned
+// ---------------------------------------------------------------------------
+
+#ifndef PLATFORMER_SIM_H
+#define PLATFORMER_SIM_H
+
+// ---------------------------------------------------------------------------
+
+#include "Vector2D.h"
+#include "Matrix2D.h"
+#include "Affine2D.h"
+#include "ParticleSystem.h"
+#include "BinaryMap.h"
+
+// ---------------------------------------------------------------------------
+
+#define GAME_OBJ_INST_NUM_MAX		2048				// The total number of different game object instances
+
+//Flags
+#define FLAG_ACTIVE			0x00000001
+
+
+enum OBJECT_TYPE
+{
+	OBJECT_TYPE_MAP_CELL_EMPTY,			//0
+	OBJECT_TYPE_MAP_CELL_COLLISION,		//1
+	OBJECT_TYPE_HERO,					//2
+	OBJECT_TYPE_ENEMY1,					//3
+	OBJECT_TYPE_COIN,					//4
+	PARTICLE_TYPE_JUMP_EFFECT,			//5
+	PARTICLE_TYPE_ENEMY_BURN,			//6
+
+	OBJECT_TYPE_NUM
+};
+
+//State machine states
+enum STATE
+{
+	STATE_NONE,
+	STATE_GOING_LEFT,
+	STATE_GOING_RIGHT
+};
+
+//State machine inner states
+enum INNER_STATE
+{
+	INNER_STATE_ON_ENTER,
+	INNER_STATE_ON_UPDATE,
+	INNER_STATE_ON_EXIT
+};
+
+//Inputs the simulation asks the backend about
+enum SIM_INPUT
+{
+	SIM_INPUT_LEFT,
+	SIM_INPUT_RIGHT,
+	SIM_INPUT_JUMP,
+	SIM_INPUT_NUM
+};
+
+// Struct/Class definitions
+
+typedef struct GameObjectInstance GameObjectInstance;			// Forward declaration needed, since components need to point to their owner "GameObjectInstance"
+
+typedef unsigned int GameObjectHandle;							// Index and generation of an instance (see SlotPool.h)
+
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+	unsigned long			mShapeType;		// Index of the shape to draw, from OBJECT_TYPE enum
+
+	GameObjectInstance *	mpOwner;			// This component's owner
+}Component_Sprite;
+
+// ---------------------------------------------------------------------------
+
+//Write mPosition, mAngle and mScaleX/Y with the SetTransform* functions, which set mDirty
+typedef struct
+{
+	Vector2D					mPosition;		// Current position
+	Vector2D					mPrevPosition;	// Position before the last update, used to interpolate the drawing
+	float					mAngle;			// Current angle
+	float					mScaleX;		// Current X scaling value
+	float					mScaleY;		// Current Y scaling value
+
+	Affine2D					mTransform;		// Object transformation: Translate * Rotate * Scale, rebuilt when mDirty is set
+	Affine2D					mWorldTransform;	// The world transformation (see SimSetWorldTransform) * mTransform
+	unsigned int			mDirty;			// Set when the position, angle or scale changed since the transformations were built
+
+	GameObjectInstance *	mpOwner;		// This component's owner
+}Component_Transform;
+
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+	Vector2D					mVelocity;		// Current velocity
+
+	GameObjectInstance *	mpOwner;		// This component's owner
+}Component_Physics;
+
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+	double					mCounter;		// Counter, used to wait before switching movement direction
+	enum STATE				mState;			// Going left or right?
+	enum INNER_STATE		mInnerState;	// On enter, On update or On exit?
+
+	GameObjectInstance *	mpOwner;		// This component's owner
+}Component_AI;
+
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+	unsigned int			mMapCollisionFlag;	// Bitfield, where each bit represents 1 side of the object
+
+	GameObjectInstance *	mpOwner;			// This component's owner
+}Component_CollisionWithMap;
+
+// ---------------------------------------------------------------------------
+
+//Game object instance structure
+//The component pointers point into the simulation's component arrays (0 when the
+//instance does not have the component); they stay valid while the instance is alive
+struct GameObjectInstance
+{
+	unsigned long				mFlag;						// Bit mFlag, used to indicate if the object instance is active or not
+
+	Component_Sprite			*mpComponent_Sprite;		// Sprite component
+	Component_Transform			*mpComponent_Transform;		// Transform component
+	Component_Physics			*mpComponent_Physics;		// Physics component
+	Component_AI				*mpComponent_AI;			// AI, used by the enemy instances
+	Component_CollisionWithMap	*mpComponent_MapCollision;	// Used by object instances that collides with the map
+};
+
+// ---------------------------------------------------------------------------
+
+/*
+Everything the simulation needs from the platform it runs on.
+The game state fills this with Alpha Engine calls, the headless runner with
+a fixed time step and scripted input.
+*/
+typedef struct
+{
+	double	(*GetFrameTime)(void *pContext);							// Time step of the current update, in seconds
+	int		(*CheckInputCurr)(void *pContext, unsigned int Input);		// From SIM_INPUT enum: is the input held?
+	int		(*CheckInputTriggered)(void *pContext, unsigned int Input);	// From SIM_INPUT enum: was the input pressed this frame?
+	void	*mpContext;													// Passed to the functions above
+}SimBackend;
+
+// ---------------------------------------------------------------------------
+
+/*
+A level's whole state: its instances, components, particles, map and random
+sequence. Every Sim* function takes the world it works on, and nothing is shared
+between two worlds: threads with their own world can run levels at the same time
+*/
+typedef struct World World;
+
+// What a run of the level came to, see SimGetStats
+typedef struct
+{
+	int		mCoinNum;			// Coins in the map
+	int		mCoinsLeft;			// Coins not picked up yet
+	int		mDeathNum;			// Times the hero was sent back to its start
+	int		mSpawnFailNum;		// Times a chunk's entities did not fit in the free instance slots.
+								// The chunk is tried again on the next update
+}SimStats;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+// Allocates an empty world, with its own map (see MapContextCreate). Returns 0 if it
+// could not be allocated
+World* WorldCreate(void);
+
+// Frees the world, its map and what SimLoad allocated for it. Call SimFree first if
+// SimInit was called
+void WorldDestroy(World *pWorld);
+
+// The world's map, for the BinaryMap functions
+MapContext* SimGetMap(World *pWorld);
+
+// Sets the backend used by SimUpdate. Must be called before SimInit
+void SimSetBackend(World *pWorld, const SimBackend *pBackend);
+
+// Sets where the random sequence (particles) starts. SimInit starts it over, so every
+// run of a level from the same seed is the same. The seed is 1 until it is set
+void SimSeedRandom(World *pWorld, unsigned int Seed);
+
+// Imports the map. Returns 0 if the file could not be read
+int SimLoad(World *pWorld, char *pFileName);
+
+// Sets the transformation every instance's mWorldTransform is built under (the map
+// transformation when drawing). The identity until it is set
+void SimSetWorldTransform(World *pWorld, const Affine2D *pTransform);
+
+void SimInit(World *pWorld);
+
+// Puts the level back as the last SimInit left it, in place of SimFree then SimInit:
+// the state SimInit spawned is copied back instead of being spawned again, and only
+// the instances made since are cleared. The random sequence starts over from the
+// seed. Without a copy (no SimInit since SimLoad, or SimLoad failed) it does SimFree
+// then SimInit
+void SimRestart(World *pWorld);
+
+void SimUpdate(World *pWorld);
+void SimFree(World *pWorld);
+void SimUnload(World *pWorld);
+
+// The whole instance array (GAME_OBJ_INST_NUM_MAX elements), active or not
+GameObjectInstance* SimGetInstances(World *pWorld);
+
+// The number of active instances
+unsigned long SimGetActiveInstanceNum(const World *pWorld);
+
+// The active instance at "Index" (0 to SimGetActiveInstanceNum(pWorld) - 1). Creating and
+// destroying instances changes the order
+GameObjectInstance* SimGetActiveInstance(World *pWorld, unsigned long Index);
+
+// The hero's instance, 0 if the map has none
+GameObjectInstance* SimGetHero(World *pWorld);
+
+// The particles, which are not instances. Their mType is from OBJECT_TYPE enum (PARTICLE_TYPE_*)
+const ParticleSystem* SimGetParticles(const World *pWorld);
+
+// Handle of an active instance. Unlike the pointer, it can tell when the instance was destroyed
+GameObjectHandle SimGetInstanceHandle(World *pWorld, GameObjectInstance *pInst);
+
+// The instance of "Handle", or 0 if it was destroyed since the handle was taken
+GameObjectInstance* SimGetInstanceFromHandle(World *pWorld, GameObjectHandle Handle);
+
+// Fills "pStats" with the coins and deaths since SimInit
+void SimGetStats(const World *pWorld, SimStats *pStats);
+
+// Writes in "ppResults" the instances whose position is in or near [MinX, MaxX] x [MinY, MaxY],
+// at most "MaxResults" of them, and returns how many were written. Instances up to a few
+// cells outside the rectangle can be returned: the caller does the exact test
+unsigned int SimQueryInstances(World *pWorld, float MinX, float MinY, float MaxX, float MaxY, GameObjectInstance **ppResults, unsigned int MaxResults);
+
+// Transform setters. They mark the transformations dirty when the value changes;
+// the simulation rebuilds them during its update
+void SetTransformPosition(World *pWorld, Component_Transform *pTransform, float x, float y);
+void SetTransformAngle(World *pWorld, Component_Transform *pTransform, float Angle);
+void SetTransformScale(World *pWorld, Component_Transform *pTransform, float ScaleX, float ScaleY);
+
+// ---------------------------------------------------------------------------
+
+#endif // PLATFORMER_SIM_H
@@ -0,0 +1,156 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	RenderPacket.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the render packets and their queue
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "RenderPacket.h"
+
+// ---------------------------------------------------------------------------
+
+static int	PacketInit(RenderPacket *pPacket, unsigned int Capacity);
+static void	PacketFree(RenderPacket *pPacket);
+
+// ---------------------------------------------------------------------------
+
+int RenderPacketQueueInit(RenderPacketQueue *pQueue, unsigned int Capacity)
+{
+	unsigned int p;
+
+	memset(pQueue, 0, sizeof(RenderPacketQueue));
+
+	if (!MutexInit(&pQueue->mMutex))
+		return 0;
+	pQueue->mMutexMade = 1;
+
+	for (p = 0; p < RENDER_PACKET_BUFFER_NUM; ++p)
+	{
+		if (!PacketInit(pQueue->mPackets + p, Capacity))
+		{
+			RenderPacketQueueFree(pQueue);
+			return 0;
+		}
+	}
+
+	pQueue->mWriteIndex = 0;
+	pQueue->mReadyIndex = 1;
+	pQueue->mReadIndex = 2;
+	pQueue->mReadyNew = 0;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void RenderPacketQueueFree(RenderPacketQueue *pQueue)
+{
+	unsigned int p;
+
+	if (!pQueue->mMutexMade)
+		return;
+
+	for (p = 0; p < RENDER_PACKET_BUFFER_NUM; ++p)
+		PacketFree(pQueue->mPackets + p);
+
+	MutexFree(&pQueue->mMutex);
+	pQueue->mMutexMade = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+RenderPacket* RenderPacketQueueBeginWrite(RenderPacketQueue *pQueue)
+{
+	RenderPacket *pPacket = pQueue->mPackets + pQueue->mWriteIndex;
+
+	pPacket->mNum = 0;
+	pPacket->mDroppedNum = 0;
+
+	return pPacket;
+}
+
+// ---------------------------------------------------------------------------
+
+// The written packet and the ready one trade places: an unread ready packet is
+// older than the one just written, it is reused
+void RenderPacketQueuePublish(RenderPacketQueue *pQueue)
+{
+	unsigned int written = pQueue->mWriteIndex;
+
+	MutexLock(&pQueue->mMutex);
+	pQueue->mWriteIndex = pQueue->mReadyIndex;
+	pQueue->mReadyIndex = written;
+	pQueue->mReadyNew = 1;
+	MutexUnlock(&pQueue->mMutex);
+}
+
+// ---------------------------------------------------------------------------
+
+const RenderPacket* RenderPacketQueueAcquire(RenderPacketQueue *pQueue)
+{
+	MutexLock(&pQueue->mMutex);
+	if (pQueue->mReadyNew)
+	{
+		unsigned int ready = pQueue->mReadyIndex;
+
+		pQueue->mReadyIndex = pQueue->mReadIndex;
+		pQueue->mReadIndex = ready;
+		pQueue->mReadyNew = 0;
+	}
+	MutexUnlock(&pQueue->mMutex);
+
+	return pQueue->mPackets + pQueue->mReadIndex;
+}
+
+// ---------------------------------------------------------------------------
+
+void RenderPacketAdd(RenderPacket *pPacket, unsigned int Shape, unsigned int Color, const Affine2D *pTransform, float X, float Y, float PrevX, float PrevY, float Extent)
+{
+	RenderSprite *pSprite;
+
+	if (pPacket->mNum >= pPacket->mCapacity)
+	{
+		++pPacket->mDroppedNum;
+		return;
+	}
+
+	pSprite = pPacket->mpSprites + pPacket->mNum++;
+	pSprite->mTransform = *pTransform;
+	pSprite->mPosition.x = X;
+	pSprite->mPosition.y = Y;
+	pSprite->mPrevPosition.x = PrevX;
+	pSprite->mPrevPosition.y = PrevY;
+	pSprite->mExtent = Extent;
+	pSprite->mColor = Color;
+	pSprite->mShape = Shape;
+}
+
+// ---------------------------------------------------------------------------
+
+int PacketInit(RenderPacket *pPacket, unsigned int Capacity)
+{
+	memset(pPacket, 0, sizeof(RenderPacket));
+
+	pPacket->mCapacity = Capacity;
+	pPacket->mAlpha = 1.f;
+	pPacket->mpSprites = malloc(Capacity * sizeof(RenderSprite));
+
+	return pPacket->mpSprites != 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void PacketFree(RenderPacket *pPacket)
+{
+	free(pPacket->mpSprites);
+
+	memset(pPacket, 0, sizeof(RenderPacket));
+}
+
+// ---------------------------------------------------------------------------
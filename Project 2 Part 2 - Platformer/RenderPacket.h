@@ -0,0 +1,113 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	RenderPacket.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	What the update hands to the draw: the sprites of a
+//						frame and the camera, copied out of the simulation. The
+//						packets are triple buffered so the draw can read one
+//						while the update fills another
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef RENDER_PACKET_H
+#define RENDER_PACKET_H
+
+// ---------------------------------------------------------------------------
+
+#include "Affine2D.h"
+#include "Camera.h"
+#include "Thread.h"
+
+// ---------------------------------------------------------------------------
+
+#define RENDER_PACKET_BUFFER_NUM	3
+
+// ---------------------------------------------------------------------------
+
+/*
+Positions are in map space: the draw puts the sprite "Alpha" of the way from
+mPrevPosition to mPosition, and moves the translation of mTransform there.
+One struct per sprite: the draw reads all of it, and separate arrays this long
+would all start on the same cache sets.
+*/
+typedef struct
+{
+	Affine2D		mTransform;			// Shape space to the screen, at mPosition
+	Vector2D		mPosition;
+	Vector2D		mPrevPosition;
+	float			mExtent;			// Half the size, large enough for any angle, to cull with
+	unsigned int	mColor;				// ARGB, modulates the shape's colors
+	unsigned int	mShape;				// See SpriteBatch.h
+}RenderSprite;
+
+// One frame, as the update left it
+typedef struct
+{
+	unsigned int	mCapacity;
+	unsigned int	mNum;
+	RenderSprite	*mpSprites;
+
+	Affine2D		mMapTransform;		// Map space to the screen, the parent of the sprites' mTransform
+	Camera			mCamera;			// The camera after the update
+	float			mAlpha;				// How far the frame is between the last two updates
+	unsigned long	mDroppedNum;		// Sprites that did not fit
+}RenderPacket;
+
+/*
+The update writes into one packet and publishes it, the draw takes the newest
+published packet. Neither ever waits for the other to be done with a packet.
+*/
+typedef struct
+{
+	RenderPacket	mPackets[RENDER_PACKET_BUFFER_NUM];
+	unsigned int	mWriteIndex;		// Owned by the update
+	unsigned int	mReadIndex;			// Owned by the draw
+	unsigned int	mReadyIndex;		// The newest published packet, when mReadyNew is set
+	int				mReadyNew;
+	Mutex			mMutex;				// Guards mReadyIndex and mReadyNew
+	int				mMutexMade;			// Set once mMutex is made, until RenderPacketQueueFree
+}RenderPacketQueue;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function allocates the packets, "Capacity" sprites each. They start empty.
+Returns 0 if the packets could not be allocated
+*/
+int RenderPacketQueueInit(RenderPacketQueue *pQueue, unsigned int Capacity);
+
+/*
+This function frees the packets. It does nothing on a queue that is zeroed (static),
+already freed, or whose RenderPacketQueueInit failed: it can always be called
+*/
+void RenderPacketQueueFree(RenderPacketQueue *pQueue);
+
+/*
+This function returns the packet the update writes to, emptied
+*/
+RenderPacket* RenderPacketQueueBeginWrite(RenderPacketQueue *pQueue);
+
+/*
+This function makes the packet returned by RenderPacketQueueBeginWrite the newest
+one. It must not be written after that
+*/
+void RenderPacketQueuePublish(RenderPacketQueue *pQueue);
+
+/*
+This function returns the newest published packet. It is the draw's until the
+next RenderPacketQueueAcquire: the same packet again when none was published since
+*/
+const RenderPacket* RenderPacketQueueAcquire(RenderPacketQueue *pQueue);
+
+/*
+This function adds a sprite to the packet. It is dropped (and counted in
+mDroppedNum) when the packet is full
+*/
+void RenderPacketAdd(RenderPacket *pPacket, unsigned int Shape, unsigned int Color, const Affine2D *pTransform, float X, float Y, float PrevX, float PrevY, float Extent);
+
+// ---------------------------------------------------------------------------
+
+#endif // RENDER_PACKET_H
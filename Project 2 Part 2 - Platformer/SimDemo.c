@@ -0,0 +1,40 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	SimDemo.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the -demo input
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include "SimDemo.h"
+#include "PlatformerSim.h"
+
+// ---------------------------------------------------------------------------
+
+int SimDemoCheckInputCurr(void *pContext, unsigned int Input)
+{
+	unsigned long t = *(const unsigned long *)pContext % 900;
+
+	if (Input == SIM_INPUT_RIGHT)
+		return (t >= 60 && t < 300) || (t >= 600 && t < 700);
+	if (Input == SIM_INPUT_LEFT)
+		return t >= 300 && t < 560;
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+int SimDemoCheckInputTriggered(void *pContext, unsigned int Input)
+{
+	unsigned long tick = *(const unsigned long *)pContext;
+
+	if (Input == SIM_INPUT_JUMP)
+		return (tick % 37) == 0 || (tick % 53) == 0;
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,27 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	SimDemo.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	The scripted input of -demo, shared by the headless and
+//						batch runners so both play the same game
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef SIM_DEMO_H
+#define SIM_DEMO_H
+
+// ---------------------------------------------------------------------------
+
+/*
+The input of a SimBackend, as a function of the tick. "pContext" points to the
+tick of the run (an unsigned long). The hero runs right, then left, then right
+again, and jumps every now and then; the script repeats every 900 ticks
+*/
+int SimDemoCheckInputCurr(void *pContext, unsigned int Input);
+int SimDemoCheckInputTriggered(void *pContext, unsigned int Input);
+
+// ---------------------------------------------------------------------------
+
+#endif // SIM_DEMO_H
@@ -0,0 +1,139 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	SlotPool.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the slot pool
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- SlotPoolCopy
+// ---------------------------------------------------------------------------
+
+#include "SlotPool.h"
+
+#define SLOT_POOL_GENERATION_MASK	(0xFFFFFFFFu >> SLOT_POOL_INDEX_BITS)
+
+// ---------------------------------------------------------------------------
+
+void SlotPoolInit(SlotPool *pPool, SlotPoolEntry *pEntries, unsigned int Capacity)
+{
+	unsigned int i;
+
+	pPool->mpEntries = pEntries;
+	pPool->mCapacity = Capacity < SLOT_POOL_CAPACITY_MAX ? Capacity : SLOT_POOL_CAPACITY_MAX;
+
+	for (i = 0; i < pPool->mCapacity; ++i)
+	{
+		pPool->mpEntries[i].mGeneration = 0;
+		pPool->mpEntries[i].mUsed = 0;
+	}
+
+	SlotPoolReset(pPool);
+}
+
+// ---------------------------------------------------------------------------
+
+void SlotPoolReset(SlotPool *pPool)
+{
+	unsigned int i;
+
+	// Chain every slot in increasing order, so a fresh pool hands out 0, 1, 2...
+	for (i = 0; i < pPool->mCapacity; ++i)
+	{
+		SlotPoolEntry *pEntry = pPool->mpEntries + i;
+
+		if (pEntry->mUsed)
+		{
+			pEntry->mUsed = 0;
+			pEntry->mGeneration = (pEntry->mGeneration + 1) & SLOT_POOL_GENERATION_MASK;
+		}
+
+		pEntry->mNextFree = i + 1 < pPool->mCapacity ? i + 1 : SLOT_POOL_INVALID;
+	}
+
+	pPool->mFreeHead = pPool->mCapacity ? 0 : SLOT_POOL_INVALID;
+	pPool->mUsedNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+unsigned int SlotPoolAcquire(SlotPool *pPool)
+{
+	unsigned int slot = pPool->mFreeHead;
+
+	if (slot == SLOT_POOL_INVALID)
+		return SLOT_POOL_INVALID;
+
+	pPool->mFreeHead = pPool->mpEntries[slot].mNextFree;
+	pPool->mpEntries[slot].mUsed = 1;
+	++pPool->mUsedNum;
+
+	return slot;
+}
+
+// ---------------------------------------------------------------------------
+
+void SlotPoolRelease(SlotPool *pPool, unsigned int Slot)
+{
+	SlotPoolEntry *pEntry;
+
+	if (Slot >= pPool->mCapacity)
+		return;
+
+	pEntry = pPool->mpEntries + Slot;
+
+	if (0 == pEntry->mUsed)
+		return;
+
+	pEntry->mUsed = 0;
+	pEntry->mGeneration = (pEntry->mGeneration + 1) & SLOT_POOL_GENERATION_MASK;
+	pEntry->mNextFree = pPool->mFreeHead;
+
+	pPool->mFreeHead = Slot;
+	--pPool->mUsedNum;
+}
+
+// ---------------------------------------------------------------------------
+
+void SlotPoolCopy(SlotPool *pDst, const SlotPool *pSrc, unsigned int SlotNum)
+{
+	unsigned int i;
+
+	for (i = 0; i < SlotNum && i < pDst->mCapacity; ++i)
+	{
+		SlotPoolEntry *pEntry = pDst->mpEntries + i;
+
+		if (pEntry->mUsed)
+			pEntry->mGeneration = (pEntry->mGeneration + 1) & SLOT_POOL_GENERATION_MASK;
+
+		pEntry->mUsed = pSrc->mpEntries[i].mUsed;
+		pEntry->mNextFree = pSrc->mpEntries[i].mNextFree;
+	}
+
+	pDst->mFreeHead = pSrc->mFreeHead;
+	pDst->mUsedNum = pSrc->mUsedNum;
+}
+
+// ---------------------------------------------------------------------------
+
+unsigned int SlotPoolGetHandle(const SlotPool *pPool, unsigned int Slot)
+{
+	return (pPool->mpEntries[Slot].mGeneration << SLOT_POOL_INDEX_BITS) | Slot;
+}
+
+// ---------------------------------------------------------------------------
+
+unsigned int SlotPoolGetSlot(const SlotPool *pPool, unsigned int Handle)
+{
+	unsigned int slot = Handle & SLOT_POOL_INDEX_MASK;
+
+	if (Handle == SLOT_POOL_INVALID || slot >= pPool->mCapacity)
+		return SLOT_POOL_INVALID;
+
+	if (0 == pPool->mpEntries[slot].mUsed || pPool->mpEntries[slot].mGeneration != (Handle >> SLOT_POOL_INDEX_BITS))
+		return SLOT_POOL_INVALID;
+
+	return slot;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,89 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	SlotPool.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Fixed capacity pool of slot indices with O(1) acquire and
+//						release, and generation counters to detect stale handles
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- SlotPoolCopy
+// ---------------------------------------------------------------------------
+
+#ifndef SLOT_POOL_H
+#define SLOT_POOL_H
+
+// ---------------------------------------------------------------------------
+
+#define SLOT_POOL_INDEX_BITS		20							// Low bits of a handle: the slot index
+#define SLOT_POOL_INDEX_MASK		((1u << SLOT_POOL_INDEX_BITS) - 1)
+#define SLOT_POOL_CAPACITY_MAX		SLOT_POOL_INDEX_MASK		// The last index is reserved for SLOT_POOL_INVALID
+#define SLOT_POOL_INVALID			0xFFFFFFFFu					// Returned when the pool is full, never a valid handle
+
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+	unsigned int	mNextFree;		// Next slot of the free list, while this slot is free
+	unsigned int	mGeneration;	// Incremented each time the slot is released
+	unsigned int	mUsed;			// 1 while the slot is acquired
+}SlotPoolEntry;
+
+typedef struct
+{
+	SlotPoolEntry	*mpEntries;		// One entry per slot, owned by the caller
+	unsigned int	mCapacity;		// The number of entries
+	unsigned int	mFreeHead;		// First free slot, SLOT_POOL_INVALID when the pool is full
+	unsigned int	mUsedNum;		// The number of acquired slots
+}SlotPool;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function sets up the pool on top of "pEntries" (Capacity elements, at most
+SLOT_POOL_CAPACITY_MAX) and releases every slot. Generations start at 0
+*/
+void SlotPoolInit(SlotPool *pPool, SlotPoolEntry *pEntries, unsigned int Capacity);
+
+/*
+This function releases every slot. Slots that were in use get a new generation,
+so handles taken before the reset become stale
+*/
+void SlotPoolReset(SlotPool *pPool);
+
+/*
+This function takes a free slot and returns its index, or SLOT_POOL_INVALID if the
+pool is full. Slots come back lowest index first after a reset, then most
+recently released first
+*/
+unsigned int SlotPoolAcquire(SlotPool *pPool);
+
+/*
+This function gives the slot back to the pool. Releasing a free slot does nothing
+*/
+void SlotPoolRelease(SlotPool *pPool, unsigned int Slot);
+
+/*
+This function makes the first "SlotNum" slots of "pDst" used or free like those of
+"pSrc", with the same free list. Both pools have the same capacity, and their slots
+from SlotNum up are free and chained in order, as after a reset. The generations of
+pDst are kept, and those of its used slots move on: handles taken from pDst before
+the copy become stale
+*/
+void SlotPoolCopy(SlotPool *pDst, const SlotPool *pSrc, unsigned int SlotNum);
+
+/*
+This function returns the handle (index + generation) of an acquired slot
+*/
+unsigned int SlotPoolGetHandle(const SlotPool *pPool, unsigned int Slot);
+
+/*
+This function returns the slot index of "Handle", or SLOT_POOL_INVALID if the slot
+was released since the handle was taken
+*/
+unsigned int SlotPoolGetSlot(const SlotPool *pPool, unsigned int Handle);
+
+// ---------------------------------------------------------------------------
+
+#endif // SLOT_POOL_H
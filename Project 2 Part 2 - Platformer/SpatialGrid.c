@@ -0,0 +1,192 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	SpatialGrid.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the spatial grid
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- SpatialGridCopy
+// ---------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "SpatialGrid.h"
+
+// ---------------------------------------------------------------------------
+
+static int	GetBucketCoord(float Value, float Min, float CellSize, int Num);
+
+// ---------------------------------------------------------------------------
+
+int SpatialGridInit(SpatialGrid *pGrid, float MinX, float MinY, float MaxX, float MaxY, float CellSize, unsigned int Capacity)
+{
+	memset(pGrid, 0, sizeof(SpatialGrid));
+
+	pGrid->mMinX = MinX;
+	pGrid->mMinY = MinY;
+	pGrid->mCellSize = CellSize;
+	pGrid->mWidth = (int)((MaxX - MinX) / CellSize) + 1;
+	pGrid->mHeight = (int)((MaxY - MinY) / CellSize) + 1;
+	pGrid->mCapacity = Capacity;
+
+	pGrid->mpHeads = malloc((size_t)pGrid->mWidth * pGrid->mHeight * sizeof(unsigned int));
+	pGrid->mpNext = malloc(Capacity * sizeof(unsigned int));
+	pGrid->mpPrev = malloc(Capacity * sizeof(unsigned int));
+	pGrid->mpBuckets = malloc(Capacity * sizeof(unsigned int));
+
+	if (!pGrid->mpHeads || !pGrid->mpNext || !pGrid->mpPrev || !pGrid->mpBuckets)
+	{
+		SpatialGridFree(pGrid);
+		return 0;
+	}
+
+	SpatialGridClear(pGrid);
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void SpatialGridFree(SpatialGrid *pGrid)
+{
+	free(pGrid->mpHeads);
+	free(pGrid->mpNext);
+	free(pGrid->mpPrev);
+	free(pGrid->mpBuckets);
+
+	memset(pGrid, 0, sizeof(SpatialGrid));
+}
+
+// ---------------------------------------------------------------------------
+
+void SpatialGridClear(SpatialGrid *pGrid)
+{
+	// All bytes 0xFF is SPATIAL_GRID_NONE
+	memset(pGrid->mpHeads, 0xFF, (size_t)pGrid->mWidth * pGrid->mHeight * sizeof(unsigned int));
+	memset(pGrid->mpBuckets, 0xFF, pGrid->mCapacity * sizeof(unsigned int));
+}
+
+// ---------------------------------------------------------------------------
+
+void SpatialGridCopy(SpatialGrid *pDst, const SpatialGrid *pSrc, unsigned int ItemNum)
+{
+	unsigned int i;
+
+	if (ItemNum > pDst->mCapacity)
+		ItemNum = pDst->mCapacity;
+
+	// Every other item is out of both grids: the buckets of the copied items only
+	// hold copied items, and their heads are the ones to copy
+	for (i = 0; i < ItemNum; ++i)
+	{
+		if (pDst->mpBuckets[i] != SPATIAL_GRID_NONE)
+			pDst->mpHeads[pDst->mpBuckets[i]] = SPATIAL_GRID_NONE;
+	}
+
+	for (i = 0; i < ItemNum; ++i)
+	{
+		if (pSrc->mpBuckets[i] != SPATIAL_GRID_NONE)
+			pDst->mpHeads[pSrc->mpBuckets[i]] = pSrc->mpHeads[pSrc->mpBuckets[i]];
+	}
+
+	memcpy(pDst->mpNext, pSrc->mpNext, ItemNum * sizeof(unsigned int));
+	memcpy(pDst->mpPrev, pSrc->mpPrev, ItemNum * sizeof(unsigned int));
+	memcpy(pDst->mpBuckets, pSrc->mpBuckets, ItemNum * sizeof(unsigned int));
+}
+
+// ---------------------------------------------------------------------------
+
+void SpatialGridMove(SpatialGrid *pGrid, unsigned int Item, float X, float Y)
+{
+	unsigned int bucket;
+
+	if (Item >= pGrid->mCapacity)
+		return;
+
+	bucket = (unsigned int)(GetBucketCoord(Y, pGrid->mMinY, pGrid->mCellSize, pGrid->mHeight) * pGrid->mWidth
+		+ GetBucketCoord(X, pGrid->mMinX, pGrid->mCellSize, pGrid->mWidth));
+
+	if (bucket == pGrid->mpBuckets[Item])
+		return;
+
+	SpatialGridRemove(pGrid, Item);
+
+	// Push at the front of the bucket's list
+	pGrid->mpBuckets[Item] = bucket;
+	pGrid->mpPrev[Item] = SPATIAL_GRID_NONE;
+	pGrid->mpNext[Item] = pGrid->mpHeads[bucket];
+	if (pGrid->mpHeads[bucket] != SPATIAL_GRID_NONE)
+		pGrid->mpPrev[pGrid->mpHeads[bucket]] = Item;
+	pGrid->mpHeads[bucket] = Item;
+}
+
+// ---------------------------------------------------------------------------
+
+void SpatialGridRemove(SpatialGrid *pGrid, unsigned int Item)
+{
+	unsigned int bucket;
+
+	if (Item >= pGrid->mCapacity || pGrid->mpBuckets[Item] == SPATIAL_GRID_NONE)
+		return;
+
+	bucket = pGrid->mpBuckets[Item];
+
+	if (pGrid->mpPrev[Item] != SPATIAL_GRID_NONE)
+		pGrid->mpNext[pGrid->mpPrev[Item]] = pGrid->mpNext[Item];
+	else
+		pGrid->mpHeads[bucket] = pGrid->mpNext[Item];
+
+	if (pGrid->mpNext[Item] != SPATIAL_GRID_NONE)
+		pGrid->mpPrev[pGrid->mpNext[Item]] = pGrid->mpPrev[Item];
+
+	pGrid->mpBuckets[Item] = SPATIAL_GRID_NONE;
+}
+
+// ---------------------------------------------------------------------------
+
+unsigned int SpatialGridQuery(const SpatialGrid *pGrid, float MinX, float MinY, float MaxX, float MaxY, unsigned int *pResults, unsigned int MaxResults)
+{
+	int minBX = GetBucketCoord(MinX, pGrid->mMinX, pGrid->mCellSize, pGrid->mWidth);
+	int maxBX = GetBucketCoord(MaxX, pGrid->mMinX, pGrid->mCellSize, pGrid->mWidth);
+	int minBY = GetBucketCoord(MinY, pGrid->mMinY, pGrid->mCellSize, pGrid->mHeight);
+	int maxBY = GetBucketCoord(MaxY, pGrid->mMinY, pGrid->mCellSize, pGrid->mHeight);
+	unsigned int num = 0;
+	int bx, by;
+
+	for (by = minBY; by <= maxBY; ++by)
+	{
+		for (bx = minBX; bx <= maxBX; ++bx)
+		{
+			unsigned int item = pGrid->mpHeads[by * pGrid->mWidth + bx];
+
+			for (; item != SPATIAL_GRID_NONE; item = pGrid->mpNext[item])
+			{
+				if (num == MaxResults)
+					return num;
+
+				pResults[num++] = item;
+			}
+		}
+	}
+
+	return num;
+}
+
+// ---------------------------------------------------------------------------
+
+// Bucket column (or row) of "Value", clamped to the grid
+int GetBucketCoord(float Value, float Min, float CellSize, int Num)
+{
+	float b = (Value - Min) / CellSize;
+
+	if (b < 0.f)
+		return 0;
+	if (b >= (float)Num)
+		return Num - 1;
+
+	return (int)b;
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,89 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	SpatialGrid.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Uniform grid of buckets over the map, to find the items
+//						around a rectangle without looking at every item
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- SpatialGridCopy
+// ---------------------------------------------------------------------------
+
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+// ---------------------------------------------------------------------------
+
+#define SPATIAL_GRID_NONE			0xFFFFFFFFu		// No item, or an item that is not in the grid
+
+// ---------------------------------------------------------------------------
+
+/*
+Items are numbered 0 to Capacity - 1 (the simulation uses the instance slots) and
+are filed by a single point, in the bucket that contains it. Points outside the
+grid go to the nearest bucket on its border. Each bucket is a doubly linked list,
+so moving an item to another bucket is O(1).
+*/
+typedef struct
+{
+	float			mMinX, mMinY;		// Corner of bucket (0;0)
+	float			mCellSize;			// Width and height of a bucket
+	int				mWidth, mHeight;	// In buckets
+
+	unsigned int	*mpHeads;			// First item of each bucket
+	unsigned int	*mpNext;			// Per item: next and previous item of its bucket
+	unsigned int	*mpPrev;
+	unsigned int	*mpBuckets;			// Per item: its bucket, SPATIAL_GRID_NONE when not in the grid
+	unsigned int	mCapacity;
+}SpatialGrid;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function allocates an empty grid covering [MinX, MaxX] x [MinY, MaxY] with
+square buckets of "CellSize", for items 0 to Capacity - 1. Returns 0 if the
+tables could not be allocated
+*/
+int SpatialGridInit(SpatialGrid *pGrid, float MinX, float MinY, float MaxX, float MaxY, float CellSize, unsigned int Capacity);
+
+/*
+This function frees the tables allocated by SpatialGridInit
+*/
+void SpatialGridFree(SpatialGrid *pGrid);
+
+/*
+This function takes every item out of the grid
+*/
+void SpatialGridClear(SpatialGrid *pGrid);
+
+/*
+This function files the first "ItemNum" items of "pDst" like those of "pSrc". Both
+grids have the same size, and their items from ItemNum up are out of them. Only
+the buckets of the copied items are written, not the whole grid
+*/
+void SpatialGridCopy(SpatialGrid *pDst, const SpatialGrid *pSrc, unsigned int ItemNum);
+
+/*
+This function files "Item" at (X;Y). An item already in the grid is moved, and
+only relinked if it changes bucket
+*/
+void SpatialGridMove(SpatialGrid *pGrid, unsigned int Item, float X, float Y);
+
+/*
+This function takes "Item" out of the grid. Does nothing if it is not in it
+*/
+void SpatialGridRemove(SpatialGrid *pGrid, unsigned int Item);
+
+/*
+This function writes in "pResults" the items of the buckets that overlap
+[MinX, MaxX] x [MinY, MaxY], at most "MaxResults" of them, and returns how many
+were written. Items close to the rectangle but outside it can be returned too:
+the caller does the exact test
+*/
+unsigned int SpatialGridQuery(const SpatialGrid *pGrid, float MinX, float MinY, float MaxX, float MaxY, unsigned int *pResults, unsigned int MaxResults);
+
+// ---------------------------------------------------------------------------
+
+#endif // SPATIAL_GRID_H
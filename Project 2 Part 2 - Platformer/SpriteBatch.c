@@ -0,0 +1,195 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	SpriteBatch.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the sprite batch
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "SpriteBatch.h"
+
+// ---------------------------------------------------------------------------
+
+static unsigned int	ModulateColor(unsigned int Color0, unsigned int Color1);
+static void			DrawShape(SpriteBatch *pBatch, unsigned int Shape, const unsigned int *pSprites, unsigned int SpriteNum);
+
+// ---------------------------------------------------------------------------
+
+int SpriteBatchInit(SpriteBatch *pBatch, unsigned int Capacity, const SpriteBatchBackend *pBackend)
+{
+	memset(pBatch, 0, sizeof(SpriteBatch));
+
+	pBatch->mpBackend = pBackend;
+	pBatch->mCapacity = Capacity;
+	pBatch->mpShapes = malloc(Capacity * sizeof(unsigned char));
+	pBatch->mpTransforms = malloc(Capacity * sizeof(Affine2D));
+	pBatch->mpColors = malloc(Capacity * sizeof(unsigned int));
+	pBatch->mpOrder = malloc(Capacity * sizeof(unsigned int));
+	pBatch->mpVertices = malloc(SPRITE_BATCH_CALL_TRIANGLE_NUM_MAX * 3 * sizeof(SpriteVertex));
+
+	if (!pBatch->mpShapes || !pBatch->mpTransforms || !pBatch->mpColors || !pBatch->mpOrder || !pBatch->mpVertices)
+	{
+		SpriteBatchFree(pBatch);
+		return 0;
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void SpriteBatchFree(SpriteBatch *pBatch)
+{
+	free(pBatch->mpShapes);
+	free(pBatch->mpTransforms);
+	free(pBatch->mpColors);
+	free(pBatch->mpOrder);
+	free(pBatch->mpVertices);
+
+	pBatch->mpShapes = 0;
+	pBatch->mpTransforms = 0;
+	pBatch->mpColors = 0;
+	pBatch->mpOrder = 0;
+	pBatch->mpVertices = 0;
+	pBatch->mCapacity = 0;
+	pBatch->mNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+int SpriteBatchSetShape(SpriteBatch *pBatch, unsigned int Shape, const SpriteVertex *pVertices, unsigned int TriangleNum)
+{
+	if (Shape >= SPRITE_BATCH_SHAPE_NUM_MAX || TriangleNum > SPRITE_BATCH_SHAPE_TRIANGLE_NUM_MAX)
+		return 0;
+
+	memcpy(pBatch->mShapes[Shape].mVertices, pVertices, TriangleNum * 3 * sizeof(SpriteVertex));
+	pBatch->mShapes[Shape].mTriangleNum = TriangleNum;
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void SpriteBatchBegin(SpriteBatch *pBatch)
+{
+	pBatch->mNum = 0;
+	pBatch->mDroppedNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void SpriteBatchAdd(SpriteBatch *pBatch, unsigned int Shape, const Affine2D *pTransform, unsigned int Color)
+{
+	unsigned int i = pBatch->mNum;
+
+	if (i == pBatch->mCapacity || Shape >= SPRITE_BATCH_SHAPE_NUM_MAX)
+	{
+		++pBatch->mDroppedNum;
+		return;
+	}
+
+	pBatch->mpShapes[i] = (unsigned char)Shape;
+	pBatch->mpTransforms[i] = *pTransform;
+	pBatch->mpColors[i] = Color;
+	++pBatch->mNum;
+}
+
+// ---------------------------------------------------------------------------
+
+void SpriteBatchEnd(SpriteBatch *pBatch)
+{
+	unsigned int starts[SPRITE_BATCH_SHAPE_NUM_MAX + 1];
+	unsigned int i, shape;
+
+	pBatch->mDrawCallNum = 0;
+	pBatch->mTriangleNum = 0;
+
+	// Counting sort of the sprites by shape, which keeps the order they were added in
+	memset(starts, 0, sizeof(starts));
+	for (i = 0; i < pBatch->mNum; ++i)
+		++starts[pBatch->mpShapes[i] + 1];
+	for (shape = 0; shape < SPRITE_BATCH_SHAPE_NUM_MAX; ++shape)
+		starts[shape + 1] += starts[shape];
+
+	for (i = 0; i < pBatch->mNum; ++i)
+		pBatch->mpOrder[starts[pBatch->mpShapes[i]]++] = i;
+
+	// "starts" now holds where each shape ends
+	for (shape = 0; shape < SPRITE_BATCH_SHAPE_NUM_MAX; ++shape)
+	{
+		unsigned int first = shape ? starts[shape - 1] : 0;
+
+		if (starts[shape] > first && pBatch->mShapes[shape].mTriangleNum > 0)
+			DrawShape(pBatch, shape, pBatch->mpOrder + first, starts[shape] - first);
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+// Per channel product, where 0xFF stands for 1
+unsigned int ModulateColor(unsigned int Color0, unsigned int Color1)
+{
+	unsigned int result = 0;
+	unsigned int shift;
+
+	if (Color1 == 0xFFFFFFFF)
+		return Color0;
+
+	for (shift = 0; shift < 32; shift += 8)
+	{
+		unsigned int c0 = (Color0 >> shift) & 0xFF;
+		unsigned int c1 = (Color1 >> shift) & 0xFF;
+
+		result |= (((c0 * c1) + 0xFF) >> 8) << shift;
+	}
+
+	return result;
+}
+
+// ---------------------------------------------------------------------------
+
+// Puts the vertices of the sprites in the vertex buffer, and hands it to the backend when it is full
+void DrawShape(SpriteBatch *pBatch, unsigned int Shape, const unsigned int *pSprites, unsigned int SpriteNum)
+{
+	const SpriteShape *pShape = pBatch->mShapes + Shape;
+	unsigned int vertexNum = pShape->mTriangleNum * 3;
+	unsigned int spritesPerCall = SPRITE_BATCH_CALL_TRIANGLE_NUM_MAX / pShape->mTriangleNum;
+	unsigned int n, v;
+
+	while (SpriteNum > 0)
+	{
+		unsigned int num = SpriteNum < spritesPerCall ? SpriteNum : spritesPerCall;
+		SpriteVertex *pOut = pBatch->mpVertices;
+
+		for (n = 0; n < num; ++n)
+		{
+			unsigned int i = pSprites[n];
+			const Affine2D *pTransform = pBatch->mpTransforms + i;
+			unsigned int color = pBatch->mpColors[i];
+
+			for (v = 0; v < vertexNum; ++v)
+			{
+				const SpriteVertex *pIn = pShape->mVertices + v;
+
+				pOut->mX = pTransform->m[0][0] * pIn->mX + pTransform->m[0][1] * pIn->mY + pTransform->m[0][2];
+				pOut->mY = pTransform->m[1][0] * pIn->mX + pTransform->m[1][1] * pIn->mY + pTransform->m[1][2];
+				pOut->mColor = ModulateColor(pIn->mColor, color);
+				++pOut;
+			}
+		}
+
+		pBatch->mpBackend->DrawTriangles(Shape, pBatch->mpVertices, num * pShape->mTriangleNum);
+		++pBatch->mDrawCallNum;
+		pBatch->mTriangleNum += num * pShape->mTriangleNum;
+
+		pSprites += num;
+		SpriteNum -= num;
+	}
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	SpriteBatch.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Collects the sprites of a frame and draws them grouped by
+//						shape, with one backend call per shape
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+// ---------------------------------------------------------------------------
+
+#include "Affine2D.h"
+
+// ---------------------------------------------------------------------------
+
+#define SPRITE_BATCH_SHAPE_NUM_MAX			32			// Shapes are numbered 0 to SPRITE_BATCH_SHAPE_NUM_MAX - 1
+#define SPRITE_BATCH_SHAPE_TRIANGLE_NUM_MAX	32			// Triangles in one shape
+#define SPRITE_BATCH_CALL_TRIANGLE_NUM_MAX	16384		// Triangles in one backend call; bigger groups take more calls
+
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+	float			mX, mY;
+	unsigned int	mColor;			// ARGB
+}SpriteVertex;
+
+/*
+What the batch draws with. The game state does it with Alpha Engine meshes, the
+headless runner only counts.
+*/
+typedef struct
+{
+	// Draws "TriangleNum" triangles (3 vertices each, already transformed) of "Shape"
+	void	(*DrawTriangles)(unsigned int Shape, const SpriteVertex *pVertices, unsigned int TriangleNum);
+}SpriteBatchBackend;
+
+typedef struct
+{
+	SpriteVertex	mVertices[SPRITE_BATCH_SHAPE_TRIANGLE_NUM_MAX * 3];		// In the shape's own space
+	unsigned int	mTriangleNum;
+}SpriteShape;
+
+typedef struct
+{
+	const SpriteBatchBackend	*mpBackend;
+	SpriteShape					mShapes[SPRITE_BATCH_SHAPE_NUM_MAX];
+
+	// The sprites added since SpriteBatchBegin, in the order they were added
+	unsigned int				mCapacity;
+	unsigned int				mNum;
+	unsigned char				*mpShapes;
+	Affine2D					*mpTransforms;
+	unsigned int				*mpColors;
+
+	unsigned int				*mpOrder;		// Sprite indices sorted by shape
+	SpriteVertex				*mpVertices;	// SPRITE_BATCH_CALL_TRIANGLE_NUM_MAX triangles
+
+	// Counts of the last SpriteBatchEnd
+	unsigned long				mDrawCallNum;
+	unsigned long				mTriangleNum;
+	unsigned long				mDroppedNum;	// Sprites that did not fit
+}SpriteBatch;
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function allocates the buffers for "Capacity" sprites per frame. The shapes
+start empty. Returns 0 if the buffers could not be allocated
+*/
+int SpriteBatchInit(SpriteBatch *pBatch, unsigned int Capacity, const SpriteBatchBackend *pBackend);
+
+/*
+This function frees the buffers allocated by SpriteBatchInit
+*/
+void SpriteBatchFree(SpriteBatch *pBatch);
+
+/*
+This function sets the triangles of "Shape" (3 vertices per triangle). Returns 0
+if "Shape" or "TriangleNum" is too big
+*/
+int SpriteBatchSetShape(SpriteBatch *pBatch, unsigned int Shape, const SpriteVertex *pVertices, unsigned int TriangleNum);
+
+/*
+This function starts a frame: the sprites of the previous one are dropped
+*/
+void SpriteBatchBegin(SpriteBatch *pBatch);
+
+/*
+This function adds a sprite of "Shape", placed by "pTransform". The shape's vertex
+colors are multiplied by "Color" (0xFFFFFFFF keeps them). When the batch is full,
+the sprite is dropped
+*/
+void SpriteBatchAdd(SpriteBatch *pBatch, unsigned int Shape, const Affine2D *pTransform, unsigned int Color);
+
+/*
+This function draws the sprites: the shapes in increasing order, the sprites of a
+shape in the order they were added
+*/
+void SpriteBatchEnd(SpriteBatch *pBatch);
+
+// ---------------------------------------------------------------------------
+
+#endif // SPRITE_BATCH_H
@@ -0,0 +1,224 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	Thread.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the thread wrappers
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- ThreadGetProcessorNum
+// ---------------------------------------------------------------------------
+
+#ifndef _WIN32
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "Thread.h"
+
+// ---------------------------------------------------------------------------
+
+#ifdef _WIN32
+
+// ---------------------------------------------------------------------------
+
+static DWORD WINAPI ThreadEntry(LPVOID pParameter)
+{
+	Thread *pThread = (Thread *)pParameter;
+
+	pThread->mFunction(pThread->mpContext);
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+int ThreadCreate(Thread *pThread, ThreadFunction Function, void *pContext)
+{
+	pThread->mFunction = Function;
+	pThread->mpContext = pContext;
+	pThread->mHandle = CreateThread(NULL, 0, ThreadEntry, pThread, 0, NULL);
+
+	return pThread->mHandle != NULL;
+}
+
+// ---------------------------------------------------------------------------
+
+void ThreadJoin(Thread *pThread)
+{
+	WaitForSingleObject(pThread->mHandle, INFINITE);
+	CloseHandle(pThread->mHandle);
+	pThread->mHandle = NULL;
+}
+
+// ---------------------------------------------------------------------------
+
+double ThreadGetTime(void)
+{
+	LARGE_INTEGER frequency, counter;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+}
+
+// ---------------------------------------------------------------------------
+
+unsigned int ThreadGetProcessorNum(void)
+{
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+
+	return info.dwNumberOfProcessors > 0 ? (unsigned int)info.dwNumberOfProcessors : 1;
+}
+
+// ---------------------------------------------------------------------------
+
+int MutexInit(Mutex *pMutex)
+{
+	InitializeCriticalSection(pMutex);
+	return 1;
+}
+
+void MutexFree(Mutex *pMutex)
+{
+	DeleteCriticalSection(pMutex);
+}
+
+void MutexLock(Mutex *pMutex)
+{
+	EnterCriticalSection(pMutex);
+}
+
+void MutexUnlock(Mutex *pMutex)
+{
+	LeaveCriticalSection(pMutex);
+}
+
+// ---------------------------------------------------------------------------
+
+int SemaphoreInit(Semaphore *pSemaphore, unsigned int Count)
+{
+	*pSemaphore = CreateSemaphore(NULL, (LONG)Count, 0x7FFFFFFF, NULL);
+	return *pSemaphore != NULL;
+}
+
+void SemaphoreFree(Semaphore *pSemaphore)
+{
+	CloseHandle(*pSemaphore);
+	*pSemaphore = NULL;
+}
+
+void SemaphorePost(Semaphore *pSemaphore)
+{
+	ReleaseSemaphore(*pSemaphore, 1, NULL);
+}
+
+void SemaphoreWait(Semaphore *pSemaphore)
+{
+	WaitForSingleObject(*pSemaphore, INFINITE);
+}
+
+// ---------------------------------------------------------------------------
+
+#else
+
+// ---------------------------------------------------------------------------
+
+static void* ThreadEntry(void *pParameter)
+{
+	Thread *pThread = (Thread *)pParameter;
+
+	pThread->mFunction(pThread->mpContext);
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+
+int ThreadCreate(Thread *pThread, ThreadFunction Function, void *pContext)
+{
+	pThread->mFunction = Function;
+	pThread->mpContext = pContext;
+
+	return 0 == pthread_create(&pThread->mHandle, 0, ThreadEntry, pThread);
+}
+
+// ---------------------------------------------------------------------------
+
+void ThreadJoin(Thread *pThread)
+{
+	pthread_join(pThread->mHandle, 0);
+}
+
+// ---------------------------------------------------------------------------
+
+double ThreadGetTime(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (double)now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// ---------------------------------------------------------------------------
+
+unsigned int ThreadGetProcessorNum(void)
+{
+	long num = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return num > 0 ? (unsigned int)num : 1;
+}
+
+// ---------------------------------------------------------------------------
+
+int MutexInit(Mutex *pMutex)
+{
+	return 0 == pthread_mutex_init(pMutex, 0);
+}
+
+void MutexFree(Mutex *pMutex)
+{
+	pthread_mutex_destroy(pMutex);
+}
+
+void MutexLock(Mutex *pMutex)
+{
+	pthread_mutex_lock(pMutex);
+}
+
+void MutexUnlock(Mutex *pMutex)
+{
+	pthread_mutex_unlock(pMutex);
+}
+
+// ---------------------------------------------------------------------------
+
+int SemaphoreInit(Semaphore *pSemaphore, unsigned int Count)
+{
+	return 0 == sem_init(pSemaphore, 0, Count);
+}
+
+void SemaphoreFree(Semaphore *pSemaphore)
+{
+	sem_destroy(pSemaphore);
+}
+
+void SemaphorePost(Semaphore *pSemaphore)
+{
+	sem_post(pSemaphore);
+}
+
+// Interrupted waits (EINTR) are started again
+void SemaphoreWait(Semaphore *pSemaphore)
+{
+	while (0 != sem_wait(pSemaphore))
+		;
+}
+
+// ---------------------------------------------------------------------------
+
+#endif
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,88 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	Thread.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Threads, mutexes and semaphores over the Win32 API or
+//						POSIX threads, and a wall clock to time them with
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- ThreadGetProcessorNum
+// ---------------------------------------------------------------------------
+
+#ifndef THREAD_H
+#define THREAD_H
+
+// ---------------------------------------------------------------------------
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <semaphore.h>
+#endif
+
+// ---------------------------------------------------------------------------
+
+typedef void (*ThreadFunction)(void *pContext);
+
+typedef struct
+{
+#ifdef _WIN32
+	HANDLE				mHandle;
+#else
+	pthread_t			mHandle;
+#endif
+	ThreadFunction		mFunction;		// Run by the thread with mpContext
+	void				*mpContext;
+}Thread;
+
+#ifdef _WIN32
+typedef CRITICAL_SECTION	Mutex;
+typedef HANDLE				Semaphore;
+#else
+typedef pthread_mutex_t		Mutex;
+typedef sem_t				Semaphore;
+#endif
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function starts a thread that runs Function(pContext). "pThread" must stay
+valid until ThreadJoin. Returns 0 if the thread could not be started
+*/
+int ThreadCreate(Thread *pThread, ThreadFunction Function, void *pContext);
+
+/*
+This function waits for the thread's function to return, and releases the thread
+*/
+void ThreadJoin(Thread *pThread);
+
+/*
+This function returns a wall clock time, in seconds. Unlike clock(), which adds up
+the time of every thread, it tells how long a run of several threads took
+*/
+double ThreadGetTime(void);
+
+/*
+This function returns the number of processors the threads can run on, at least 1
+*/
+unsigned int ThreadGetProcessorNum(void);
+
+// Mutexes. MutexInit returns 0 if the mutex could not be made
+int MutexInit(Mutex *pMutex);
+void MutexFree(Mutex *pMutex);
+void MutexLock(Mutex *pMutex);
+void MutexUnlock(Mutex *pMutex);
+
+// Counting semaphores, starting at "Count". SemaphoreInit returns 0 if the semaphore
+// could not be made. SemaphoreWait blocks until the count is above 0, then takes 1
+int SemaphoreInit(Semaphore *pSemaphore, unsigned int Count);
+void SemaphoreFree(Semaphore *pSemaphore);
+void SemaphorePost(Semaphore *pSemaphore);
+void SemaphoreWait(Semaphore *pSemaphore);
+
+// ---------------------------------------------------------------------------
+
+#endif // THREAD_H
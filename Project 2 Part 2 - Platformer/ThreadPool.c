@@ -0,0 +1,138 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	ThreadPool.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the thread pool
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- ThreadPoolInit frees what it made when it fails
+// ---------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "ThreadPool.h"
+
+// ---------------------------------------------------------------------------
+
+static void	WorkerMain(void *pContext);
+
+// ---------------------------------------------------------------------------
+
+int ThreadPoolInit(ThreadPool *pPool, unsigned int ThreadNum)
+{
+	unsigned int t;
+
+	memset(pPool, 0, sizeof(ThreadPool));
+
+	if (ThreadNum > THREAD_POOL_THREAD_NUM_MAX)
+		ThreadNum = THREAD_POOL_THREAD_NUM_MAX;
+
+	if (!MutexInit(&pPool->mMutex))
+		return 0;
+
+	if (!SemaphoreInit(&pPool->mStart, 0))
+	{
+		MutexFree(&pPool->mMutex);
+		return 0;
+	}
+
+	if (!SemaphoreInit(&pPool->mDone, 0))
+	{
+		SemaphoreFree(&pPool->mStart);
+		MutexFree(&pPool->mMutex);
+		return 0;
+	}
+
+	for (t = 0; t < ThreadNum; ++t)
+	{
+		pPool->mWorkers[t].mpPool = pPool;
+		pPool->mWorkers[t].mIndex = t;
+
+		if (!ThreadCreate(pPool->mThreads + t, WorkerMain, pPool->mWorkers + t))
+		{
+			ThreadPoolFree(pPool);
+			return 0;
+		}
+
+		pPool->mThreadNum = t + 1;
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void ThreadPoolFree(ThreadPool *pPool)
+{
+	unsigned int t;
+
+	pPool->mQuit = 1;
+
+	for (t = 0; t < pPool->mThreadNum; ++t)
+		SemaphorePost(&pPool->mStart);
+
+	for (t = 0; t < pPool->mThreadNum; ++t)
+		ThreadJoin(pPool->mThreads + t);
+
+	SemaphoreFree(&pPool->mStart);
+	SemaphoreFree(&pPool->mDone);
+	MutexFree(&pPool->mMutex);
+
+	pPool->mThreadNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+void ThreadPoolRun(ThreadPool *pPool, ThreadPoolJob Job, void *pContext, unsigned int JobNum)
+{
+	unsigned int t;
+
+	pPool->mJob = Job;
+	pPool->mpContext = pContext;
+	pPool->mJobNum = JobNum;
+	pPool->mNextJob = 0;
+
+	for (t = 0; t < pPool->mThreadNum; ++t)
+		SemaphorePost(&pPool->mStart);
+
+	for (t = 0; t < pPool->mThreadNum; ++t)
+		SemaphoreWait(&pPool->mDone);
+}
+
+// ---------------------------------------------------------------------------
+
+// Each start takes jobs until there are none left
+void WorkerMain(void *pContext)
+{
+	ThreadPoolWorker *pWorker = (ThreadPoolWorker *)pContext;
+	ThreadPool *pPool = pWorker->mpPool;
+
+	for (;;)
+	{
+		SemaphoreWait(&pPool->mStart);
+
+		if (pPool->mQuit)
+			return;
+
+		for (;;)
+		{
+			unsigned int job;
+
+			MutexLock(&pPool->mMutex);
+			job = pPool->mNextJob;
+			if (job < pPool->mJobNum)
+				++pPool->mNextJob;
+			MutexUnlock(&pPool->mMutex);
+
+			if (job >= pPool->mJobNum)
+				break;
+
+			pPool->mJob(pPool->mpContext, job, pWorker->mIndex);
+		}
+
+		SemaphorePost(&pPool->mDone);
+	}
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,81 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	ThreadPool.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	A fixed set of worker threads that share out numbered
+//						jobs
+// History			:
+//	- 2026/10/17	:	- initial implementation
+// ---------------------------------------------------------------------------
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// ---------------------------------------------------------------------------
+
+#include "Thread.h"
+
+// ---------------------------------------------------------------------------
+
+#define THREAD_POOL_THREAD_NUM_MAX		64
+
+// ---------------------------------------------------------------------------
+
+/*
+Runs job "Job", on worker "Worker" (0 to the number of threads - 1). A worker runs
+one job at a time, so the job can use data kept per worker without locking it
+*/
+typedef void (*ThreadPoolJob)(void *pContext, unsigned int Job, unsigned int Worker);
+
+typedef struct ThreadPool ThreadPool;
+
+// What each thread is started with
+typedef struct
+{
+	ThreadPool		*mpPool;
+	unsigned int	mIndex;
+}ThreadPoolWorker;
+
+struct ThreadPool
+{
+	Thread				mThreads[THREAD_POOL_THREAD_NUM_MAX];
+	ThreadPoolWorker	mWorkers[THREAD_POOL_THREAD_NUM_MAX];
+	unsigned int		mThreadNum;
+
+	Semaphore			mStart;			// Posted once per thread to start a ThreadPoolRun, or to quit
+	Semaphore			mDone;			// Posted by each thread once no job is left
+	Mutex				mMutex;			// Guards mNextJob
+
+	// The current ThreadPoolRun
+	ThreadPoolJob		mJob;
+	void				*mpContext;
+	unsigned int		mJobNum;
+	unsigned int		mNextJob;		// The next job to hand out
+	int					mQuit;
+};
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function starts "ThreadNum" threads (at most THREAD_POOL_THREAD_NUM_MAX), which
+wait for jobs. Returns 0 if they could not all be started
+*/
+int ThreadPoolInit(ThreadPool *pPool, unsigned int ThreadNum);
+
+/*
+This function stops and joins the threads
+*/
+void ThreadPoolFree(ThreadPool *pPool);
+
+/*
+This function runs Job(pContext, j, Worker) for j from 0 to JobNum - 1 on the pool's
+threads, and returns once they are all done. The jobs are handed out one at a time,
+in order, to the first thread free
+*/
+void ThreadPoolRun(ThreadPool *pPool, ThreadPoolJob Job, void *pContext, unsigned int JobNum);
+
+// ---------------------------------------------------------------------------
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,183 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	TileMapRender.c
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Implementation of the chunked tile map drawing
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- meshes are built when their chunk is first drawn
+//	- 2026/10/17	:	- the map is passed to TileMapRenderBuild
+// ---------------------------------------------------------------------------
+
+#include "AEEngine.h"
+#include "BinaryMap.h"
+#include "TileMapRender.h"
+
+// ---------------------------------------------------------------------------
+
+#define TILE_COLOR_EMPTY			0xFF000000			// Black
+#define TILE_COLOR_COLLISION		0xFFFFFFFF			// White
+
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+	AEGfxVertexList*		mpMesh;				// 0 while the chunk has no mesh
+	unsigned long			mLastDraw;			// sgDrawCounter of the last draw of the chunk
+}ChunkMesh;
+
+// ---------------------------------------------------------------------------
+
+static const MapContext*	sgpMap;						// The map the meshes are built from
+static ChunkMesh*			sgChunkMeshes;				// sgChunkNumX * sgChunkNumY entries, row after row
+static int					sgChunkNumX;
+static int					sgChunkNumY;
+
+static int					sgMeshChunks[TILE_MESH_CACHE_NUM];	// The chunks that have a mesh
+static int					sgMeshNum;
+static unsigned long		sgDrawCounter;
+
+// ---------------------------------------------------------------------------
+
+static AEGfxVertexList*		BuildChunkMesh(int ChunkX, int ChunkY);
+static void					FreeOldestMesh(void);
+
+// ---------------------------------------------------------------------------
+
+int TileMapRenderBuild(const MapContext *pMap)
+{
+	sgpMap = pMap;
+	sgChunkNumX = (GetMapWidth(pMap) + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
+	sgChunkNumY = (GetMapHeight(pMap) + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
+	sgMeshNum = 0;
+	sgDrawCounter = 0;
+
+	sgChunkMeshes = (ChunkMesh*)calloc(sgChunkNumX * sgChunkNumY, sizeof(ChunkMesh));
+	if (!sgChunkMeshes && sgChunkNumX * sgChunkNumY > 0)
+	{
+		sgChunkNumX = sgChunkNumY = 0;
+		return 0;
+	}
+
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+void TileMapRenderDraw(Matrix2D *pMapTransform, float MinX, float MinY, float MaxX, float MaxY)
+{
+	int x, y, xMin, yMin, xMax, yMax;
+
+	xMin = MinX < 0.0f ? 0 : (int)MinX / MAP_CHUNK_SIZE;
+	yMin = MinY < 0.0f ? 0 : (int)MinY / MAP_CHUNK_SIZE;
+	xMax = MaxX < 0.0f ? -1 : (int)MaxX / MAP_CHUNK_SIZE;
+	yMax = MaxY < 0.0f ? -1 : (int)MaxY / MAP_CHUNK_SIZE;
+	if (xMax >= sgChunkNumX)
+		xMax = sgChunkNumX - 1;
+	if (yMax >= sgChunkNumY)
+		yMax = sgChunkNumY - 1;
+
+	++sgDrawCounter;
+
+	// The chunk meshes are built in map space: the map transform is the same for all of them
+	AEGfxSetTransform(pMapTransform->m);
+
+	for (y = yMin; y <= yMax; ++y)
+	{
+		for (x = xMin; x <= xMax; ++x)
+		{
+			ChunkMesh *pChunk = sgChunkMeshes + y * sgChunkNumX + x;
+
+			if (!pChunk->mpMesh)
+			{
+				if (sgMeshNum == TILE_MESH_CACHE_NUM)
+					FreeOldestMesh();
+
+				pChunk->mpMesh = BuildChunkMesh(x, y);
+				if (!pChunk->mpMesh)
+					continue;
+
+				sgMeshChunks[sgMeshNum++] = y * sgChunkNumX + x;
+			}
+
+			pChunk->mLastDraw = sgDrawCounter;
+			AEGfxMeshDraw(pChunk->mpMesh, AE_GFX_MDM_TRIANGLES);
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void TileMapRenderFree(void)
+{
+	int i;
+
+	for (i = 0; i < sgMeshNum; ++i)
+		AEGfxMeshFree(sgChunkMeshes[sgMeshChunks[i]].mpMesh);
+
+	free(sgChunkMeshes);
+	sgChunkMeshes = 0;
+	sgpMap = 0;
+	sgChunkNumX = sgChunkNumY = 0;
+	sgMeshNum = 0;
+}
+
+// ---------------------------------------------------------------------------
+
+// Two triangles per cell, black for the empty cells and white for the collision ones
+AEGfxVertexList* BuildChunkMesh(int ChunkX, int ChunkY)
+{
+	int x, y, xEnd, yEnd;
+
+	xEnd = (ChunkX + 1) * MAP_CHUNK_SIZE;
+	yEnd = (ChunkY + 1) * MAP_CHUNK_SIZE;
+	if (xEnd > GetMapWidth(sgpMap))
+		xEnd = GetMapWidth(sgpMap);
+	if (yEnd > GetMapHeight(sgpMap))
+		yEnd = GetMapHeight(sgpMap);
+
+	AEGfxMeshStart();
+
+	for (y = ChunkY * MAP_CHUNK_SIZE; y < yEnd; ++y)
+	{
+		for (x = ChunkX * MAP_CHUNK_SIZE; x < xEnd; ++x)
+		{
+			u32 color = GetCellValue(sgpMap, x, y) == 1 ? TILE_COLOR_COLLISION : TILE_COLOR_EMPTY;
+			f32 x0 = (f32)x, y0 = (f32)y;
+			f32 x1 = x0 + 1.0f, y1 = y0 + 1.0f;
+
+			AEGfxTriAdd(
+				x0, y0, color, 0.0f, 0.0f,
+				x1, y0, color, 0.0f, 0.0f,
+				x0, y1, color, 0.0f, 0.0f);
+
+			AEGfxTriAdd(
+				x0, y1, color, 0.0f, 0.0f,
+				x1, y0, color, 0.0f, 0.0f,
+				x1, y1, color, 0.0f, 0.0f);
+		}
+	}
+
+	return AEGfxMeshEnd();
+}
+
+// ---------------------------------------------------------------------------
+
+// Makes room in the mesh cache
+void FreeOldestMesh(void)
+{
+	int i, oldest = 0;
+
+	for (i = 1; i < sgMeshNum; ++i)
+	{
+		if (sgChunkMeshes[sgMeshChunks[i]].mLastDraw < sgChunkMeshes[sgMeshChunks[oldest]].mLastDraw)
+			oldest = i;
+	}
+
+	AEGfxMeshFree(sgChunkMeshes[sgMeshChunks[oldest]].mpMesh);
+	sgChunkMeshes[sgMeshChunks[oldest]].mpMesh = 0;
+	sgMeshChunks[oldest] = sgMeshChunks[--sgMeshNum];
+}
+
+// ---------------------------------------------------------------------------
@@ -0,0 +1,54 @@
+// ---------------------------------------------------------------------------
+// Project Name		:	Platformer
+// File Name		:	TileMapRender.h
+// Author			:	Sean Higgins
+// Creation Date	:	2026/10/17
+// Purpose			:	Draws the static map tiles as a few cached meshes, one
+//						per chunk of cells, instead of one instance per cell
+// History			:
+//	- 2026/10/17	:	- initial implementation
+//	- 2026/10/17	:	- meshes are built when their chunk is first drawn, and
+//						  only TILE_MESH_CACHE_NUM of them are kept
+//	- 2026/10/17	:	- the map is passed to TileMapRenderBuild
+// ---------------------------------------------------------------------------
+
+#ifndef TILE_MAP_RENDER_H
+#define TILE_MAP_RENDER_H
+
+// ---------------------------------------------------------------------------
+
+#include "Matrix2D.h"
+#include "BinaryMap.h"
+
+// ---------------------------------------------------------------------------
+
+#define TILE_MESH_CACHE_NUM			256					// The number of chunk meshes kept
+
+// ---------------------------------------------------------------------------
+// Function prototypes
+
+/*
+This function gets the renderer ready for the map imported in "pMap". The meshes
+are built from it until TileMapRenderFree.
+There is one mesh per MAP_CHUNK_SIZE x MAP_CHUNK_SIZE chunk of the map, built the
+first time the chunk is drawn. The cell (X;Y) covers [X, X+1] x [Y, Y+1] in map
+space. Returns 0 if the tables could not be allocated
+*/
+int TileMapRenderBuild(const MapContext *pMap);
+
+/*
+This function draws the chunks that overlap [MinX, MaxX] x [MinY, MaxY] (in map
+space), with one AEGfxMeshDraw per chunk. "pMapTransform" takes map space to the
+screen. When more than TILE_MESH_CACHE_NUM meshes are needed, the ones that were
+drawn the longest time ago are freed
+*/
+void TileMapRenderDraw(Matrix2D *pMapTransform, float MinX, float MinY, float MaxX, float MaxY);
+
+/*
+This function frees the meshes made by TileMapRenderBuild
+*/
+void TileMapRenderFree(void);
+
+// ---------------------------------------------------------------------------
+
+#endif // TILE_MAP_RENDER_H